@@ -0,0 +1,166 @@
+// channel_pack.cpp
+//
+// RC channel packing micro-benchmark: the grouped 64-bit pack/unpack in
+// CrsfProtocol against the previous 22-store packChannels and a bit-serial
+// reference decoder. Also verifies that unpack(pack(x)) == x for every frame.
+//
+// Usage:
+//   bench_channel_pack [--frames N] [--iterations N]
+
+#include "crsf_protocol.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t CHANNELS = ELRS::CrsfProtocol::CRSF_CHANNEL_COUNT;
+    constexpr size_t PAYLOAD = ELRS::CrsfProtocol::CRSF_FRAME_CHANNELS_PAYLOAD_SIZE;
+
+    // CrsfProtocol::packChannels before the rewrite
+    void legacyPack(const uint16_t *channels, uint8_t *packed_out)
+    {
+        packed_out[0] = static_cast<uint8_t>(channels[0] & 0x07FF);
+        packed_out[1] = static_cast<uint8_t>((channels[0] & 0x07FF) >> 8 | (channels[1] & 0x07FF) << 3);
+        packed_out[2] = static_cast<uint8_t>((channels[1] & 0x07FF) >> 5 | (channels[2] & 0x07FF) << 6);
+        packed_out[3] = static_cast<uint8_t>((channels[2] & 0x07FF) >> 2);
+        packed_out[4] = static_cast<uint8_t>((channels[2] & 0x07FF) >> 10 | (channels[3] & 0x07FF) << 1);
+        packed_out[5] = static_cast<uint8_t>((channels[3] & 0x07FF) >> 7 | (channels[4] & 0x07FF) << 4);
+        packed_out[6] = static_cast<uint8_t>((channels[4] & 0x07FF) >> 4 | (channels[5] & 0x07FF) << 7);
+        packed_out[7] = static_cast<uint8_t>((channels[5] & 0x07FF) >> 1);
+        packed_out[8] = static_cast<uint8_t>((channels[5] & 0x07FF) >> 9 | (channels[6] & 0x07FF) << 2);
+        packed_out[9] = static_cast<uint8_t>((channels[6] & 0x07FF) >> 6 | (channels[7] & 0x07FF) << 5);
+        packed_out[10] = static_cast<uint8_t>((channels[7] & 0x07FF) >> 3);
+        packed_out[11] = static_cast<uint8_t>((channels[8] & 0x07FF));
+        packed_out[12] = static_cast<uint8_t>((channels[8] & 0x07FF) >> 8 | (channels[9] & 0x07FF) << 3);
+        packed_out[13] = static_cast<uint8_t>((channels[9] & 0x07FF) >> 5 | (channels[10] & 0x07FF) << 6);
+        packed_out[14] = static_cast<uint8_t>((channels[10] & 0x07FF) >> 2);
+        packed_out[15] = static_cast<uint8_t>((channels[10] & 0x07FF) >> 10 | (channels[11] & 0x07FF) << 1);
+        packed_out[16] = static_cast<uint8_t>((channels[11] & 0x07FF) >> 7 | (channels[12] & 0x07FF) << 4);
+        packed_out[17] = static_cast<uint8_t>((channels[12] & 0x07FF) >> 4 | (channels[13] & 0x07FF) << 7);
+        packed_out[18] = static_cast<uint8_t>((channels[13] & 0x07FF) >> 1);
+        packed_out[19] = static_cast<uint8_t>((channels[13] & 0x07FF) >> 9 | (channels[14] & 0x07FF) << 2);
+        packed_out[20] = static_cast<uint8_t>((channels[14] & 0x07FF) >> 6 | (channels[15] & 0x07FF) << 5);
+        packed_out[21] = static_cast<uint8_t>((channels[15] & 0x07FF) >> 3);
+    }
+
+    // Bit-serial decoder, as receivers commonly implement it
+    void referenceUnpack(const uint8_t *packed, uint16_t *channels)
+    {
+        uint32_t bits = 0;
+        int bit_count = 0;
+        size_t byte_index = 0;
+        for (size_t i = 0; i < CHANNELS; ++i)
+        {
+            while (bit_count < 11)
+            {
+                bits |= static_cast<uint32_t>(packed[byte_index++]) << bit_count;
+                bit_count += 8;
+            }
+            channels[i] = static_cast<uint16_t>(bits & 0x07FF);
+            bits >>= 11;
+            bit_count -= 11;
+        }
+    }
+
+    template <typename Fn>
+    double framesPerSecond(size_t frames, int iterations, Fn &&fn)
+    {
+        auto start = Clock::now();
+        for (int it = 0; it < iterations; ++it)
+        {
+            fn();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return seconds > 0.0 ? static_cast<double>(frames) * iterations / seconds : 0.0;
+    }
+
+    uint64_t checksum(const std::vector<uint8_t> &bytes)
+    {
+        uint64_t sum = 0;
+        for (uint8_t b : bytes)
+        {
+            sum = sum * 31 + b;
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t frames = 1 << 16;
+    int iterations = 100;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "--frames")
+        {
+            frames = static_cast<size_t>(std::atoll(argv[i + 1]));
+        }
+        else if (arg == "--iterations")
+        {
+            iterations = std::atoi(argv[i + 1]);
+        }
+    }
+
+    std::mt19937 rng(7);
+    std::vector<uint16_t> channels(frames * CHANNELS);
+    for (auto &c : channels)
+    {
+        c = static_cast<uint16_t>(rng() & 0x07FF);
+    }
+
+    std::vector<uint8_t> packed(frames * PAYLOAD);
+    std::vector<uint8_t> legacy_packed(frames * PAYLOAD);
+    std::vector<uint16_t> decoded(frames * CHANNELS);
+
+    // Correctness: both packers agree and unpack inverts pack
+    for (size_t f = 0; f < frames; ++f)
+    {
+        legacyPack(&channels[f * CHANNELS], &legacy_packed[f * PAYLOAD]);
+    }
+    ELRS::CrsfProtocol::packChannelsBatch(channels.data(), frames, packed.data());
+    ELRS::CrsfProtocol::unpackChannelsBatch(packed.data(), frames, decoded.data());
+    if (packed != legacy_packed || decoded != channels)
+    {
+        std::cerr << "[BENCH_ERROR] Packed output does not match the reference" << std::endl;
+        return 1;
+    }
+
+    std::cout << "[BENCH] " << frames << " frames x " << iterations << " iterations" << std::endl;
+
+    double legacy_pack = framesPerSecond(frames, iterations, [&]
+                                         {
+                                             for (size_t f = 0; f < frames; ++f)
+                                             {
+                                                 legacyPack(&channels[f * CHANNELS], &legacy_packed[f * PAYLOAD]);
+                                             } });
+    double batch_pack = framesPerSecond(frames, iterations, [&]
+                                        { ELRS::CrsfProtocol::packChannelsBatch(channels.data(), frames, packed.data()); });
+    double reference_unpack = framesPerSecond(frames, iterations, [&]
+                                              {
+                                                  for (size_t f = 0; f < frames; ++f)
+                                                  {
+                                                      referenceUnpack(&packed[f * PAYLOAD], &decoded[f * CHANNELS]);
+                                                  } });
+    double batch_unpack = framesPerSecond(frames, iterations, [&]
+                                          { ELRS::CrsfProtocol::unpackChannelsBatch(packed.data(), frames, decoded.data()); });
+
+    // Keep the optimiser from discarding the work
+    std::cout << "[BENCH] (checksum " << std::hex << (checksum(packed) ^ checksum(legacy_packed) ^ decoded[frames / 2])
+              << std::dec << ")" << std::endl;
+
+    std::cout << "[BENCH] pack   legacy:    " << legacy_pack / 1e6 << " Mframes/s" << std::endl;
+    std::cout << "[BENCH] pack   batch:     " << batch_pack / 1e6 << " Mframes/s ("
+              << (legacy_pack > 0.0 ? batch_pack / legacy_pack : 0.0) << "x)" << std::endl;
+    std::cout << "[BENCH] unpack bitwise:   " << reference_unpack / 1e6 << " Mframes/s" << std::endl;
+    std::cout << "[BENCH] unpack batch:     " << batch_unpack / 1e6 << " Mframes/s ("
+              << (reference_unpack > 0.0 ? batch_unpack / reference_unpack : 0.0) << "x)" << std::endl;
+    return 0;
+}
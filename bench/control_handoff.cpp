@@ -0,0 +1,217 @@
+// control_handoff.cpp
+//
+// Control-input handoff contention benchmark: producer threads (UI, input
+// devices) hammer the control inputs while the TX thread builds RC frames.
+// Compares the previous mutex handoff, where every frame build locked the
+// producers' mutex, against the SeqLock snapshot the transmitter now reads.
+// Producers format a log line while holding their lock, as setControlInputs
+// does, so the mutex variant sees realistic hold times.
+//
+// Usage:
+//   bench_control_handoff [--producers N] [--frames N] [--period-us N]
+
+#include "crsf_protocol.h"
+#include "latency_histogram.h"
+#include "seqlock.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Mirrors ElrsTransmitter::ControlInputs
+    struct ControlInputs
+    {
+        float roll = 0.0f;
+        float pitch = 0.0f;
+        float yaw = 0.0f;
+        float throttle = 0.0f;
+        bool armed = false;
+        bool mode1 = false;
+        bool mode2 = false;
+    };
+
+    void buildFrame(const ControlInputs &inputs, std::array<uint8_t, 26> &frame)
+    {
+        using ELRS::CrsfProtocol;
+        uint16_t channels[16];
+        channels[0] = CrsfProtocol::mapStickToChannel(inputs.roll);
+        channels[1] = CrsfProtocol::mapStickToChannel(inputs.pitch);
+        channels[2] = CrsfProtocol::mapThrottleToChannel(inputs.throttle);
+        channels[3] = CrsfProtocol::mapStickToChannel(inputs.yaw);
+        channels[4] = inputs.armed ? CrsfProtocol::CRSF_CHANNEL_VALUE_MAX : CrsfProtocol::CRSF_CHANNEL_VALUE_MIN;
+        channels[5] = inputs.mode1 ? CrsfProtocol::CRSF_CHANNEL_VALUE_MAX : CrsfProtocol::CRSF_CHANNEL_VALUE_MIN;
+        channels[6] = inputs.mode2 ? CrsfProtocol::CRSF_CHANNEL_VALUE_MAX : CrsfProtocol::CRSF_CHANNEL_VALUE_MIN;
+        for (int i = 7; i < 16; i++)
+        {
+            channels[i] = CrsfProtocol::CRSF_CHANNEL_VALUE_MID;
+        }
+        CrsfProtocol::buildRcChannelsFrame(channels, frame);
+    }
+
+    // Previous scheme: producers and the TX thread share one mutex
+    struct MutexHandoff
+    {
+        std::mutex mutex;
+        ControlInputs inputs;
+
+        template <typename Fn>
+        void write(Fn &&under_lock)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            under_lock(inputs);
+        }
+
+        ControlInputs read()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return inputs;
+        }
+    };
+
+    // Current scheme: producers still serialise on a mutex, the TX thread reads the seqlock
+    struct SeqLockHandoff
+    {
+        std::mutex mutex;
+        ControlInputs inputs;
+        ELRS::SeqLock<ControlInputs> published;
+
+        template <typename Fn>
+        void write(Fn &&under_lock)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            under_lock(inputs);
+            published.store(inputs);
+        }
+
+        ControlInputs read() { return published.load(); }
+    };
+
+    struct Result
+    {
+        uint64_t p50_ns;
+        uint64_t p99_ns;
+        uint64_t p999_ns;
+        uint64_t max_ns;
+        uint64_t producer_writes;
+        unsigned checksum;
+    };
+
+    template <typename Handoff>
+    Result run(int producers, size_t frames, std::chrono::microseconds period)
+    {
+        Handoff handoff;
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> writes{0};
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&, p]
+                                 {
+                                     std::ostringstream log;
+                                     float t = static_cast<float>(p);
+                                     while (!stop.load(std::memory_order_relaxed))
+                                     {
+                                         t += 0.001f;
+                                         handoff.write([&](ControlInputs &inputs)
+                                                       {
+                                                           inputs.roll = t - static_cast<int>(t);
+                                                           inputs.pitch = -inputs.roll;
+                                                           inputs.throttle = 0.5f;
+                                                           inputs.armed = (static_cast<int>(t) & 1) != 0;
+                                                           // Stand-in for the CONTROL_INPUT log line
+                                                           log.str(std::string());
+                                                           log << "CONTROL_INPUT: R=" << inputs.roll << " P=" << inputs.pitch
+                                                               << " Y=" << inputs.yaw << " T=" << inputs.throttle;
+                                                       });
+                                         writes.fetch_add(1, std::memory_order_relaxed);
+                                     } });
+        }
+
+        ELRS::LatencyHistogram build_ns;
+        std::array<uint8_t, 26> frame{};
+        unsigned checksum = 0;
+        auto next = Clock::now();
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            if (period.count() > 0)
+            {
+                next += period;
+                std::this_thread::sleep_until(next);
+            }
+
+            auto start = Clock::now();
+            ControlInputs inputs = handoff.read();
+            buildFrame(inputs, frame);
+            auto elapsed = Clock::now() - start;
+
+            build_ns.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            checksum += frame[25];
+        }
+
+        stop.store(true);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        return Result{build_ns.getPercentile(50.0), build_ns.getPercentile(99.0), build_ns.getPercentile(99.9),
+                      build_ns.getMax(), writes.load(), checksum};
+    }
+
+    void report(const char *name, const Result &result)
+    {
+        std::cout << "[BENCH] " << name << " frame build p50 " << result.p50_ns << "ns  p99 " << result.p99_ns
+                  << "ns  p99.9 " << result.p999_ns << "ns  max " << result.max_ns << "ns  ("
+                  << result.producer_writes << " producer writes)" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int producers = 2;
+    size_t frames = 200000;
+    int period_us = 0;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "--producers")
+        {
+            producers = std::atoi(argv[i + 1]);
+        }
+        else if (arg == "--frames")
+        {
+            frames = static_cast<size_t>(std::atoll(argv[i + 1]));
+        }
+        else if (arg == "--period-us")
+        {
+            period_us = std::atoi(argv[i + 1]);
+        }
+    }
+
+    std::cout << "[BENCH] " << producers << " producers, " << frames << " frames, period "
+              << period_us << "us" << std::endl;
+
+    Result mutex_result = run<MutexHandoff>(producers, frames, std::chrono::microseconds(period_us));
+    Result seqlock_result = run<SeqLockHandoff>(producers, frames, std::chrono::microseconds(period_us));
+
+    report("mutex:  ", mutex_result);
+    report("seqlock:", seqlock_result);
+    std::cout << "[BENCH] p99 improvement: "
+              << (seqlock_result.p99_ns > 0 ? static_cast<double>(mutex_result.p99_ns) / seqlock_result.p99_ns : 0.0)
+              << "x (checksum " << (mutex_result.checksum ^ seqlock_result.checksum) << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,335 @@
+// demux_throughput.cpp
+//
+// Offline deframing throughput: feeds a module->host byte stream through
+// FrameDemuxer and through the byte-at-a-time state machines it replaced,
+// and reports MB/s for each. The speedup is only printed when both decoded
+// the same frames (within 1%).
+//
+// Usage:
+//   bench_demux_throughput [capture.bin] [--chunk N] [--iterations N]
+//
+// Without a capture a synthetic 420 kbaud session is generated: CRSF link
+// statistics and battery frames, MSP spectrum pushes and a little line noise.
+// A capture is read through ReplayTransport (unpaced) exactly as an offline
+// replay would be.
+
+#include "crsf_protocol.h"
+#include "frame_demuxer.h"
+#include "replay_transport.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    void appendCrsf(std::vector<uint8_t> &out, uint8_t type, const std::vector<uint8_t> &payload)
+    {
+        size_t start = out.size();
+        out.push_back(0xEA);
+        out.push_back(static_cast<uint8_t>(payload.size() + 2));
+        out.push_back(type);
+        out.insert(out.end(), payload.begin(), payload.end());
+        out.push_back(ELRS::CrsfProtocol::crc8(&out[start + 2], static_cast<uint8_t>(payload.size() + 1)));
+    }
+
+    void appendMsp(std::vector<uint8_t> &out, uint8_t function, const std::vector<uint8_t> &payload)
+    {
+        uint8_t checksum = static_cast<uint8_t>(payload.size()) ^ function;
+        out.push_back('$');
+        out.push_back('M');
+        out.push_back('>');
+        out.push_back(static_cast<uint8_t>(payload.size()));
+        out.push_back(function);
+        for (uint8_t b : payload)
+        {
+            out.push_back(b);
+            checksum ^= b;
+        }
+        out.push_back(checksum);
+    }
+
+    std::vector<uint8_t> synthesizeSession(size_t target_bytes)
+    {
+        std::mt19937 rng(42);
+        std::vector<uint8_t> stream;
+        stream.reserve(target_bytes + 512);
+
+        std::vector<uint8_t> link(10), battery(8), spectrum(42);
+        while (stream.size() < target_bytes)
+        {
+            for (auto &b : link)
+            {
+                b = static_cast<uint8_t>(rng());
+            }
+            appendCrsf(stream, 0x14, link);
+
+            switch (rng() % 8)
+            {
+            case 0:
+                for (auto &b : battery)
+                {
+                    b = static_cast<uint8_t>(rng());
+                }
+                appendCrsf(stream, 0x08, battery);
+                break;
+            case 1:
+                for (auto &b : spectrum)
+                {
+                    b = static_cast<uint8_t>(rng() % 100);
+                }
+                appendMsp(stream, 0x2D, spectrum);
+                break;
+            case 2:
+                for (int i = 0; i < 4; ++i)
+                {
+                    stream.push_back(static_cast<uint8_t>(rng())); // Line noise
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        return stream;
+    }
+
+    // The deframers FrameDemuxer replaced (TelemetryHandler::feedMspByte and the
+    // sample's CrsfDeframer), fed one byte at a time with a vector per frame.
+    // The CRSF side is given the same validation as FrameDemuxer (sync address,
+    // length bound, and on a bad frame a rescan from the byte after its start) so
+    // both decode the same frames and the MB/s figures compare equal work; the
+    // sample's version took any byte as an address and lost sync on noise.
+    class LegacyDeframer
+    {
+    public:
+        uint64_t frames = 0;
+
+        void feed(uint8_t b)
+        {
+            feedMsp(b);
+            feedCrsf(b);
+        }
+
+    private:
+        int msp_state_ = 0;
+        uint8_t msp_length_ = 0, msp_checksum_ = 0;
+        std::vector<uint8_t> msp_payload_;
+
+        std::vector<uint8_t> crsf_buffer_; // [address] [length] [type] [payload...] [crc]
+
+        void feedMsp(uint8_t b)
+        {
+            switch (msp_state_)
+            {
+            case 0:
+                msp_state_ = b == '$' ? 1 : 0;
+                break;
+            case 1:
+                msp_state_ = b == 'M' ? 2 : 0;
+                break;
+            case 2:
+                msp_state_ = (b == '<' || b == '>') ? 3 : 0;
+                break;
+            case 3:
+                msp_length_ = b;
+                msp_checksum_ = b;
+                msp_payload_.clear();
+                msp_state_ = 4;
+                break;
+            case 4:
+                msp_checksum_ ^= b;
+                msp_state_ = msp_length_ == 0 ? 6 : 5;
+                break;
+            case 5:
+                msp_payload_.push_back(b);
+                msp_checksum_ ^= b;
+                if (msp_payload_.size() >= msp_length_)
+                {
+                    msp_state_ = 6;
+                }
+                break;
+            case 6:
+                if (msp_checksum_ == b)
+                {
+                    std::vector<uint8_t> copy(msp_payload_);
+                    frames += copy.empty() ? 0 : 1;
+                }
+                msp_state_ = 0;
+                break;
+            }
+        }
+
+        static bool isSync(uint8_t b)
+        {
+            return b == ELRS::FrameDemuxer::CRSF_SYNC_FLIGHT_CONTROLLER || b == ELRS::FrameDemuxer::CRSF_SYNC_RADIO_TRANSMITTER ||
+                   b == ELRS::FrameDemuxer::CRSF_SYNC_RECEIVER || b == ELRS::FrameDemuxer::CRSF_SYNC_TRANSMITTER;
+        }
+
+        void feedCrsf(uint8_t b)
+        {
+            if (crsf_buffer_.empty())
+            {
+                if (isSync(b))
+                {
+                    crsf_buffer_.push_back(b);
+                }
+                return;
+            }
+
+            crsf_buffer_.push_back(b);
+            if (crsf_buffer_.size() == 2)
+            {
+                if (b < 2 || b > ELRS::CrsfProtocol::CRSF_FRAME_SIZE_MAX - 2)
+                {
+                    rescanCrsf();
+                }
+                return;
+            }
+
+            const size_t length = crsf_buffer_[1];
+            if (crsf_buffer_.size() < length + 2)
+            {
+                return;
+            }
+
+            uint8_t crc = ELRS::CrsfProtocol::crc8(&crsf_buffer_[2], static_cast<uint8_t>(length - 1));
+            if (crc != crsf_buffer_.back())
+            {
+                rescanCrsf();
+                return;
+            }
+
+            std::vector<uint8_t> payload(crsf_buffer_.begin() + 3, crsf_buffer_.end() - 1);
+            frames += payload.empty() ? 0 : 1;
+            crsf_buffer_.clear();
+        }
+
+        // Drop the false start and feed what followed it again, as FrameDemuxer resyncs one byte later
+        void rescanCrsf()
+        {
+            std::vector<uint8_t> rest(crsf_buffer_.begin() + 1, crsf_buffer_.end());
+            crsf_buffer_.clear();
+            for (uint8_t b : rest)
+            {
+                feedCrsf(b);
+            }
+        }
+    };
+
+    double megabytesPerSecond(size_t bytes, Clock::duration elapsed)
+    {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0.0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string capture_path;
+    size_t chunk = 4096;
+    int iterations = 20;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--chunk" && i + 1 < argc)
+        {
+            chunk = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--iterations" && i + 1 < argc)
+        {
+            iterations = std::atoi(argv[++i]);
+        }
+        else
+        {
+            capture_path = arg;
+        }
+    }
+    chunk = chunk > 0 ? chunk : 1;
+
+    std::vector<uint8_t> stream;
+    if (!capture_path.empty())
+    {
+        ELRS::ReplayTransport replay;
+        if (!replay.open(capture_path))
+        {
+            return 1;
+        }
+        stream.resize(replay.getSize());
+        size_t filled = 0;
+        while (filled < stream.size())
+        {
+            int n = replay.read(stream.data() + filled, stream.size() - filled, 0);
+            if (n <= 0)
+            {
+                break;
+            }
+            filled += static_cast<size_t>(n);
+        }
+        stream.resize(filled);
+    }
+    else
+    {
+        // ~10 minutes of a saturated 420 kbaud link
+        stream = synthesizeSession(25 * 1024 * 1024);
+    }
+
+    std::cout << "[BENCH] " << stream.size() << " bytes, chunk " << chunk << ", " << iterations << " iterations" << std::endl;
+
+    // FrameDemuxer
+    uint64_t frames = 0;
+    ELRS::FrameDemuxer demuxer;
+    demuxer.setDefaultCrsfHandler([&](const ELRS::CrsfFrameView &)
+                                  { ++frames; });
+    demuxer.setDefaultMspHandler([&](const ELRS::MspFrameView &)
+                                 { ++frames; });
+
+    auto start = Clock::now();
+    for (int it = 0; it < iterations; ++it)
+    {
+        for (size_t pos = 0; pos < stream.size(); pos += chunk)
+        {
+            demuxer.feed(stream.data() + pos, std::min(chunk, stream.size() - pos));
+        }
+    }
+    double demux_mbs = megabytesPerSecond(stream.size() * iterations, Clock::now() - start);
+
+    ELRS::DemuxerStats stats = demuxer.getStats();
+    std::cout << "[BENCH] FrameDemuxer:   " << demux_mbs << " MB/s (" << frames / iterations << " frames/pass, "
+              << stats.crc_errors / iterations << " CRC errors/pass)" << std::endl;
+
+    // Byte-at-a-time reference
+    LegacyDeframer legacy;
+    int legacy_iterations = iterations > 4 ? iterations / 4 : 1;
+    start = Clock::now();
+    for (int it = 0; it < legacy_iterations; ++it)
+    {
+        for (uint8_t b : stream)
+        {
+            legacy.feed(b);
+        }
+    }
+    double legacy_mbs = megabytesPerSecond(stream.size() * legacy_iterations, Clock::now() - start);
+
+    std::cout << "[BENCH] Byte-at-a-time: " << legacy_mbs << " MB/s (" << legacy.frames / legacy_iterations
+              << " frames/pass)" << std::endl;
+    // The speedup only means something if both sides did the same work
+    const double demux_frames = static_cast<double>(frames / iterations);
+    const double legacy_frames = static_cast<double>(legacy.frames / legacy_iterations);
+    const double frame_gap = demux_frames > 0.0 ? std::abs(demux_frames - legacy_frames) / demux_frames * 100.0 : 0.0;
+    std::cout << "[BENCH] Frame counts differ by " << frame_gap << "%" << std::endl;
+    if (frame_gap > 1.0)
+    {
+        std::cout << "[BENCH] Frame counts are not comparable; compare MB/s only" << std::endl;
+        return 0;
+    }
+    std::cout << "[BENCH] Speedup:        " << (legacy_mbs > 0.0 ? demux_mbs / legacy_mbs : 0.0) << "x" << std::endl;
+    return 0;
+}
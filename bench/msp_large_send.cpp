@@ -0,0 +1,176 @@
+// msp_large_send.cpp
+//
+// Sends a maximum-size MSP message (MSP_MAX_PAYLOAD bytes) through
+// MspCommands and the WriteScheduler while an RC thread keeps submitting
+// channel frames, over a mock transport that takes as long as the wire would.
+// Checks that every chunk of the message reaches the module in sequence and
+// reassembles to the original payload, in both CRSF and Raw encapsulation
+// (Raw tunnels anything too large for one write), and reports how long RC
+// frames waited meanwhile.
+//
+// Usage:
+//   bench_msp_large_send [--baud N] [--rc-period-us N]
+
+#include "crsf_protocol.h"
+#include "latency_histogram.h"
+#include "msp_commands.h"
+#include "msp_tunnel.h"
+#include "transport.h"
+#include "write_scheduler.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Takes length * 10 / baud seconds per write (8N1) and reassembles MSP chunks like the module would
+    class WireTransport : public ELRS::ITransport
+    {
+    public:
+        explicit WireTransport(uint32_t baud) : baud_(baud) {}
+
+        std::string getTransportName() const override { return "wire"; }
+        bool isConnected() const override { return true; }
+        int read(uint8_t *, size_t, int) override { return 0; }
+        bool waitReadable(int) override { return false; }
+        std::string getLastError() const override { return ""; }
+
+        bool write(const uint8_t *data, size_t length, int) override
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(length * 10 * 1000000 / baud_));
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (length >= 4 && data[2] == ELRS::CrsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED)
+            {
+                rc_frames_++;
+            }
+            else if (length >= 6 && ELRS::MspTunnel::isMspFrameType(data[2]))
+            {
+                chunks_++;
+                if (reassembler_.feed(data[2], data + 3, length - 4))
+                {
+                    auto payload = reassembler_.payload();
+                    message_.assign(payload.begin(), payload.end());
+                    completed_++;
+                }
+            }
+            return true;
+        }
+
+        uint32_t baud_;
+        std::mutex mutex_;
+        ELRS::MspReassembler reassembler_;
+        std::vector<uint8_t> message_;
+        size_t chunks_ = 0;
+        size_t completed_ = 0;
+        size_t rc_frames_ = 0;
+    };
+
+    bool run(ELRS::MspEncapsulation encapsulation, uint32_t baud, std::chrono::microseconds rc_period)
+    {
+        WireTransport transport(baud);
+        ELRS::WriteScheduler scheduler(&transport, baud);
+        ELRS::MspCommands commands(&transport);
+        commands.setMspEncapsulation(encapsulation);
+        commands.setMspVersion(ELRS::MspVersion::V2);
+        commands.setWriteScheduler(&scheduler);
+        scheduler.start();
+
+        std::vector<uint8_t> payload(ELRS::MspProtocol::MSP_MAX_PAYLOAD);
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+
+        std::atomic<bool> stop{false};
+        size_t rc_rejected = 0;
+        std::thread rc([&]
+                       {
+                           std::array<uint8_t, 26> frame{};
+                           uint16_t channels[16];
+                           for (auto &channel : channels)
+                           {
+                               channel = ELRS::CrsfProtocol::CRSF_CHANNEL_VALUE_MID;
+                           }
+                           ELRS::CrsfProtocol::buildRcChannelsFrame(channels, frame);
+                           auto next = Clock::now();
+                           while (!stop.load())
+                           {
+                               next += rc_period;
+                               std::this_thread::sleep_until(next);
+                               if (!scheduler.submit(ELRS::WriteClass::Rc, frame.data(), frame.size()))
+                               {
+                                   rc_rejected++;
+                               }
+                           } });
+
+        const size_t expected_chunks = ELRS::MspTunnel::chunkCount(ELRS::MspVersion::V2, 0x1234, payload.size());
+        auto started = Clock::now();
+        bool sent = commands.sendMspCommand(0x1234, payload.data(), payload.size());
+        if (!sent)
+        {
+            std::cout << "[BENCH] send failed: " << commands.getLastError() << std::endl;
+        }
+
+        // Wait for the writer to drain the message
+        size_t chunks = 0;
+        while (sent && chunks < expected_chunks && Clock::now() - started < std::chrono::seconds(10))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock(transport.mutex_);
+            chunks = transport.chunks_;
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+
+        stop.store(true);
+        rc.join();
+        scheduler.stop();
+
+        ELRS::WriteClassStats rc_stats = scheduler.getClassStats(ELRS::WriteClass::Rc);
+        bool ok = sent && transport.completed_ == 1 && transport.message_ == payload &&
+                  transport.reassembler_.getErrors() == 0;
+
+        std::cout << "[BENCH] " << (encapsulation == ELRS::MspEncapsulation::Crsf ? "crsf:" : "raw: ")
+                  << " " << transport.chunks_ << "/" << expected_chunks << " chunks in " << elapsed << "ms, "
+                  << (ok ? "message intact" : "MESSAGE LOST") << " (" << transport.reassembler_.getErrors()
+                  << " reassembly errors); RC " << transport.rc_frames_ << " written, " << rc_rejected
+                  << " rejected, delay p99 " << rc_stats.delay_p99_us << "us max " << rc_stats.delay_max_us << "us"
+                  << std::endl;
+        return ok;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t baud = 420000;
+    int rc_period_us = 4000;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "--baud")
+        {
+            baud = static_cast<uint32_t>(std::atol(argv[i + 1]));
+        }
+        else if (arg == "--rc-period-us")
+        {
+            rc_period_us = std::atoi(argv[i + 1]);
+        }
+    }
+
+    std::cout << "[BENCH] " << ELRS::MspProtocol::MSP_MAX_PAYLOAD << "-byte MSP message at " << baud
+              << " baud, RC every " << rc_period_us << "us" << std::endl;
+
+    bool ok = run(ELRS::MspEncapsulation::Crsf, baud, std::chrono::microseconds(rc_period_us));
+    ok = run(ELRS::MspEncapsulation::Raw, baud, std::chrono::microseconds(rc_period_us)) && ok;
+    return ok ? 0 : 1;
+}
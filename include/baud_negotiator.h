@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ELRS
+{
+
+    class ITransport;       // Forward declaration
+    class TelemetryHandler; // Forward declaration
+    class MspCommands;      // Forward declaration
+    class WriteScheduler;   // Forward declaration
+
+    /**
+     * Outcome of probing one line rate
+     * error_rate is CRC failures over all frames received while probing;
+     * ping_loss is the fraction of device pings left unanswered.
+     */
+    struct BaudProbeResult
+    {
+        uint32_t baud_rate = 0;
+        bool accepted = false; // Module agreed to switch (always true for the starting rate)
+        uint32_t pings_sent = 0;
+        uint32_t replies = 0;
+        uint64_t frames = 0;
+        uint64_t crc_errors = 0;
+        double error_rate = 0.0;
+        double ping_loss = 0.0;
+        bool stable = false;
+    };
+
+    struct BaudNegotiatorConfig
+    {
+        uint32_t max_baud_rate = 5250000;              // Highest candidate tried
+        int probe_pings = 20;                          // Pings per rate while negotiating
+        int verify_pings = 10;                         // Pings per periodic re-verification
+        std::chrono::milliseconds ping_interval{10};   // Spacing between pings
+        std::chrono::milliseconds reply_timeout{100};  // Wait for stragglers / speed responses
+        double max_error_rate = 0.01;                  // Highest CRC error rate considered stable
+        double max_ping_loss = 0.10;                   // Highest unanswered-ping fraction considered stable
+        std::chrono::milliseconds verify_interval{10000};
+        uint64_t burst_errors = 10;                    // CRC errors within burst_window that force a fallback
+        std::chrono::milliseconds burst_window{500};
+    };
+
+    /**
+     * Negotiator counters (snapshot)
+     */
+    struct BaudNegotiatorStats
+    {
+        uint32_t baud_rate = 0;
+        double error_rate = 0.0; // Measured at baud_rate by the last probe
+        bool negotiated = false; // A negotiation completed with replies from the module
+        uint64_t negotiations = 0;
+        uint64_t verifications = 0;
+        uint64_t fallbacks = 0;
+        uint64_t error_bursts = 0;
+    };
+
+    /**
+     * Automatic CRSF UART speed negotiation
+     * Starting from the rate the port was opened at, each faster candidate is
+     * proposed to the module with a CRSF speed proposal (COMMAND 0x32/0x0A/0x70).
+     * When the module accepts, both ends switch and the new rate is probed with
+     * a burst of device pings (MSP 0x28 answered by DEVICE_INFO 0x29) while the
+     * demuxer's CRC counters are sampled. Climbing stops at the first rate the
+     * module rejects or that fails the error thresholds; the link is then put
+     * back on the fastest stable rate.
+     *
+     * After settling, a supervisor thread re-verifies the rate periodically and
+     * watches the incoming CRC error count. A failed verification or an error
+     * burst drops one step to the next lower stable rate; if the module can no
+     * longer be reached there, every candidate is scanned to find it again.
+     * The chosen rate and its error rate are published to RadioState's
+     * DeviceConfiguration. Requires a transport with an adjustable line rate and
+     * a running TelemetryHandler on the same link.
+     */
+    class BaudNegotiator
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::array<uint32_t, 5> CANDIDATE_RATES = {{420000, 921600, 1870000, 3750000, 5250000}};
+        static constexpr uint8_t HANDSET_PORT_ID = 0;
+
+        BaudNegotiator(ITransport *transport, TelemetryHandler *telemetry, MspCommands *msp,
+                       WriteScheduler *write_scheduler = nullptr);
+        ~BaudNegotiator();
+
+        BaudNegotiator(const BaudNegotiator &) = delete;
+        BaudNegotiator &operator=(const BaudNegotiator &) = delete;
+
+        // Configuration applies from the next negotiation / verification
+        void setConfig(const BaudNegotiatorConfig &config);
+        BaudNegotiatorConfig getConfig() const;
+
+        // Negotiates on a background thread, then supervises the chosen rate
+        bool start();
+        void stop();
+        bool isRunning() const { return running_.load(); }
+
+        // Ask the supervisor to climb again (e.g. after the module was power-cycled)
+        void requestRenegotiation();
+
+        uint32_t getBaudRate() const { return baud_rate_.load(std::memory_order_relaxed); }
+        BaudNegotiatorStats getStats() const;
+        std::vector<BaudProbeResult> getProbeResults() const; // From the last negotiation
+
+        std::string getLastError() const;
+
+    private:
+        ITransport *transport_;
+        TelemetryHandler *telemetry_;
+        MspCommands *msp_;
+        WriteScheduler *write_scheduler_;
+
+        std::atomic<bool> running_{false};
+        std::atomic<bool> renegotiate_{false};
+        std::unique_ptr<std::thread> thread_;
+        std::mutex wake_mutex_;
+        std::condition_variable wake_cv_;
+
+        mutable std::mutex mutex_; // Guards config_, stats_, probe_results_, last_error_
+        BaudNegotiatorConfig config_;
+        BaudNegotiatorStats stats_;
+        std::vector<BaudProbeResult> probe_results_;
+        std::string last_error_;
+
+        std::atomic<uint32_t> baud_rate_{0};
+        std::vector<uint32_t> stable_rates_; // Supervisor thread only, ascending
+
+        void supervisorLoop();
+        bool negotiate();
+        BaudProbeResult probe(uint32_t baud_rate, int pings);
+        bool proposeBaudRate(uint32_t baud_rate);
+        bool switchLocalBaudRate(uint32_t baud_rate);
+        bool stepDown(const std::string &reason);
+        bool resync(uint32_t target_rate);
+        bool sendFrame(const uint8_t *data, size_t length);
+        bool sleepFor(Clock::duration duration);
+        void publish(uint32_t baud_rate, double error_rate);
+        void setError(const std::string &error);
+    };
+
+} // namespace ELRS
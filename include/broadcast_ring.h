@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace ELRS
+{
+
+    /**
+     * Lock-free single-producer / multi-consumer broadcast ring
+     * Every subscriber sees every item through its own cursor (the sequence
+     * number of the next item it wants); the producer never waits for anyone
+     * and simply overwrites the oldest slot. A subscriber that falls more than
+     * capacity items behind skips ahead to the oldest item still held and
+     * counts what it missed, so a slow consumer only ever loses its own data.
+     *
+     * Each slot carries a sequence word used like a SeqLock: odd while the
+     * producer is writing item n (2n + 1), even once it is stable (2n + 2).
+     * Payloads live in relaxed atomic words so a read that races an overwrite
+     * is well-defined and detected by the sequence check.
+     */
+    template <typename T>
+    class BroadcastRing
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BroadcastRing payload must be trivially copyable");
+
+    public:
+        explicit BroadcastRing(size_t capacity = 256)
+        {
+            capacity_ = 1;
+            while (capacity_ < capacity)
+            {
+                capacity_ <<= 1;
+            }
+            mask_ = capacity_ - 1;
+            slots_.reset(new Slot[capacity_]);
+        }
+
+        BroadcastRing(const BroadcastRing &) = delete;
+        BroadcastRing &operator=(const BroadcastRing &) = delete;
+
+        size_t capacity() const { return capacity_; }
+
+        // Sequence number the next publish() will use; a new subscriber starts here
+        uint64_t head() const { return head_.load(std::memory_order_acquire); }
+
+        // Producer side (one thread): never blocks on subscribers
+        void publish(const T &value)
+        {
+            uint64_t words[WORD_COUNT] = {};
+            std::memcpy(words, &value, sizeof(T));
+
+            const uint64_t n = head_.load(std::memory_order_relaxed);
+            Slot &slot = slots_[n & mask_];
+            slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORD_COUNT; ++i)
+            {
+                slot.words[i].store(words[i], std::memory_order_relaxed);
+            }
+            slot.sequence.store(2 * n + 2, std::memory_order_release);
+            head_.store(n + 1, std::memory_order_release);
+
+            // Parked subscribers are the only reason to touch the mutex
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters_.load(std::memory_order_relaxed) > 0)
+            {
+                std::lock_guard<std::mutex> lock(wait_mutex_);
+                wait_cv_.notify_all();
+            }
+        }
+
+        /**
+         * Consumer side: copies the item at cursor and advances it.
+         * Returns false when the subscriber is caught up. If the item was
+         * already overwritten the cursor jumps to the oldest retained item and
+         * the number of skipped items is added to lost.
+         */
+        bool tryRead(uint64_t &cursor, T &out, uint64_t &lost) const
+        {
+            for (;;)
+            {
+                const Slot &slot = slots_[cursor & mask_];
+                const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                const uint64_t stable = 2 * cursor + 2;
+
+                if (before == stable)
+                {
+                    uint64_t words[WORD_COUNT];
+                    for (size_t i = 0; i < WORD_COUNT; ++i)
+                    {
+                        words[i] = slot.words[i].load(std::memory_order_relaxed);
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.sequence.load(std::memory_order_relaxed) == before)
+                    {
+                        std::memcpy(&out, words, sizeof(T));
+                        ++cursor;
+                        return true;
+                    }
+                    // Overwritten during the copy: fall through to the lag path
+                }
+                else if (before < stable)
+                {
+                    return false; // Not published yet (or still being written)
+                }
+
+                // Lapped by the producer: resume at the oldest item that is still held
+                const uint64_t newest = head_.load(std::memory_order_acquire);
+                const uint64_t oldest = newest > capacity_ ? newest - capacity_ + 1 : 0;
+                if (oldest > cursor)
+                {
+                    lost += oldest - cursor;
+                    cursor = oldest;
+                }
+                else
+                {
+                    ++lost;
+                    ++cursor;
+                }
+            }
+        }
+
+        // Items published but not yet read at cursor (may exceed capacity when lapped)
+        uint64_t backlog(uint64_t cursor) const
+        {
+            const uint64_t newest = head();
+            return newest > cursor ? newest - cursor : 0;
+        }
+
+        // Blocks until an item past cursor is published or the timeout expires
+        template <typename Rep, typename Period>
+        bool waitFor(uint64_t cursor, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            if (head() > cursor)
+            {
+                return true;
+            }
+
+            std::unique_lock<std::mutex> lock(wait_mutex_);
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool ready = wait_cv_.wait_for(lock, timeout, [&]
+                                           { return head() > cursor; });
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+            return ready;
+        }
+
+        // Wakes every parked subscriber (e.g. on shutdown)
+        void notifyAll()
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            wait_cv_.notify_all();
+        }
+
+    private:
+        static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<uint64_t> words[WORD_COUNT];
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        size_t capacity_;
+        size_t mask_;
+
+        alignas(64) std::atomic<uint64_t> head_{0};
+
+        // Subscriber parking; the producer only locks while someone is waiting
+        alignas(64) std::atomic<int> waiters_{0};
+        std::mutex wait_mutex_;
+        std::condition_variable wait_cv_;
+    };
+
+} // namespace ELRS
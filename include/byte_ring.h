@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace ELRS
+{
+
+    /**
+     * Lock-free single-producer / single-consumer byte ring
+     * The producer (USB event thread, serial reader) pushes raw bytes and the
+     * consumer (telemetry parser) drains them without taking a lock.
+     * Capacity is rounded up to a power of two; one side may never be used
+     * from more than one thread at a time.
+     */
+    class SpscByteRing
+    {
+    public:
+        explicit SpscByteRing(size_t capacity = 16384)
+        {
+            capacity_ = 1;
+            while (capacity_ < capacity)
+            {
+                capacity_ <<= 1;
+            }
+            mask_ = capacity_ - 1;
+            buffer_.reset(new uint8_t[capacity_]);
+        }
+
+        SpscByteRing(const SpscByteRing &) = delete;
+        SpscByteRing &operator=(const SpscByteRing &) = delete;
+
+        size_t capacity() const { return capacity_; }
+
+        // Producer side: copies as much as fits, returns the number of bytes accepted
+        size_t write(const uint8_t *data, size_t length)
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            const size_t tail = tail_.load(std::memory_order_acquire);
+            const size_t free_space = capacity_ - (head - tail);
+            const size_t count = length < free_space ? length : free_space;
+
+            copyIn(head, data, count);
+            head_.store(head + count, std::memory_order_release);
+
+            if (count < length)
+            {
+                dropped_.fetch_add(length - count, std::memory_order_relaxed);
+            }
+            return count;
+        }
+
+        // Consumer side: copies up to length bytes out, returns the number copied
+        size_t read(uint8_t *out, size_t length)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            const size_t head = head_.load(std::memory_order_acquire);
+            const size_t available = head - tail;
+            const size_t count = length < available ? length : available;
+
+            copyOut(tail, out, count);
+            tail_.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        size_t size() const
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+
+        // Bytes rejected by write() because the consumer fell behind
+        uint64_t droppedBytes() const { return dropped_.load(std::memory_order_relaxed); }
+
+        // Consumer side only
+        void clear() { tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+    private:
+        void copyIn(size_t position, const uint8_t *data, size_t count)
+        {
+            const size_t offset = position & mask_;
+            const size_t first = count < capacity_ - offset ? count : capacity_ - offset;
+            std::memcpy(buffer_.get() + offset, data, first);
+            std::memcpy(buffer_.get(), data + first, count - first);
+        }
+
+        void copyOut(size_t position, uint8_t *out, size_t count) const
+        {
+            const size_t offset = position & mask_;
+            const size_t first = count < capacity_ - offset ? count : capacity_ - offset;
+            std::memcpy(out, buffer_.get() + offset, first);
+            std::memcpy(out + first, buffer_.get(), count - first);
+        }
+
+        std::unique_ptr<uint8_t[]> buffer_;
+        size_t capacity_;
+        size_t mask_;
+
+        // Producer and consumer indices on separate cache lines
+        alignas(64) std::atomic<size_t> head_{0};
+        alignas(64) std::atomic<size_t> tail_{0};
+        alignas(64) std::atomic<uint64_t> dropped_{0};
+    };
+
+} // namespace ELRS
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace ELRS
+{
+
+    /**
+     * Non-owning view over a contiguous byte range (C++17 stand-in for std::span)
+     * Used wherever frames or I/O buffers are handed around without copying.
+     */
+    template <typename T>
+    class BasicByteSpan
+    {
+    public:
+        constexpr BasicByteSpan() = default;
+        constexpr BasicByteSpan(T *data, size_t size) : data_(data), size_(size) {}
+
+        template <size_t N>
+        constexpr BasicByteSpan(T (&array)[N]) : data_(array), size_(N)
+        {
+        }
+
+        // Any container exposing data()/size() (std::vector, std::array)
+        template <typename Container,
+                  typename = decltype(static_cast<T *>(std::declval<Container &>().data()))>
+        constexpr BasicByteSpan(Container &container) : data_(container.data()), size_(container.size())
+        {
+        }
+
+        constexpr T *data() const { return data_; }
+        constexpr size_t size() const { return size_; }
+        constexpr bool empty() const { return size_ == 0; }
+        constexpr T &operator[](size_t index) const { return data_[index]; }
+        constexpr T *begin() const { return data_; }
+        constexpr T *end() const { return data_ + size_; }
+
+        constexpr BasicByteSpan subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const
+        {
+            if (offset > size_)
+            {
+                offset = size_;
+            }
+            if (count > size_ - offset)
+            {
+                count = size_ - offset;
+            }
+            return BasicByteSpan(data_ + offset, count);
+        }
+
+    private:
+        T *data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    using ByteSpan = BasicByteSpan<const uint8_t>;
+    using MutableByteSpan = BasicByteSpan<uint8_t>;
+
+} // namespace ELRS
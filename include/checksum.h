@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ELRS
+{
+
+    /**
+     * Checksum kernels shared by framing, deframing, capture replay and firmware
+     * image checks
+     * - CRC8 DVB-S2 (poly 0xD5): CRSF frames and MSP v2
+     * - CRC8 poly 0xBA: the inner CRC of CRSF command (0x32) frames
+     * - XOR: MSP v1
+     * - CRC32 (IEEE 802.3 / zlib): firmware images and captures
+     *
+     * CRCs use slicing-by-8 tables. CRC32 additionally has a PCLMULQDQ folding
+     * kernel selected once at startup when the CPU supports it. Every function
+     * takes a running value so long inputs can be processed in pieces.
+     */
+    class Checksum
+    {
+    public:
+        static uint8_t crc8DvbS2(const uint8_t *data, size_t length, uint8_t crc = 0);
+
+        // MSP v2 uses the CRSF polynomial
+        static uint8_t mspV2Crc(const uint8_t *data, size_t length, uint8_t crc = 0)
+        {
+            return crc8DvbS2(data, length, crc);
+        }
+
+        // Inner CRC of CRSF command frames, over type + payload before it
+        static uint8_t crsfCommandCrc(const uint8_t *data, size_t length, uint8_t crc = 0);
+
+        static uint8_t mspV1Xor(const uint8_t *data, size_t length, uint8_t checksum = 0);
+
+        // zlib-compatible: crc32(crc32(0, a), b) == crc32(0, a + b)
+        static uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc = 0);
+
+        // Name of the CRC32 kernel picked at startup ("pclmul" or "slice8")
+        static const char *crc32Implementation();
+    };
+
+} // namespace ELRS
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace ELRS
@@ -15,7 +16,11 @@ namespace ELRS
     public:
         // CRSF frame structure constants
         static constexpr uint8_t CRSF_ADDRESS_FLIGHT_CONTROLLER = 0xC8;
+        static constexpr uint8_t CRSF_ADDRESS_RADIO_TRANSMITTER = 0xEA; // Handset (us)
+        static constexpr uint8_t CRSF_ADDRESS_CRSF_TRANSMITTER = 0xEE;  // TX module
         static constexpr uint8_t CRSF_FRAMETYPE_RC_CHANNELS_PACKED = 0x16;
+        static constexpr uint8_t CRSF_FRAMETYPE_RC_CHANNELS_SUBSET = 0x17;
+        static constexpr uint8_t CRSF_FRAMETYPE_COMMAND = 0x32;
         static constexpr uint8_t CRSF_FRAME_SIZE_MAX = 64;
         static constexpr uint8_t CRSF_PAYLOAD_SIZE_MAX = 60;
         static constexpr uint8_t CRSF_CHANNEL_COUNT = 16;
@@ -26,6 +31,27 @@ namespace ELRS
         static constexpr uint16_t CRSF_CHANNEL_VALUE_MID = 992;  // ~1500us
         static constexpr uint16_t CRSF_CHANNEL_VALUE_MAX = 1811; // ~2012us
 
+        // RC_CHANNELS_SUBSET: config byte bits 0-4 = first channel, bits 5-6 = resolution
+        static constexpr uint8_t CRSF_SUBSET_START_CHANNEL_MAX = 31;
+        static constexpr float CRSF_SUBSET_US_OFFSET = 988.0f;
+
+        // COMMAND (0x32) general sub-commands used to change the UART speed
+        static constexpr uint8_t CRSF_COMMAND_SUBCMD_GENERAL = 0x0A;
+        static constexpr uint8_t CRSF_COMMAND_SPEED_PROPOSAL = 0x70;
+        static constexpr uint8_t CRSF_COMMAND_SPEED_RESPONSE = 0x71;
+
+        // Subset channel resolution; microseconds = scale * value + 988
+        enum class SubsetResolution : uint8_t
+        {
+            Bits10 = 0, // 1us steps
+            Bits11 = 1, // 0.5us steps
+            Bits12 = 2, // 0.25us steps
+            Bits13 = 3  // 0.125us steps
+        };
+
+        static unsigned subsetBits(SubsetResolution resolution) { return 10u + static_cast<unsigned>(resolution); }
+        static float subsetScale(SubsetResolution resolution) { return 1.0f / static_cast<float>(1u << static_cast<unsigned>(resolution)); }
+
         /**
          * Build a complete CRSF RC channels frame
          * @param channels Array of 16 channel values (172-1811 range)
@@ -35,6 +61,94 @@ namespace ELRS
         static uint8_t buildRcChannelsFrame(const uint16_t channels[CRSF_CHANNEL_COUNT],
                                             std::array<uint8_t, 26> &frame_out);
 
+        /**
+         * Build a CRSF RC_CHANNELS_SUBSET frame carrying a contiguous run of channels
+         * @param channels_us channel_count values in microseconds (clamped to the resolution's range)
+         * @param start_channel Index of the first channel carried (0-31)
+         * @param channel_count Number of channels (1-16)
+         * @param resolution Bits per channel
+         * @param frame_out Output buffer for the complete frame
+         * @return Size of the complete frame, or 0 if the arguments are out of range
+         */
+        static size_t buildRcChannelsSubsetFrame(const float *channels_us, uint8_t start_channel, uint8_t channel_count,
+                                                 SubsetResolution resolution,
+                                                 std::array<uint8_t, CRSF_FRAME_SIZE_MAX> &frame_out);
+
+        /**
+         * Decode an RC_CHANNELS_SUBSET payload (config byte + packed channels)
+         * @param payload Frame payload after the type byte, without CRC
+         * @param length Payload length
+         * @param start_channel_out First channel carried
+         * @param resolution_out Resolution used
+         * @param channels_us_out Decoded values in microseconds
+         * @param max_channels Capacity of channels_us_out
+         * @return Number of channels decoded (0 if the payload is malformed)
+         */
+        static size_t parseRcChannelsSubsetPayload(const uint8_t *payload, size_t length, uint8_t &start_channel_out,
+                                                   SubsetResolution &resolution_out, float *channels_us_out,
+                                                   size_t max_channels);
+
+        /**
+         * Build a COMMAND frame proposing a new UART speed to the TX module
+         * The module answers with a speed response at the current rate; both
+         * sides switch only after an accepting response.
+         * @param port_id UART port the proposal applies to (0 for the handset port)
+         * @param baud_rate Proposed line rate
+         * @param frame_out Output buffer for the complete frame
+         * @return Size of the complete frame
+         */
+        static size_t buildSpeedProposalFrame(uint8_t port_id, uint32_t baud_rate,
+                                              std::array<uint8_t, CRSF_FRAME_SIZE_MAX> &frame_out);
+
+        /**
+         * Build the module's reply to a speed proposal
+         * @param port_id Port echoed from the proposal
+         * @param accepted Whether the module switches
+         * @param frame_out Output buffer for the complete frame
+         * @return Size of the complete frame
+         */
+        static size_t buildSpeedResponseFrame(uint8_t port_id, bool accepted,
+                                              std::array<uint8_t, CRSF_FRAME_SIZE_MAX> &frame_out);
+
+        /**
+         * Decode a speed proposal from a COMMAND frame payload (after the type byte, without CRC)
+         * @return false if the payload is not a speed proposal or its command CRC is wrong
+         */
+        static bool parseSpeedProposalPayload(const uint8_t *payload, size_t length, uint8_t &port_id_out,
+                                              uint32_t &baud_rate_out);
+
+        /**
+         * Decode a speed response from a COMMAND frame payload (after the type byte, without CRC)
+         * @return false if the payload is not a speed response or its command CRC is wrong
+         */
+        static bool parseSpeedResponsePayload(const uint8_t *payload, size_t length, uint8_t &port_id_out,
+                                              bool &accepted_out);
+
+        /**
+         * Convert a CRSF channel value to microseconds (172 = 988us, 1811 = 2012us)
+         * @param value CRSF channel value
+         * @return Pulse width in microseconds
+         */
+        static float channelValueToMicroseconds(uint16_t value);
+
+        /**
+         * Re-encode only the channels flagged in dirty_mask inside an existing
+         * RC channels frame, then recompute its CRC
+         * @param channels Array of 16 channel values (only dirty ones are read)
+         * @param dirty_mask Bit n set = channel n changed
+         * @param frame Frame previously produced by buildRcChannelsFrame
+         */
+        static void updateRcChannelsFrame(const uint16_t channels[CRSF_CHANNEL_COUNT], uint16_t dirty_mask,
+                                          std::array<uint8_t, 26> &frame);
+
+        /**
+         * Overwrite one 11-bit channel in a packed RC payload (touches 2-3 bytes)
+         * @param packed Packed RC payload (22 bytes)
+         * @param channel Channel index (0-15)
+         * @param value Channel value
+         */
+        static void setPackedChannel(uint8_t packed[CRSF_FRAME_CHANNELS_PAYLOAD_SIZE], size_t channel, uint16_t value);
+
         /**
          * Pack 16 channels (11-bit each) into 22 bytes
          * @param channels Array of 16 channel values
@@ -44,7 +158,32 @@ namespace ELRS
                                  uint8_t packed_out[CRSF_FRAME_CHANNELS_PAYLOAD_SIZE]);
 
         /**
-         * Calculate CRSF CRC8
+         * Unpack 22 bytes into 16 channels (11-bit each), the inverse of packChannels
+         * @param packed Packed RC payload (22 bytes)
+         * @param channels_out Output array for 16 channel values
+         */
+        static void unpackChannels(const uint8_t packed[CRSF_FRAME_CHANNELS_PAYLOAD_SIZE],
+                                   uint16_t channels_out[CRSF_CHANNEL_COUNT]);
+
+        /**
+         * Pack many frames' worth of channels in one call
+         * @param channels frame_count * 16 channel values, frame after frame
+         * @param frame_count Number of frames
+         * @param packed_out Output; frame i starts at packed_out + i * packed_stride
+         * @param packed_stride Bytes between packed payloads (22 for a dense array,
+         *                      26 to write straight into consecutive RC frames + 3)
+         */
+        static void packChannelsBatch(const uint16_t *channels, size_t frame_count,
+                                      uint8_t *packed_out, size_t packed_stride = CRSF_FRAME_CHANNELS_PAYLOAD_SIZE);
+
+        /**
+         * Unpack many packed payloads in one call (layout as packChannelsBatch)
+         */
+        static void unpackChannelsBatch(const uint8_t *packed, size_t frame_count,
+                                        uint16_t *channels_out, size_t packed_stride = CRSF_FRAME_CHANNELS_PAYLOAD_SIZE);
+
+        /**
+         * Calculate CRSF CRC8 (DVB-S2, see Checksum::crc8DvbS2)
          * @param data Pointer to data
          * @param length Length of data
          * @return CRC8 value
@@ -71,25 +210,6 @@ namespace ELRS
          * @return CRSF channel value (172-1811)
          */
         static uint16_t mapThrottleToChannel(float throttle_value);
-
-    private:
-        static constexpr uint8_t crc8_table[256] = {
-            0x00, 0xD5, 0x7F, 0xAA, 0xFE, 0x2B, 0x81, 0x54, 0x29, 0xFC, 0x56, 0x83, 0xD7, 0x02, 0xA8, 0x7D,
-            0x52, 0x87, 0x2D, 0xF8, 0xAC, 0x79, 0xD3, 0x06, 0x7B, 0xAE, 0x04, 0xD1, 0x85, 0x50, 0xFA, 0x2F,
-            0xA4, 0x71, 0xDB, 0x0E, 0x5A, 0x8F, 0x25, 0xF0, 0x8D, 0x58, 0xF2, 0x27, 0x73, 0xA6, 0x0C, 0xD9,
-            0xF6, 0x23, 0x89, 0x5C, 0x08, 0xDD, 0x77, 0xA2, 0xDF, 0x0A, 0xA0, 0x75, 0x21, 0xF4, 0x5E, 0x8B,
-            0x9D, 0x48, 0xE2, 0x37, 0x63, 0xB6, 0x1C, 0xC9, 0xB4, 0x61, 0xCB, 0x1E, 0x4A, 0x9F, 0x35, 0xE0,
-            0xCF, 0x1A, 0xB0, 0x65, 0x31, 0xE4, 0x4E, 0x9B, 0xE6, 0x33, 0x99, 0x4C, 0x18, 0xCD, 0x67, 0xB2,
-            0x39, 0xEC, 0x46, 0x93, 0xC7, 0x12, 0xB8, 0x6D, 0x10, 0xC5, 0x6F, 0xBA, 0xEE, 0x3B, 0x91, 0x44,
-            0x6B, 0xBE, 0x14, 0xC1, 0x95, 0x40, 0xEA, 0x3F, 0x42, 0x97, 0x3D, 0xE8, 0xBC, 0x69, 0xC3, 0x16,
-            0xEF, 0x3A, 0x90, 0x45, 0x11, 0xC4, 0x6E, 0xBB, 0xC6, 0x13, 0xB9, 0x6C, 0x38, 0xED, 0x47, 0x92,
-            0xBD, 0x68, 0xC2, 0x17, 0x43, 0x96, 0x3C, 0xE9, 0x94, 0x41, 0xEB, 0x3E, 0x6A, 0xBF, 0x15, 0xC0,
-            0x4B, 0x9E, 0x34, 0xE1, 0xB5, 0x60, 0xCA, 0x1F, 0x62, 0xB7, 0x1D, 0xC8, 0x9C, 0x49, 0xE3, 0x36,
-            0x19, 0xCC, 0x66, 0xB3, 0xE7, 0x32, 0x98, 0x4D, 0x30, 0xE5, 0x4F, 0x9A, 0xCE, 0x1B, 0xB1, 0x64,
-            0x72, 0xA7, 0x0D, 0xD8, 0x8C, 0x59, 0xF3, 0x26, 0x5B, 0x8E, 0x24, 0xF1, 0xA5, 0x70, 0xDA, 0x0F,
-            0x20, 0xF5, 0x5F, 0x8A, 0xDE, 0x0B, 0xA1, 0x74, 0x09, 0xDC, 0x76, 0xA3, 0xF7, 0x22, 0x88, 0x5D,
-            0xD6, 0x03, 0xA9, 0x7C, 0x28, 0xFD, 0x57, 0x82, 0xFF, 0x2A, 0x80, 0x55, 0x01, 0xD4, 0x7E, 0xAB,
-            0x84, 0x51, 0xFB, 0x2E, 0x7A, 0xAF, 0x05, 0xD0, 0xAD, 0x78, 0xD2, 0x07, 0x53, 0x86, 0x2C, 0xF9};
     };
 
 } // namespace ELRS
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "frame_demuxer.h"
+#include "msp_protocol.h"
+#include "msp_tunnel.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ELRS
+{
+
+    /**
+     * Emulator configuration
+     * Rates are in Hz at real-world speed; rate_multiplier scales all of them
+     * so telemetry can be load-tested at 10-100x what a module produces.
+     */
+    struct EmulatorConfig
+    {
+        double link_stats_hz = 10.0;  // CRSF LINK_STATISTICS (0x14)
+        double battery_hz = 1.0;      // CRSF BATTERY_SENSOR (0x08)
+        double spectrum_hz = 2.0;     // MSP 0x2D push carrying spectrum bins (0 disables)
+        double rate_multiplier = 1.0; // Applied to every rate above
+        double error_ratio = 0.0;     // Fraction of emitted frames sent with a corrupted CRC
+        double noise_ratio = 0.0;     // Fraction of emitted frames preceded by line noise
+        double sync_hz = 5.0;          // CRSF RADIO_ID timing sync (0 disables)
+        double packet_rate_hz = 250.0; // Simulated air-packet rate the sync frames describe
+        double clock_drift_ppm = 0.0;  // Module clock error against the host
+        int sync_margin_us = 200;      // Lead time the module asks RC frames to arrive with
+        uint32_t max_baud_rate = 5250000;  // Highest speed proposal accepted (0 ignores proposals)
+        uint32_t max_stable_baud_rate = 0; // Above this, 20% of emitted frames are corrupted (0 = all stable)
+        int spectrum_bins = 32;                 // Past 245 the push needs a v1 jumbo or v2 frame
+        MspVersion msp_version = MspVersion::V1; // Framing of unsolicited MSP pushes (requests are answered in kind)
+        MspEncapsulation msp_encapsulation = MspEncapsulation::Crsf; // Likewise: CRSF MSP_RESP chunks or bare '$' frames
+        uint32_t seed = 0x454C5253; // "ELRS" - deterministic by default
+        std::string device_name = "ELRS EMU TX";
+    };
+
+    /**
+     * Emulator counters
+     */
+    struct EmulatorStats
+    {
+        uint64_t rc_frames = 0;        // Valid RC_CHANNELS_PACKED frames consumed
+        uint64_t rc_subset_frames = 0; // Valid RC_CHANNELS_SUBSET frames consumed
+        uint64_t msp_requests = 0;     // Valid MSP requests answered
+        uint64_t msp_tunnelled = 0;    // Of which arrived as CRSF MSP_REQ / MSP_WRITE chunks
+        uint64_t crc_errors = 0;       // Incoming CRSF/MSP frames dropped on CRC mismatch
+        uint64_t frames_sent = 0;      // Telemetry/response frames emitted
+        uint64_t frames_corrupted = 0; // Of which sent with a bad CRC on purpose
+        uint64_t bytes_sent = 0;
+        uint64_t bytes_dropped = 0; // Host not draining the PTY fast enough
+        uint64_t sync_frames = 0;   // RADIO_ID timing frames sent
+        int64_t rc_lead_us = 0;     // How long before its air slot the last RC frame arrived
+        uint32_t baud_rate = 420000; // Line rate agreed with the host (a PTY carries any rate)
+        uint64_t speed_changes = 0;  // Accepted speed proposals
+    };
+
+    /**
+     * Virtual ELRS TX module
+     * Opens a pseudo-terminal and behaves like a module on the other end of a
+     * serial link: it consumes CRSF RC frames, answers the MSP commands issued by
+     * MspCommands and streams link statistics, battery and spectrum telemetry.
+     * Point a SerialBridge at getDevicePath() to run the real stack without
+     * hardware. POSIX only; start() fails on other platforms.
+     */
+    class ElrsEmulator
+    {
+    public:
+        explicit ElrsEmulator(const EmulatorConfig &config = EmulatorConfig());
+        ~ElrsEmulator();
+
+        ElrsEmulator(const ElrsEmulator &) = delete;
+        ElrsEmulator &operator=(const ElrsEmulator &) = delete;
+
+        bool start();
+        void stop();
+        bool isRunning() const { return running_.load(); }
+
+        // Slave side of the PTY, e.g. "/dev/pts/3"
+        std::string getDevicePath() const { return device_path_; }
+
+        EmulatorStats getStats() const;
+        std::array<uint16_t, 16> getLastChannels() const;
+        int getPowerLevelMw() const;
+        uint8_t getModelId() const;
+        std::string getLastError() const { return last_error_; }
+
+    private:
+        EmulatorConfig config_;
+        int master_fd_ = -1;
+        std::string device_path_;
+        std::string last_error_;
+
+        std::atomic<bool> running_{false};
+        std::unique_ptr<std::thread> thread_;
+
+        mutable std::mutex state_mutex_;
+        EmulatorStats stats_;
+        std::array<uint16_t, 16> channels_{};
+        size_t power_index_ = 2;
+        uint8_t model_id_ = 0;
+
+        // Air-packet slot grid and last RC arrival, for timing sync
+        std::chrono::steady_clock::time_point slot_origin_;
+        std::chrono::steady_clock::time_point last_rc_time_;
+
+        std::mt19937 rng_;
+        FrameDemuxer demuxer_;
+        uint8_t tunnel_sequence_ = 0; // Next MSP_RESP chunk sequence
+
+        void emulatorLoop();
+        void processInput();
+        void handleMspRequest(const MspFrameView &request);
+        void handleSpeedProposal(uint8_t port_id, uint32_t baud_rate);
+
+        void sendLinkStats();
+        void sendBattery();
+        void sendSpectrum(bool include_bins, MspVersion version, MspEncapsulation encapsulation);
+        void sendTimingSync();
+        void sendCrsfFrame(uint8_t address, uint8_t type, const uint8_t *payload, uint8_t length);
+        void sendMspResponse(uint16_t function, const uint8_t *payload, size_t length, MspVersion version,
+                             MspEncapsulation encapsulation, char direction = '>');
+        void emit(std::vector<uint8_t> &frame, size_t crc_offset);
+
+        bool chance(double ratio);
+        void setError(const std::string &error);
+    };
+
+} // namespace ELRS
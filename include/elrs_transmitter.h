@@ -1,5 +1,11 @@
 #pragma once
 
+#include "byte_span.h"
+#include "crsf_protocol.h"
+#include "seqlock.h"
+#include "tx_scheduler.h"
+#include "write_scheduler.h"
+
 #include <atomic>
 #include <thread>
 #include <memory>
@@ -9,14 +15,17 @@
 namespace ELRS
 {
 
-    class UsbBridge;        // Forward declaration
-    class SerialBridge;     // Forward declaration
+    class ITransport;       // Forward declaration
     class TelemetryHandler; // Forward declaration
     class MspCommands;      // Forward declaration
+    class MspCorrelator;    // Forward declaration
+    class BaudNegotiator;   // Forward declaration
 
     /**
      * Main ELRS Transmitter Controller
-     * Handles 250Hz CRSF transmission loop and control logic
+     * Handles the CRSF transmission loop (50-1000Hz, default 250Hz) and control logic;
+     * the loop phase-locks to the module when it sends RADIO_ID timing frames
+     * Runs over any ITransport (USB, serial, TCP, replay) with telemetry and MSP on the same link
      */
     class ElrsTransmitter
     {
@@ -32,8 +41,22 @@ namespace ELRS
             bool mode2 = false;    // AUX3 channel
         };
 
-        ElrsTransmitter(UsbBridge *usb_bridge);
-        ElrsTransmitter(SerialBridge *serial_bridge); // Constructor for serial mode
+        /**
+         * RC frame format selection
+         * In hot-stick mode the first hot_channel_count channels go out every period
+         * in a small RC_CHANNELS_SUBSET frame; a full RC_CHANNELS_PACKED frame is
+         * sent every full_refresh_interval frames and immediately whenever any
+         * other channel (arm, modes) changes.
+         */
+        struct RcFrameConfig
+        {
+            bool hot_sticks = false;
+            uint8_t hot_channel_count = 4; // AETR
+            CrsfProtocol::SubsetResolution hot_resolution = CrsfProtocol::SubsetResolution::Bits12;
+            int full_refresh_interval = 25; // Frames between full refreshes (100ms at 250Hz)
+        };
+
+        explicit ElrsTransmitter(ITransport *transport);
         ~ElrsTransmitter();
 
         // Control the transmitter
@@ -41,39 +64,99 @@ namespace ELRS
         void stop();
         bool isRunning() const { return running_.load(); }
 
-        // Set control inputs
+        // Set control inputs (any thread; never blocks the TX loop)
         void setControlInputs(const ControlInputs &inputs);
-        ControlInputs getControlInputs() const;
+        ControlInputs getControlInputs() const { return published_inputs_.load(); }
 
         // Safety controls
         void setArmed(bool armed);
-        bool isArmed() const { return control_inputs_.armed; }
+        bool isArmed() const { return armed_.load(std::memory_order_acquire); }
         void emergencyStop();
 
+        // Packet rate (50/150/250/500/1000Hz); can be changed while running
+        bool setPacketRate(int rate_hz);
+        int getPacketRate() const { return scheduler_.getRate(); }
+        TxTimingStats getTimingStats() const { return scheduler_.getStats(); }
+        const TxScheduler &getScheduler() const { return scheduler_; }
+
+        // RC frame format (any thread; applies from the next frame)
+        bool setRcFrameConfig(const RcFrameConfig &config);
+        RcFrameConfig getRcFrameConfig() const { return rc_config_.load(); }
+        uint64_t getRcSubsetFramesSent() const { return rc_subset_frames_.load(std::memory_order_relaxed); }
+
+        // RC frame cache effectiveness: frames sent unchanged, channels re-encoded
+        uint64_t getRcFramesReused() const { return rc_frames_reused_.load(std::memory_order_relaxed); }
+        uint64_t getRcChannelsEncoded() const { return rc_channels_encoded_.load(std::memory_order_relaxed); }
+
         // Access to subsystems
         TelemetryHandler *getTelemetryHandler() const { return telemetry_handler_.get(); }
         MspCommands *getMspCommands() const { return msp_commands_.get(); }
+        MspCorrelator *getMspCorrelator() const { return msp_correlator_.get(); }
+        WriteScheduler *getWriteScheduler() const { return write_scheduler_.get(); }
+        BaudNegotiator *getBaudNegotiator() const { return baud_negotiator_.get(); }
+
+        // Negotiate the fastest stable UART rate on start() (links with an adjustable rate only)
+        void setAutoBaud(bool enabled) { auto_baud_ = enabled; }
+        bool getAutoBaud() const { return auto_baud_; }
 
         std::string getLastError() const { return last_error_; }
 
     private:
-        UsbBridge *usb_bridge_;
-        SerialBridge *serial_bridge_;
-        bool using_serial_mode_;
-        std::unique_ptr<TelemetryHandler> telemetry_handler_;
+        ITransport *transport_;
+        std::shared_ptr<TelemetryHandler> telemetry_handler_; // Shared with other readers of the transport
+        bool telemetry_started_ = false;                      // Holds one of the handler's start() references
+        uint64_t msp_reply_callback_id_ = 0;
+        uint64_t timing_sync_callback_id_ = 0;
+        std::unique_ptr<WriteScheduler> write_scheduler_; // Sole writer while running
         std::unique_ptr<MspCommands> msp_commands_;
+        std::unique_ptr<MspCorrelator> msp_correlator_; // Request/reply matching on top of msp_commands_
+        std::unique_ptr<BaudNegotiator> baud_negotiator_;
+        bool auto_baud_ = true;
 
         // Transmitter state
         std::atomic<bool> running_{false};
         std::unique_ptr<std::thread> tx_thread_;
+        TxScheduler scheduler_;
+
+        // Producers serialise on inputs_mutex_ and publish through the seqlock;
+        // the TX thread only reads published_inputs_ and never takes the mutex
         ControlInputs control_inputs_;
-        mutable std::mutex inputs_mutex_;
+        std::mutex inputs_mutex_;
+        SeqLock<ControlInputs> published_inputs_;
+        std::atomic<bool> armed_{false};
+
+        // Input logging throttle (guarded by inputs_mutex_)
+        ControlInputs last_logged_inputs_;
+        int input_log_counter_ = 0;
+
+        // Last encoded RC frame (TX thread only); re-encoded per channel when inputs change
+        std::array<uint8_t, 26> rc_frame_{};
+        std::array<uint16_t, 16> rc_channels_{};
+        uint64_t rc_frame_version_ = 0; // Seqlock version rc_frame_ was built from
+        ControlInputs rc_inputs_;       // Snapshot rc_frame_ was built from
+        uint16_t rc_pending_dirty_ = 0; // Channels changed since the last full frame went out
+
+        // Hot-stick subset frames (TX thread only, config published like the inputs)
+        SeqLock<RcFrameConfig> rc_config_;
+        std::array<uint8_t, CrsfProtocol::CRSF_FRAME_SIZE_MAX> subset_frame_{};
+        size_t subset_frame_size_ = 0;
+        uint64_t subset_frame_version_ = 0;
+        RcFrameConfig subset_frame_config_;
+        int frames_since_full_ = 0;
+        std::atomic<uint64_t> rc_subset_frames_{0};
+        std::atomic<uint64_t> rc_frames_reused_{0};
+        std::atomic<uint64_t> rc_channels_encoded_{0};
 
         std::string last_error_;
 
-        // 250Hz transmission loop
+        // Deadline-driven transmission loop
         void transmissionLoop();
-        void buildChannelFrame(std::array<uint8_t, 26> &frame);
+        const std::array<uint8_t, 26> &buildChannelFrame();
+        ByteSpan nextRcFrame();
+        ByteSpan buildSubsetFrame(const RcFrameConfig &config);
+        static void mapInputsToChannels(const ControlInputs &inputs, std::array<uint16_t, 16> &channels);
+        static void mapInputsToMicroseconds(const ControlInputs &inputs, std::array<float, 16> &channels_us);
+        void publishInputs();
 
         void setError(const std::string &error);
     };
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "byte_span.h"
+#include "msp_protocol.h"
+#include "msp_tunnel.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ELRS
+{
+
+    /**
+     * Parsed CRSF frame
+     * Views point into the buffer passed to FrameDemuxer::feed() and are only
+     * valid for the duration of the handler call.
+     */
+    struct CrsfFrameView
+    {
+        uint8_t address = 0;
+        uint8_t type = 0;
+        ByteSpan payload; // Between type and CRC
+        ByteSpan raw;     // Whole frame including sync and CRC
+    };
+
+    /**
+     * Parsed MSP v1 / v1 jumbo / v2 frame (same lifetime rules as CrsfFrameView)
+     */
+    struct MspFrameView
+    {
+        char direction = '>'; // '<' request, '>' response, '!' error
+        MspVersion version = MspVersion::V1;
+        uint8_t flags = 0; // v2 only
+        uint16_t function = 0;
+        ByteSpan payload;
+        ByteSpan raw;            // Whole frame; for a tunnelled message, the reassembled payload
+        uint8_t crsf_origin = 0; // Sender address when tunnelled over CRSF, 0 for a '$' frame
+
+        bool fromDevice() const { return direction != '<'; }
+    };
+
+    /**
+     * Demuxer counters (snapshot)
+     */
+    struct DemuxerStats
+    {
+        uint64_t crsf_frames = 0;
+        uint64_t msp_frames = 0;
+        uint64_t crc_errors = 0;
+        uint64_t discarded_bytes = 0; // Line noise and bytes skipped while resyncing
+        uint64_t msp_tunnelled = 0;   // MSP messages reassembled from CRSF MSP frames (also in msp_frames)
+        uint64_t tunnel_errors = 0;   // MSP-over-CRSF chunks dropped out of sequence or malformed
+    };
+
+    /**
+     * Streaming demultiplexer for CRSF and MSP (v1, v1 jumbo, v2) sharing one byte stream
+     * Modules interleave CRSF telemetry and MSP replies on the same UART, so
+     * both framings are recognised at every position. A frame with a bad length
+     * or CRC only advances the parser by one byte, so a valid frame hiding
+     * behind a false sync byte is never lost.
+     *
+     * Frames that lie entirely inside one feed() buffer are dispatched without
+     * copying; only a frame split across feeds is staged, in a buffer grown to
+     * that frame's size and topped up with one memcpy once its length is known. Line noise between
+     * frames is skipped with an SSE2/AVX2 sync-byte scan (table lookup elsewhere).
+     * Handlers are looked up in flat 256-entry tables keyed by CRSF frame type
+     * and MSP function; MSP v2 functions above 255 always go to the default
+     * handler. MSP tunnelled in CRSF MSP_REQ / MSP_RESP / MSP_WRITE frames is
+     * reassembled and dispatched through the MSP handlers exactly like a '$'
+     * frame, unless a CRSF handler is registered for that frame type.
+     * feed() must be called from one thread at a time.
+     */
+    class FrameDemuxer
+    {
+    public:
+        using CrsfHandler = std::function<void(const CrsfFrameView &)>;
+        using MspHandler = std::function<void(const MspFrameView &)>;
+
+        // CRSF sync (address) bytes accepted as frame starts
+        static constexpr uint8_t CRSF_SYNC_FLIGHT_CONTROLLER = 0xC8;
+        static constexpr uint8_t CRSF_SYNC_RADIO_TRANSMITTER = 0xEA;
+        static constexpr uint8_t CRSF_SYNC_RECEIVER = 0xEC;
+        static constexpr uint8_t CRSF_SYNC_TRANSMITTER = 0xEE;
+
+        void setCrsfHandler(uint8_t type, CrsfHandler handler) { crsf_handlers_[type] = std::move(handler); }
+        void setMspHandler(uint8_t function, MspHandler handler) { msp_handlers_[function] = std::move(handler); }
+
+        // Called for frames whose type/function has no dedicated handler
+        void setDefaultCrsfHandler(CrsfHandler handler) { default_crsf_handler_ = std::move(handler); }
+        void setDefaultMspHandler(MspHandler handler) { default_msp_handler_ = std::move(handler); }
+
+        void feed(const uint8_t *data, size_t length);
+        void feed(ByteSpan data) { feed(data.data(), data.size()); }
+
+        // Drop any partially received frame
+        void reset()
+        {
+            pending_size_ = 0;
+            msp_reassembler_.reset();
+        }
+
+        DemuxerStats getStats() const;
+
+    private:
+        // Staging starts at the largest plain MSP v1 frame and grows only for jumbo / v2 frames
+        static constexpr size_t INITIAL_PENDING_SIZE = 261;
+        static constexpr size_t CRSF_MAX_LENGTH = 62; // type + payload + CRC
+
+        enum class ParseResult
+        {
+            Frame,
+            Incomplete,
+            Invalid
+        };
+
+        std::array<CrsfHandler, 256> crsf_handlers_;
+        std::array<MspHandler, 256> msp_handlers_;
+        CrsfHandler default_crsf_handler_;
+        MspHandler default_msp_handler_;
+
+        // Head of a frame split across feed() calls
+        std::vector<uint8_t> pending_ = std::vector<uint8_t>(INITIAL_PENDING_SIZE);
+        size_t pending_size_ = 0;
+
+        MspReassembler msp_reassembler_;
+
+        std::atomic<uint64_t> crsf_frames_{0};
+        std::atomic<uint64_t> msp_frames_{0};
+        std::atomic<uint64_t> crc_errors_{0};
+        std::atomic<uint64_t> discarded_bytes_{0};
+        std::atomic<uint64_t> msp_tunnelled_{0};
+
+        // Dispatch every complete frame in [data, data + length); returns the bytes consumed.
+        // Anything left over is the head of an incomplete frame.
+        size_t scan(const uint8_t *data, size_t length);
+
+        // Try to parse one frame at data[0]; frame_size is set for Frame
+        ParseResult parseFrame(const uint8_t *data, size_t available, size_t &frame_size);
+        ParseResult parseCrsf(const uint8_t *data, size_t available, size_t &frame_size);
+        ParseResult parseMsp(const uint8_t *data, size_t available, size_t &frame_size);
+
+        // Bytes needed before parseFrame() can decide about the frame at data[0]
+        static size_t bytesNeeded(const uint8_t *data, size_t available);
+
+        // Total size of the MSP frame at data[0] ('$' plus a valid version byte), 0 until its header is in
+        static size_t mspFrameSize(const uint8_t *data, size_t available);
+        static bool isSyncByte(uint8_t byte);
+
+        void dispatchCrsf(const uint8_t *frame, size_t frame_size);
+        void dispatchMsp(const uint8_t *frame, size_t frame_size);
+        void dispatchTunnelledMsp(const CrsfFrameView &chunk);
+        void routeMsp(const MspFrameView &view);
+        void drainPending();
+    };
+
+} // namespace ELRS
@@ -29,6 +29,7 @@ namespace ELRS
     class ElrsTransmitter;
     class TelemetryHandler;
     class MspCommands;
+    class MspCorrelator;
 
     namespace UI
     {
@@ -104,6 +105,9 @@ namespace ELRS
             std::vector<int> generateSpectrumSamples(bool *usingRealData = nullptr) const;
             Element createSpectrumBars(const std::vector<int> &values, int height = 10) const;
 
+            // Radio state for the frame being drawn (loaded once per render pass in run())
+            const RadioSnapshot &frameSnapshot() const;
+
             // Data access helpers
             std::string getDeviceStatus();
             std::string getConnectionInfo();
@@ -116,6 +120,7 @@ namespace ELRS
             // Setup helpers
             void setupTelemetry();
             void teardownTelemetry();
+            void removeTelemetryCallbacks();
             void rebuildConfigOptions();
             void syncConfigOptionsFromTelemetry();
             void handleConfigAdjustment(int direction);
@@ -161,12 +166,21 @@ namespace ELRS
             // Member variables
             ScreenInteractive screen_;
             Component mainContainer_;
+            mutable std::shared_ptr<const RadioSnapshot> frameSnapshot_;
             Component currentComponent_;
             ScreenType currentScreen_;
 
             bool running_;
             bool initialized_;
 
+            // Lets completions arriving on other threads (MSP replies, timeouts) check the manager is still live
+            struct CallbackGuard
+            {
+                std::mutex mutex;
+                bool alive = true;
+            };
+            std::shared_ptr<CallbackGuard> callbackGuard_;
+
             std::chrono::steady_clock::time_point lastUpdate_;
             static constexpr int DEFAULT_UPDATE_INTERVAL_MS = 500;
             static constexpr int DEFAULT_SPECTRUM_INTERVAL_MS = 1000;
@@ -178,7 +192,10 @@ namespace ELRS
 
             std::shared_ptr<ElrsTransmitter> transmitter_;
             TelemetryHandler *telemetryHandler_;
+            bool telemetryStarted_; // Holds one of the handler's start() references
+            std::vector<uint64_t> telemetryCallbacks_; // Our registrations on the shared handler
             MspCommands *mspCommands_;
+            MspCorrelator *mspCorrelator_;
 
             std::thread refreshThread_;
             std::atomic<bool> refreshThreadRunning_;
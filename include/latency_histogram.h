@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ELRS
+{
+
+    /**
+     * HDR-style latency histogram
+     * Log-linear buckets: every power-of-two range is split into 16 linear
+     * sub-buckets, so any recorded value is reported within ~6% across the full
+     * 64-bit range (nanoseconds to hours) in fixed memory. Recording is
+     * wait-free (relaxed atomic increments) and may run on a real-time thread
+     * while another thread reads percentiles.
+     */
+    class LatencyHistogram
+    {
+    public:
+        LatencyHistogram() { reset(); }
+
+        LatencyHistogram(const LatencyHistogram &) = delete;
+        LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+        void record(uint64_t value)
+        {
+            buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+            count_.fetch_add(1, std::memory_order_relaxed);
+            sum_.fetch_add(value, std::memory_order_relaxed);
+
+            uint64_t current = min_.load(std::memory_order_relaxed);
+            while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+            current = max_.load(std::memory_order_relaxed);
+            while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void reset()
+        {
+            for (auto &bucket : buckets_)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            count_.store(0, std::memory_order_relaxed);
+            sum_.store(0, std::memory_order_relaxed);
+            min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+        uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+
+        uint64_t getMin() const
+        {
+            return getCount() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+        }
+
+        uint64_t getMax() const { return max_.load(std::memory_order_relaxed); }
+
+        double getMean() const
+        {
+            uint64_t count = getCount();
+            return count == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(count);
+        }
+
+        // Value at or below which `percentile` percent (0-100) of samples fall;
+        // reported as the upper edge of the matching bucket, clamped to the max seen
+        uint64_t getPercentile(double percentile) const
+        {
+            uint64_t total = 0;
+            std::array<uint64_t, BUCKET_COUNT> counts;
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            {
+                counts[i] = buckets_[i].load(std::memory_order_relaxed);
+                total += counts[i];
+            }
+            if (total == 0)
+            {
+                return 0;
+            }
+
+            percentile = std::min(100.0, std::max(0.0, percentile));
+            uint64_t target = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+            target = std::max<uint64_t>(target, 1);
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            {
+                seen += counts[i];
+                if (seen >= target)
+                {
+                    return std::min(bucketUpperBound(i), getMax());
+                }
+            }
+            return getMax();
+        }
+
+    private:
+        static constexpr unsigned SUB_BUCKET_BITS = 5;
+        static constexpr uint64_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS; // 32
+        static constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;   // 16
+        static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> min_{0};
+        std::atomic<uint64_t> max_{0};
+
+        static unsigned highestBit(uint64_t value)
+        {
+            unsigned bit = 0;
+            while (value >>= 1)
+            {
+                ++bit;
+            }
+            return bit;
+        }
+
+        // Values below 32 map 1:1; above that, the top 5 significant bits select the bucket
+        static size_t bucketIndex(uint64_t value)
+        {
+            if (value < SUB_BUCKET_COUNT)
+            {
+                return static_cast<size_t>(value);
+            }
+            unsigned shift = highestBit(value) - (SUB_BUCKET_BITS - 1);
+            return static_cast<size_t>(SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF +
+                                       ((value >> shift) - SUB_BUCKET_HALF));
+        }
+
+        static uint64_t bucketUpperBound(size_t index)
+        {
+            if (index < SUB_BUCKET_COUNT)
+            {
+                return index;
+            }
+            uint64_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+            uint64_t mantissa = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+            uint64_t upper = ((mantissa + 1) << shift) - 1;
+            return upper < (mantissa << shift) ? std::numeric_limits<uint64_t>::max() : upper;
+        }
+    };
+
+} // namespace ELRS
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ELRS
+{
+
+    /**
+     * Fixed-capacity ring; once full, push() overwrites the oldest entry
+     */
+    template <typename T>
+    class HistoryRing
+    {
+    public:
+        explicit HistoryRing(size_t capacity = 0) : buffer_(capacity) {}
+
+        void push(const T &value)
+        {
+            if (buffer_.empty())
+            {
+                return;
+            }
+            buffer_[head_] = value;
+            if (++head_ == buffer_.size())
+            {
+                head_ = 0;
+            }
+            if (size_ < buffer_.size())
+            {
+                size_++;
+            }
+        }
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return buffer_.size(); }
+
+        void clear()
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+        // Visit the newest max_count entries, oldest first
+        template <typename Visitor>
+        void visit(size_t max_count, Visitor &&visitor) const
+        {
+            const size_t count = std::min(max_count, size_);
+            if (count == 0)
+            {
+                return;
+            }
+            size_t index = (head_ + buffer_.size() - count) % buffer_.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                visitor(buffer_[index]);
+                if (++index == buffer_.size())
+                {
+                    index = 0;
+                }
+            }
+        }
+
+        // Change the capacity, keeping the newest entries that still fit
+        void resize(size_t capacity)
+        {
+            HistoryRing<T> resized(capacity);
+            visit(capacity, [&resized](const T &value)
+                  { resized.push(value); });
+            *this = std::move(resized);
+        }
+
+    private:
+        std::vector<T> buffer_;
+        size_t head_ = 0; // Next slot to write
+        size_t size_ = 0;
+    };
+
+    struct HistorySample
+    {
+        std::chrono::steady_clock::time_point time;
+        int value = 0;
+    };
+
+    /**
+     * Min / max / mean of the samples that fell into one time bucket
+     */
+    struct HistoryRollup
+    {
+        std::chrono::steady_clock::time_point start; // Bucket start (raw samples: the sample time)
+        int min = 0;
+        int max = 0;
+        int64_t sum = 0;
+        uint32_t count = 0;
+
+        double mean() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+    };
+
+    enum class HistoryResolution
+    {
+        Raw,
+        Second,
+        TenSeconds,
+        Minute
+    };
+
+    /**
+     * Timestamped history of one metric with rollup tiers
+     * Raw samples go into a ring of configurable depth. Every sample is also
+     * folded into 1 s, 10 s and 1 min buckets whose rings span 15 minutes,
+     * 3 hours and 24 hours, so a graph can cover a whole session at constant
+     * memory. append() is O(1). Buckets with no samples are not stored; a
+     * visitor sees the gap in the bucket start times. Readers visit entries in
+     * place instead of copying them. Not thread-safe; the owner locks.
+     */
+    class MetricHistory
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t DEFAULT_DEPTH = 1024;
+        static constexpr size_t SECOND_TIER_DEPTH = 900;      // 15 minutes
+        static constexpr size_t TEN_SECOND_TIER_DEPTH = 1080; // 3 hours
+        static constexpr size_t MINUTE_TIER_DEPTH = 1440;     // 24 hours
+
+        explicit MetricHistory(size_t depth = DEFAULT_DEPTH);
+
+        void append(Clock::time_point time, int value);
+        void clear();
+
+        // Raw sample capacity; rollup tiers are unaffected
+        void setDepth(size_t depth) { raw_.resize(depth); }
+        size_t getDepth() const { return raw_.capacity(); }
+        size_t size() const { return raw_.size(); }
+
+        // Buckets held at a resolution, including the one still filling
+        size_t rollupCount(HistoryResolution resolution) const;
+
+        // Newest max_count raw samples, oldest first
+        template <typename Visitor>
+        void visitSamples(size_t max_count, Visitor &&visitor) const
+        {
+            raw_.visit(max_count, visitor);
+        }
+
+        // Newest max_count buckets, oldest first; the last one may still be filling.
+        // Raw resolution presents each sample as a one-sample bucket.
+        template <typename Visitor>
+        void visitRollups(HistoryResolution resolution, size_t max_count, Visitor &&visitor) const
+        {
+            if (resolution == HistoryResolution::Raw)
+            {
+                raw_.visit(max_count, [&visitor](const HistorySample &sample)
+                           {
+                               HistoryRollup rollup;
+                               rollup.start = sample.time;
+                               rollup.min = sample.value;
+                               rollup.max = sample.value;
+                               rollup.sum = sample.value;
+                               rollup.count = 1;
+                               visitor(rollup); });
+                return;
+            }
+
+            const Tier &tier = tierFor(resolution);
+            const bool has_open = tier.open.count > 0;
+            if (max_count == 0)
+            {
+                return;
+            }
+            tier.closed.visit(has_open ? max_count - 1 : max_count, visitor);
+            if (has_open)
+            {
+                visitor(tier.open);
+            }
+        }
+
+    private:
+        struct Tier
+        {
+            Clock::duration resolution;
+            HistoryRing<HistoryRollup> closed;
+            HistoryRollup open;
+            int64_t open_index = 0; // Bucket number of open, valid while open.count > 0
+        };
+
+        HistoryRing<HistorySample> raw_;
+        std::array<Tier, 3> tiers_;
+
+        const Tier &tierFor(HistoryResolution resolution) const;
+    };
+
+} // namespace ELRS
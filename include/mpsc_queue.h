@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ELRS
+{
+
+    /**
+     * Bounded lock-free multi-producer / single-consumer queue
+     * Dmitry Vyukov's bounded queue: each cell carries a sequence number, so a
+     * producer claims a slot with one CAS and publishes it with one release
+     * store, and the consumer never contends with producers on the same word.
+     * Capacity is rounded up to a power of two. push() fails instead of
+     * blocking when the queue is full.
+     */
+    template <typename T>
+    class BoundedMpscQueue
+    {
+    public:
+        explicit BoundedMpscQueue(size_t capacity)
+        {
+            capacity_ = 2;
+            while (capacity_ < capacity)
+            {
+                capacity_ <<= 1;
+            }
+            mask_ = capacity_ - 1;
+            cells_.reset(new Cell[capacity_]);
+            for (size_t i = 0; i < capacity_; ++i)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedMpscQueue(const BoundedMpscQueue &) = delete;
+        BoundedMpscQueue &operator=(const BoundedMpscQueue &) = delete;
+
+        size_t capacity() const { return capacity_; }
+
+        // Producer side (any thread): fill() writes the element in place once a slot is claimed
+        template <typename Fill>
+        bool push(Fill &&fill)
+        {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            Cell *cell;
+            for (;;)
+            {
+                cell = &cells_[pos & mask_];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Full
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            fill(cell->value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Producer side: claim count consecutive slots or none (false when they do not all fit);
+        // fill(i, element) writes element i, and the consumer sees them in order
+        template <typename Fill>
+        bool pushAll(size_t count, Fill &&fill)
+        {
+            if (count == 0 || count > capacity_)
+            {
+                return false;
+            }
+
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                // The consumer frees cells in order, so if the last one is free the others are too
+                Cell &last = cells_[(pos + count - 1) & mask_];
+                size_t sequence = last.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + count - 1);
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Not enough room
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                Cell &cell = cells_[(pos + i) & mask_];
+                fill(i, cell.value);
+                cell.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return true;
+        }
+
+        // Consumer side (one thread): the oldest element, or nullptr when empty
+        T *front()
+        {
+            Cell &cell = cells_[dequeue_pos_ & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            return sequence == dequeue_pos_ + 1 ? &cell.value : nullptr;
+        }
+
+        // Consumer side: release the element returned by front()
+        void pop()
+        {
+            Cell &cell = cells_[dequeue_pos_ & mask_];
+            cell.sequence.store(dequeue_pos_ + capacity_, std::memory_order_release);
+            ++dequeue_pos_;
+        }
+
+        // Consumer side
+        bool empty() const
+        {
+            const Cell &cell = cells_[dequeue_pos_ & mask_];
+            return cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence{0};
+            T value{};
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t capacity_ = 0;
+        size_t mask_ = 0;
+
+        alignas(64) std::atomic<size_t> enqueue_pos_{0};
+        alignas(64) size_t dequeue_pos_ = 0;
+    };
+
+} // namespace ELRS
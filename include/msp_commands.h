@@ -1,13 +1,19 @@
 #pragma once
 
+#include "msp_protocol.h"
+#include "msp_tunnel.h"
+#include "write_scheduler.h"
+
 #include <cstdint>
-#include <array>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace ELRS
 {
 
-    class UsbBridge; // Forward declaration
+    class ITransport; // Forward declaration
 
     /**
      * MSP (MultiWii Serial Protocol) Commands for ELRS
@@ -26,7 +32,19 @@ namespace ELRS
         static constexpr uint8_t ELRS_DEVICE_TX = 0xEE;
         static constexpr uint8_t ELRS_HANDSET_ID = 0xEF;
 
-        MspCommands(UsbBridge *usb_bridge);
+        MspCommands(ITransport *transport);
+
+        // Route commands through a shared writer (falls back to direct writes while it is stopped)
+        void setWriteScheduler(WriteScheduler *scheduler) { write_scheduler_.store(scheduler); }
+
+        // Framing for outgoing commands; functions above 255 always go out as v2
+        void setMspVersion(MspVersion version) { msp_version_.store(version); }
+        MspVersion getMspVersion() const { return msp_version_.load(); }
+
+        // How frames are put on the wire; replies are recognised in either form regardless.
+        // Raw mode still tunnels a message whose frame exceeds WriteScheduler::MAX_WRITE_SIZE.
+        void setMspEncapsulation(MspEncapsulation encapsulation) { encapsulation_.store(encapsulation); }
+        MspEncapsulation getMspEncapsulation() const { return encapsulation_.load(); }
 
         // ELRS specific commands
         bool sendBindCommand();
@@ -36,21 +54,26 @@ namespace ELRS
         bool sendPowerDecrease();
         bool sendModelSelect(uint8_t model_id = 1);
 
-        // Generic MSP command sender
-        bool sendMspCommand(uint8_t function, const uint8_t *payload = nullptr, uint8_t payload_size = 0);
+        // Generic MSP command sender; the frame is sized from the payload (v1 jumbo / v2 past 254 bytes)
+        bool sendMspCommand(uint16_t function, const uint8_t *payload = nullptr, size_t payload_size = 0,
+                            WriteClass write_class = WriteClass::Control);
 
-        std::string getLastError() const { return last_error_; }
+        // Safe from any thread; senders may run on the caller, telemetry and timer threads
+        std::string getLastError() const;
 
     private:
-        UsbBridge *usb_bridge_;
-        std::string last_error_;
+        ITransport *transport_;
+        std::atomic<WriteScheduler *> write_scheduler_{nullptr};
+        std::atomic<MspVersion> msp_version_{MspVersion::V1};
+        std::atomic<MspEncapsulation> encapsulation_{MspEncapsulation::Crsf};
+        std::mutex tunnel_mutex_;     // Held while one message's chunks are encoded and queued
+        uint8_t tunnel_sequence_ = 0; // Next CRSF chunk sequence (low 4 bits used); guarded by tunnel_mutex_
+        mutable std::mutex error_mutex_;
+        std::string last_error_; // Guarded by error_mutex_
 
+        bool sendTunnelled(uint16_t function, const uint8_t *payload, size_t payload_size, WriteClass write_class);
+        bool writeFrame(const uint8_t *frame, size_t size, WriteClass write_class);
         void setError(const std::string &error);
-
-        // MSP frame building
-        void buildMspCommand(uint8_t function, const uint8_t *payload, uint8_t payload_size,
-                             std::array<uint8_t, 64> &out, uint8_t &out_size);
-        uint8_t calculateMspCrc(const uint8_t *data, uint8_t length);
     };
 
 } // namespace ELRS
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "latency_histogram.h"
+#include "write_scheduler.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ELRS
+{
+
+    class MspCommands;   // Forward declaration
+    struct MspFrameView; // Forward declaration
+
+    enum class MspStatus : uint8_t
+    {
+        Ok = 0,         // Module answered
+        Error = 1,      // Module answered with an MSP error ('!')
+        Timeout = 2,    // No answer before the deadline
+        SendFailed = 3, // Could not be written or queued
+        Cancelled = 4   // Correlator stopped first
+    };
+
+    /**
+     * Outcome of one correlated MSP request
+     */
+    struct MspReply
+    {
+        MspStatus status = MspStatus::Timeout;
+        uint16_t function = 0; // Function of the reply (or the expected one on failure)
+        uint64_t sequence = 0;
+        std::vector<uint8_t> payload;
+        std::chrono::microseconds round_trip{0}; // Send to reply; zero unless answered
+
+        bool ok() const { return status == MspStatus::Ok; }
+    };
+
+    /**
+     * Correlator counters (snapshot)
+     * Round trip runs from handing the frame to the writer to the reply being
+     * matched on the parser thread, in microseconds.
+     */
+    struct MspCorrelatorStats
+    {
+        uint64_t requests = 0;
+        uint64_t replies = 0;
+        uint64_t errors = 0;
+        uint64_t timeouts = 0;
+        uint64_t send_failures = 0;
+        uint64_t unmatched = 0; // Replies nobody was waiting for (unsolicited telemetry included)
+        size_t in_flight = 0;
+        size_t queued = 0; // Waiting for an in-flight slot
+        double rtt_mean_us = 0.0;
+        double rtt_p50_us = 0.0;
+        double rtt_p99_us = 0.0;
+        double rtt_max_us = 0.0;
+    };
+
+    /**
+     * MSP request/response correlator
+     * MSP v1 carries no sequence number, and the module answers requests for
+     * the same function in order, so every request is tagged with a local
+     * sequence and kept in a per-function FIFO; a reply completes the oldest
+     * outstanding request whose expected reply function matches. Discovery
+     * (0x28) is answered with DEVICE_INFO (0x29); everything else echoes its
+     * function.
+     *
+     * Up to max_in_flight requests are on the wire at once; further requests
+     * queue and are sent as slots free up, so a batch of reads costs about one
+     * round trip instead of one send-sleep cycle each. Deadlines count from
+     * submission. A timer thread expires overdue requests; a reply that turns
+     * up shortly after its request timed out is swallowed rather than handed
+     * to the next request for the same function. Completions run on the
+     * thread that observed them (the telemetry parser for replies, the timer
+     * thread for timeouts) and must be short.
+     *
+     * Replies reach the correlator through onReply(), normally wired to
+     * TelemetryHandler::addMspReplyCallback().
+     */
+    class MspCorrelator
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Callback = std::function<void(const MspReply &)>;
+
+        static constexpr size_t DEFAULT_MAX_IN_FLIGHT = 8;
+        static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{500};
+
+        explicit MspCorrelator(MspCommands *msp, size_t max_in_flight = DEFAULT_MAX_IN_FLIGHT);
+        ~MspCorrelator();
+
+        MspCorrelator(const MspCorrelator &) = delete;
+        MspCorrelator &operator=(const MspCorrelator &) = delete;
+
+        void start();
+        void stop(); // Completes everything outstanding with Cancelled
+        bool isRunning() const { return running_.load(); }
+
+        // Future-based request; the future is always satisfied (reply, error, timeout or cancel)
+        std::future<MspReply> request(uint16_t function, const uint8_t *payload = nullptr, size_t payload_size = 0,
+                                      std::chrono::milliseconds timeout = DEFAULT_TIMEOUT,
+                                      WriteClass write_class = WriteClass::Control);
+
+        // Callback-based request; returns the sequence assigned to it (0 if rejected at once)
+        uint64_t request(uint16_t function, const uint8_t *payload, size_t payload_size, Callback callback,
+                         std::chrono::milliseconds timeout = DEFAULT_TIMEOUT,
+                         WriteClass write_class = WriteClass::Control);
+
+        // Feed every MSP frame received from the device
+        void onReply(const MspFrameView &frame);
+
+        void setMaxInFlight(size_t max_in_flight);
+        size_t getMaxInFlight() const { return max_in_flight_.load(std::memory_order_relaxed); }
+
+        MspCorrelatorStats getStats() const;
+        void resetStats();
+
+        // Reply function the module uses for a request function
+        static uint16_t replyFunctionFor(uint16_t request_function);
+
+    private:
+        struct Request
+        {
+            uint64_t sequence = 0;
+            uint16_t function = 0;
+            uint16_t reply_function = 0;
+            WriteClass write_class = WriteClass::Control;
+            std::vector<uint8_t> payload;
+            Clock::time_point deadline;
+            Clock::time_point sent;
+            Callback callback;
+        };
+
+        MspCommands *msp_;
+        std::atomic<size_t> max_in_flight_;
+        std::atomic<bool> running_{false};
+        std::unique_ptr<std::thread> timer_thread_;
+
+        mutable std::mutex mutex_; // Guards everything below
+        std::condition_variable timer_cv_;
+        std::unordered_map<uint16_t, std::deque<Request>> in_flight_; // By expected reply function, oldest first
+        std::unordered_map<uint16_t, std::deque<Clock::time_point>> stale_; // Until when a late reply to a timed-out request is expected
+        std::deque<Request> queued_;
+        size_t in_flight_count_ = 0;
+        uint64_t next_sequence_ = 1;
+        MspCorrelatorStats stats_;
+
+        LatencyHistogram rtt_ns_;
+
+        void timerLoop();
+
+        // Move queued requests into free slots; the caller sends them after unlocking
+        void admitLocked(std::vector<Request> &to_send);
+        void send(std::vector<Request> &to_send);
+        Clock::time_point nextDeadlineLocked() const;
+        static void complete(Request &request, MspStatus status);
+    };
+
+} // namespace ELRS
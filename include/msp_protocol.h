@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ELRS
+{
+
+    enum class MspVersion : uint8_t
+    {
+        V1 = 1, // '$M': 8-bit function, XOR checksum (jumbo frames for payloads over 254 bytes)
+        V2 = 2  // '$X': 16-bit function and size, CRC8 DVB-S2
+    };
+
+    /**
+     * MSP framing
+     * v1:       '$' 'M' dir size function payload xor
+     * v1 jumbo: '$' 'M' dir 0xFF function size_lo size_hi payload xor
+     * v2:       '$' 'X' dir flags function_lo function_hi size_lo size_hi payload crc8
+     * The v1 XOR and the v2 CRC both cover everything after the direction byte
+     * up to the checksum. Frames are encoded into a caller-owned vector sized
+     * from the payload, so nothing caps the payload below the protocol limit.
+     */
+    class MspProtocol
+    {
+    public:
+        static constexpr uint8_t MSP_V1_JUMBO_SIZE = 255; // v1 size byte announcing a 16-bit size
+        static constexpr size_t MSP_V1_HEADER_SIZE = 5;
+        static constexpr size_t MSP_V1_JUMBO_HEADER_SIZE = 7;
+        static constexpr size_t MSP_V2_HEADER_SIZE = 8;
+
+        // Largest payload the deframer accepts; a bigger size field is treated as noise
+        static constexpr size_t MSP_MAX_PAYLOAD = 4096;
+
+        static bool isDirection(uint8_t byte) { return byte == '<' || byte == '>' || byte == '!'; }
+
+        // Total frame size for a payload
+        static size_t frameSize(MspVersion version, size_t payload_size);
+
+        /**
+         * Encode one frame, replacing the contents of out
+         * V1 switches to a jumbo frame for payloads over 254 bytes; a function
+         * above 255 always needs V2 and is promoted automatically.
+         * @return Frame size, or 0 if the payload is larger than MSP_MAX_PAYLOAD
+         */
+        static size_t encode(MspVersion version, char direction, uint16_t function, const uint8_t *payload,
+                             size_t payload_size, std::vector<uint8_t> &out, uint8_t flags = 0);
+    };
+
+} // namespace ELRS
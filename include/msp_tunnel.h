@@ -0,0 +1,114 @@
+#pragma once
+
+#include "byte_span.h"
+#include "msp_protocol.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace ELRS
+{
+
+    enum class MspEncapsulation : uint8_t
+    {
+        Crsf = 0, // Chunked into CRSF MSP frames, as ELRS TX modules expect
+        Raw = 1   // Bare '$M' / '$X' frames (MSP passthrough to a flight controller, older emulators)
+    };
+
+    /**
+     * MSP over CRSF
+     * TX modules take MSP wrapped in CRSF extended frames rather than raw '$M'
+     * bytes: [sync] [len] [type] [destination] [origin] [status] [chunk...] [crc]
+     * with type MSP_REQ (0x7A, reads), MSP_WRITE (0x7C, commands with a payload)
+     * or MSP_RESP (0x7B, replies). The status byte carries a 4-bit sequence
+     * that increments with every chunk, a start-of-message flag, the MSP
+     * version and an error flag. The first chunk starts with the MSP header
+     * without '$', direction or checksum (v1: size function, v2: flags
+     * function16 size16); CRSF's own CRC protects every chunk.
+     */
+    class MspTunnel
+    {
+    public:
+        static constexpr uint8_t CRSF_FRAMETYPE_MSP_REQ = 0x7A;
+        static constexpr uint8_t CRSF_FRAMETYPE_MSP_RESP = 0x7B;
+        static constexpr uint8_t CRSF_FRAMETYPE_MSP_WRITE = 0x7C;
+
+        static constexpr uint8_t STATUS_SEQUENCE_MASK = 0x0F;
+        static constexpr uint8_t STATUS_START = 0x10;
+        static constexpr uint8_t STATUS_VERSION_SHIFT = 5;
+        static constexpr uint8_t STATUS_VERSION_MASK = 0x60;
+        static constexpr uint8_t STATUS_ERROR = 0x80;
+
+        // 64-byte CRSF frame minus sync, length, type, destination, origin, status and CRC
+        static constexpr size_t CHUNK_SIZE = 57;
+
+        static bool isMspFrameType(uint8_t type) { return type >= CRSF_FRAMETYPE_MSP_REQ && type <= CRSF_FRAMETYPE_MSP_WRITE; }
+
+        // Chunks needed for one message (v1 above 254 payload bytes is sent as v2)
+        static size_t chunkCount(MspVersion version, uint16_t function, size_t payload_size);
+
+        /**
+         * Split one MSP message into CRSF frames
+         * Every frame is complete (sync to CRC) and handed to emit in order;
+         * chunk i uses sequence (first_sequence + i) & 0x0F.
+         * @return Number of chunks emitted, or 0 if the payload is too large or emit failed
+         */
+        static size_t encode(uint8_t frame_type, uint8_t sync, uint8_t destination, uint8_t origin, MspVersion version,
+                             bool error, uint16_t function, const uint8_t *payload, size_t payload_size,
+                             uint8_t first_sequence, const std::function<bool(const uint8_t *, size_t)> &emit);
+    };
+
+    /**
+     * Reassembles MSP messages from MSP_REQ / MSP_RESP / MSP_WRITE chunks
+     * The message is collected in a fixed buffer sized for the largest
+     * payload the deframer accepts, so reassembly never allocates. A chunk out
+     * of sequence, a continuation without a start, or a message that would
+     * overflow the buffer drops the partial message and is counted as an error.
+     * One reassembler serves one sender; use from one thread at a time.
+     */
+    class MspReassembler
+    {
+    public:
+        /**
+         * Feed the extended-frame payload of one chunk (destination onwards, without CRC)
+         * @return true if this chunk completed a message; its fields stay valid until the next feed()
+         */
+        bool feed(uint8_t frame_type, const uint8_t *payload, size_t length);
+
+        void reset() { active_ = false; }
+
+        // Completed message
+        uint8_t frameType() const { return frame_type_; }
+        uint8_t origin() const { return origin_; }
+        MspVersion version() const { return version_; }
+        bool error() const { return error_; }
+        uint8_t flags() const { return flags_; }
+        uint16_t function() const { return function_; }
+        ByteSpan payload() const { return ByteSpan(buffer_.data(), expected_); }
+
+        // Dropped chunks and incomplete messages; safe to read from any thread
+        uint64_t getErrors() const { return errors_.load(std::memory_order_relaxed); }
+
+    private:
+        std::array<uint8_t, MspProtocol::MSP_MAX_PAYLOAD> buffer_;
+        size_t received_ = 0;
+        size_t expected_ = 0;
+        bool active_ = false;
+        uint8_t next_sequence_ = 0;
+
+        uint8_t frame_type_ = 0;
+        uint8_t origin_ = 0;
+        MspVersion version_ = MspVersion::V1;
+        bool error_ = false;
+        uint8_t flags_ = 0;
+        uint16_t function_ = 0;
+
+        std::atomic<uint64_t> errors_{0};
+
+        bool append(const uint8_t *data, size_t length);
+    };
+
+} // namespace ELRS
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "metric_history.h"
+#include "telemetry_store.h"
+#include "state_dispatcher.h"
+
 #include <string>
 #include <atomic>
 #include <mutex>
@@ -35,6 +39,16 @@ namespace ELRS
         Configuration
     };
 
+    /**
+     * Metrics with a recorded history
+     */
+    enum class HistoryMetric
+    {
+        Rssi,
+        LinkQuality,
+        TxPower
+    };
+
     /**
      * Live telemetry data structure
      */
@@ -85,9 +99,87 @@ namespace ELRS
         std::string frequency = "2.4 GHz";
         std::string protocol = "ExpressLRS";
         int baudRate = 420000;
+        double baudErrorRate = 0.0; // CRC error rate measured at baudRate (0-1)
         bool isVerified = false;
     };
 
+    /**
+     * Immutable view of RadioState at one version
+     * Every write publishes a new snapshot; readers load one with a single
+     * atomic operation and get connection, telemetry, device and spectrum
+     * state that belong together. Device configuration and spectrum bins are
+     * shared with earlier snapshots until they change, so publishing a
+     * telemetry update copies neither.
+     */
+    struct RadioSnapshot
+    {
+        uint64_t version = 0;
+        ConnectionStatus connectionStatus = ConnectionStatus::Disconnected;
+        RadioMode radioMode = RadioMode::Normal;
+        LiveTelemetry telemetry;
+        std::shared_ptr<const DeviceConfiguration> device;
+        std::shared_ptr<const std::vector<int>> spectrum;
+        std::chrono::steady_clock::time_point spectrumLastUpdate;
+        std::string lastError;
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+    class RadioState; // Forward declaration
+
+    /**
+     * Batched telemetry write
+     * Collects any subset of fields and applies them in commit() under one
+     * lock acquisition with one timestamp: each touched history series gets
+     * one sample, one snapshot is published and subscribers are notified
+     * once. An update dropped without commit() changes nothing.
+     */
+    class RadioStateUpdate
+    {
+    public:
+        RadioStateUpdate &rssi(int rssi1, int rssi2 = -120);
+        RadioStateUpdate &linkQuality(int quality); // Clamped to 0-100
+        RadioStateUpdate &snr(int snr);
+        RadioStateUpdate &txPower(int power);
+        RadioStateUpdate &packetStats(uint32_t rx, uint32_t tx, uint32_t lost = 0);
+        RadioStateUpdate &battery(double voltage, double current);
+        RadioStateUpdate &temperature(int temp);
+
+        bool empty() const { return fields_ == 0; }
+
+        // Apply everything set so far; returns the version published (the current one if nothing was set)
+        uint64_t commit();
+
+    private:
+        friend class RadioState;
+
+        enum Field : uint32_t
+        {
+            FIELD_RSSI = 1u << 0,
+            FIELD_LINK_QUALITY = 1u << 1,
+            FIELD_SNR = 1u << 2,
+            FIELD_TX_POWER = 1u << 3,
+            FIELD_PACKETS = 1u << 4,
+            FIELD_BATTERY = 1u << 5,
+            FIELD_TEMPERATURE = 1u << 6
+        };
+
+        explicit RadioStateUpdate(RadioState &state) : state_(&state) {}
+
+        RadioState *state_;
+        uint32_t fields_ = 0;
+        int rssi1_ = 0;
+        int rssi2_ = 0;
+        int link_quality_ = 0;
+        int snr_ = 0;
+        int tx_power_ = 0;
+        uint32_t packets_received_ = 0;
+        uint32_t packets_transmitted_ = 0;
+        uint32_t packets_lost_ = 0;
+        double voltage_ = 0.0;
+        double current_ = 0.0;
+        int temperature_ = 0;
+    };
+
     /**
      * State change callback type
      */
@@ -96,6 +188,12 @@ namespace ELRS
     /**
      * RadioState - Centralized state management for ELRS radio
      * Singleton pattern providing React-like state management
+     * Writers serialise on a mutex and publish a RadioSnapshot after every
+     * change; all getters read the current snapshot without taking the lock.
+     * A UI frame should call getSnapshot() once and read everything from it,
+     * and can compare getVersion() with the last version it drew to skip work.
+     * Observers subscribe() to topics and are called from the dispatcher
+     * thread, never from the writer.
      */
     class RadioState
     {
@@ -107,10 +205,17 @@ namespace ELRS
         RadioState(const RadioState &) = delete;
         RadioState &operator=(const RadioState &) = delete;
 
+        // Consistent, lock-free view of the current state (never null)
+        std::shared_ptr<const RadioSnapshot> getSnapshot() const;
+
+        // Bumped by every published change
+        uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
         // Connection management
         void setConnectionStatus(ConnectionStatus status);
         ConnectionStatus getConnectionStatus() const;
         std::string getConnectionStatusString() const;
+        static std::string connectionStatusToString(ConnectionStatus status);
 
         // Radio mode management
         void setRadioMode(RadioMode mode);
@@ -121,7 +226,10 @@ namespace ELRS
         void setDeviceConfiguration(const DeviceConfiguration &config);
         DeviceConfiguration getDeviceConfiguration() const;
 
-        // Live telemetry updates
+        // Batched update: radioState.beginUpdate().rssi(a, b).linkQuality(q).commit()
+        RadioStateUpdate beginUpdate() { return RadioStateUpdate(*this); }
+
+        // Live telemetry updates (single-field shorthands for beginUpdate()...commit())
         void updateTelemetry(const LiveTelemetry &telemetry);
         void updateRSSI(int rssi1, int rssi2 = -120);
         void updateLinkQuality(int quality);
@@ -151,7 +259,24 @@ namespace ELRS
         void clearError();
         bool hasError() const;
 
-        // State change notifications (React-like)
+        /**
+         * Subscribe to changes on one or more StateTopic bits
+         * The callback runs on the dispatcher thread, at most once per tick,
+         * with the union of topics that changed and a snapshot no older than
+         * those changes. It may call back into RadioState.
+         * @return Id for unsubscribe() and getSubscriberStats()
+         */
+        SubscriptionId subscribe(uint32_t topics, StateSubscriber callback);
+
+        // Waits for a running callback to return (unless called from that callback)
+        void unsubscribe(SubscriptionId id);
+
+        bool getSubscriberStats(SubscriptionId id, SubscriberStats &stats) const;
+
+        // Coalescing window for deliveries (default StateDispatcher::DEFAULT_TICK)
+        void setNotificationTick(std::chrono::milliseconds tick);
+
+        // Single all-topics subscription kept for older callers (delivered like subscribe())
         void subscribeToChanges(StateChangeCallback callback);
         void unsubscribeFromChanges();
 
@@ -161,6 +286,42 @@ namespace ELRS
         std::vector<int> getLinkQualityHistory(int maxPoints = 100) const;
         std::vector<int> getTxPowerHistory(int maxPoints = 100) const;
 
+        // Raw samples kept per metric (rollup tiers are fixed, see MetricHistory)
+        void setHistoryDepth(size_t samples);
+        size_t getHistoryDepth() const;
+
+        /**
+         * Visit the newest samples of a metric in place, oldest first
+         * The visitor runs under the state lock: keep it short and do not call
+         * back into RadioState.
+         * @param visitor Called with const HistorySample &
+         */
+        template <typename Visitor>
+        void visitHistory(HistoryMetric metric, size_t maxPoints, Visitor &&visitor) const
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            historyFor(metric).visitSamples(maxPoints, visitor);
+        }
+
+        /**
+         * Visit min / max / mean buckets of a metric, oldest first (same rules as visitHistory)
+         * @param visitor Called with const HistoryRollup &; the newest bucket may still be filling
+         */
+        template <typename Visitor>
+        void visitHistoryRollups(HistoryMetric metric, HistoryResolution resolution, size_t maxBuckets,
+                                 Visitor &&visitor) const
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            historyFor(metric).visitRollups(resolution, maxBuckets, visitor);
+        }
+
+        /**
+         * Every telemetry update of the session, with wall-clock timestamps
+         * Range queries and exports read it directly; it locks internally, so
+         * no RadioState lock is held while iterating.
+         */
+        const TelemetryStore &getTelemetryStore() const { return telemetry_store_; }
+
         // Spectrum analysis data
         void updateSpectrumData(const std::vector<int> &data);
         std::vector<int> getSpectrumData() const;
@@ -183,30 +344,42 @@ namespace ELRS
         // State data
         std::atomic<ConnectionStatus> connection_status_{ConnectionStatus::Disconnected};
         std::atomic<RadioMode> radio_mode_{RadioMode::Normal};
-        DeviceConfiguration device_config_;
+        std::shared_ptr<const DeviceConfiguration> device_config_;
         LiveTelemetry live_telemetry_;
         std::string last_error_;
         std::atomic<bool> has_error_{false};
         std::atomic<bool> system_ready_{false};
 
         // History tracking for graphs
-        std::vector<int> rssi_history_;
-        std::vector<int> link_quality_history_;
-        std::vector<int> tx_power_history_;
-        static constexpr size_t MAX_HISTORY_SIZE = 200;
-        std::vector<int> spectrum_data_;
+        MetricHistory rssi_history_;
+        MetricHistory link_quality_history_;
+        MetricHistory tx_power_history_;
+        TelemetryStore telemetry_store_;
+        std::shared_ptr<const std::vector<int>> spectrum_data_;
         std::chrono::steady_clock::time_point spectrum_last_update_;
         static constexpr size_t MAX_SPECTRUM_SIZE = 256;
 
         // Timing
         std::chrono::steady_clock::time_point start_time_;
 
-        // State change callback
-        StateChangeCallback state_change_callback_;
+        // Published view; written under state_mutex_, read with atomic_load
+        std::shared_ptr<const RadioSnapshot> snapshot_;
+        std::atomic<uint64_t> version_{0};
+
+        // Change notifications; declared last so it stops before the state it reads
+        std::mutex legacy_mutex_;
+        SubscriptionId legacy_subscription_ = 0;
+        StateDispatcher dispatcher_;
+
+        friend class RadioStateUpdate;
+        uint64_t applyUpdate(const RadioStateUpdate &update);
 
         // Helper methods
-        void notifyStateChange();
-        void addToHistory(std::vector<int> &history, int value);
+        void publishLocked();
+        void recordTelemetryLocked();
+        void notifyStateChange(uint32_t topics);
+        const MetricHistory &historyFor(HistoryMetric metric) const;
+        std::vector<int> historyValues(HistoryMetric metric, int maxPoints) const;
         std::string formatDuration(std::chrono::steady_clock::duration duration) const;
     };
 
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "transport.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ELRS
+{
+
+    /**
+     * Replay transport
+     * Plays back a raw byte capture of a module session as if it were a live link.
+     * Reads can be paced at a baud rate (real-time replay) or served as fast as the
+     * consumer drains them (offline analysis); writes are counted and discarded.
+     */
+    class ReplayTransport : public ITransport
+    {
+    public:
+        ReplayTransport() = default;
+
+        // baud_rate == 0 replays unpaced; loop restarts the capture at the end
+        bool open(const std::string &path, int baud_rate = 0, bool loop = false);
+        bool openBuffer(std::vector<uint8_t> data, int baud_rate = 0, bool loop = false);
+        void close();
+
+        std::string getTransportName() const override { return "replay"; }
+        bool isConnected() const override;
+        bool write(const uint8_t *data, size_t length, int timeout_ms = 1000) override;
+        int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50) override;
+        using ITransport::read;
+        bool waitReadable(int timeout_ms) override;
+        std::string getLastError() const override { return last_error_; }
+
+        // Replay progress
+        size_t getPosition() const;
+        size_t getSize() const;
+        bool finished() const;
+
+        // CRC32 of the loaded capture, to match a replay against its recording
+        uint32_t getCrc32() const;
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<uint8_t> data_;
+        size_t position_ = 0;
+        int baud_rate_ = 0;
+        bool loop_ = false;
+        bool open_ = false;
+        std::chrono::steady_clock::time_point start_time_;
+        size_t bytes_delivered_ = 0;
+        uint32_t crc32_ = 0;
+        std::string last_error_;
+
+        // Bytes the pacing clock allows to be released right now (caller holds mutex_)
+        size_t releasableBytes() const;
+        std::chrono::steady_clock::time_point nextReleaseTime() const;
+    };
+
+} // namespace ELRS
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace ELRS
+{
+
+    /**
+     * Sequence lock for small trivially-copyable snapshots
+     * Readers never take a lock: they copy the payload and
+     * retry if a write overlapped the copy. The payload is held in relaxed
+     * atomic words so torn reads are well-defined and simply discarded.
+     * Writers must be serialised by the caller (one writer at a time); the
+     * sequence is even when stable and odd while a write is in progress.
+     * A reader that keeps colliding with writes yields after a short spin so a
+     * preempted writer can finish; uncontended reads never leave user space.
+     */
+    template <typename T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLock payload must be trivially copyable");
+
+    public:
+        SeqLock() { store(T{}); }
+        explicit SeqLock(const T &value) { store(value); }
+
+        SeqLock(const SeqLock &) = delete;
+        SeqLock &operator=(const SeqLock &) = delete;
+
+        // Writer side (externally serialised)
+        void store(const T &value)
+        {
+            uint64_t words[WORD_COUNT] = {};
+            std::memcpy(words, &value, sizeof(T));
+
+            const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (size_t i = 0; i < WORD_COUNT; ++i)
+            {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+
+            sequence_.store(seq + 2, std::memory_order_release);
+        }
+
+        // Reader side: any thread, wait-free unless a write is mid-flight
+        T load() const
+        {
+            T value;
+            load(value);
+            return value;
+        }
+
+        // Copies the latest snapshot and returns its version (always even)
+        uint64_t load(T &out) const
+        {
+            uint64_t words[WORD_COUNT];
+            uint64_t before;
+            uint64_t after;
+            unsigned spins = 0;
+            do
+            {
+                before = sequence_.load(std::memory_order_acquire);
+                while (before & 1)
+                {
+                    backoff(spins);
+                    before = sequence_.load(std::memory_order_acquire);
+                }
+
+                for (size_t i = 0; i < WORD_COUNT; ++i)
+                {
+                    words[i] = words_[i].load(std::memory_order_relaxed);
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence_.load(std::memory_order_relaxed);
+                if (before != after)
+                {
+                    backoff(spins);
+                }
+            } while (before != after);
+
+            std::memcpy(&out, words, sizeof(T));
+            return before;
+        }
+
+        // Bumps on every store; equal versions mean an identical snapshot
+        uint64_t version() const { return sequence_.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        alignas(64) std::atomic<uint64_t> sequence_{0};
+        std::atomic<uint64_t> words_[WORD_COUNT];
+
+        static void backoff(unsigned &spins)
+        {
+            if (++spins < SPIN_LIMIT)
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+                return;
+            }
+            spins = 0;
+            std::this_thread::yield();
+        }
+
+        static constexpr unsigned SPIN_LIMIT = 64;
+    };
+
+} // namespace ELRS
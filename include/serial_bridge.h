@@ -4,6 +4,8 @@
 #include <vector>
 #include <memory>
 
+#include "transport.h"
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -16,15 +18,18 @@ namespace ELRS
      * - Uses CP210x USB-to-UART serial port
      * - 420,000 baud (or 416,666 exact) as specified in guide
      * - 8-N-1 configuration
+     *
+     * On Linux the port is driven through termios2/BOTHER so the exact CRSF
+     * rates are programmed, and reads are woken by poll() instead of timeouts.
      */
-    class SerialBridge
+    class SerialBridge : public ITransport
     {
     public:
         struct ComPortInfo
         {
-            std::string port;        // e.g., "COM3"
+            std::string port;        // e.g., "COM3" or "/dev/ttyUSB0"
             std::string description; // e.g., "Silicon Labs CP210x USB to UART Bridge"
-            std::string hardware_id; // e.g., "USB\VID_10C4&PID_EA60"
+            std::string hardware_id; // e.g., "USB\VID_10C4&PID_EA60" (same format on Linux)
         };
 
         SerialBridge();
@@ -35,14 +40,22 @@ namespace ELRS
         std::vector<ComPortInfo> findElrsComPorts();                   // Filter for CP210x devices
         bool connect(const std::string &port, int baud_rate = 420000); // 420kbaud as per guide
         void disconnect();
-        bool isConnected() const;
+        bool isConnected() const override;
 
         // Serial communication (8-N-1 as per guide)
-        bool write(const uint8_t *data, size_t length, int timeout_ms = 1000);
-        int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50);
+        std::string getTransportName() const override { return "serial"; }
+        bool write(const uint8_t *data, size_t length, int timeout_ms = 1000) override;
+        bool writev(const IoSlice *slices, size_t count, int timeout_ms = 1000) override;
+        int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50) override;
+        using ITransport::read;
+        bool waitReadable(int timeout_ms) override;
+
+        // Reprogram the open port (e.g. after the module accepted a speed proposal)
+        uint32_t getBaudRate() const override { return connected_ ? baud_rate_ : 0; }
+        bool setBaudRate(uint32_t baud_rate) override;
 
         // Status and error handling
-        std::string getLastError() const { return last_error_; }
+        std::string getLastError() const override { return last_error_; }
         ComPortInfo getConnectedPortInfo() const { return connected_port_; }
 
     private:
@@ -50,12 +63,21 @@ namespace ELRS
         HANDLE serial_handle_;
         bool configureSerialPort(int baud_rate);
         std::vector<ComPortInfo> enumerateWindowsComPorts();
+#elif defined(__linux__)
+        int serial_fd_;
+        bool configureSerialPort(int baud_rate);
+        void enableLowLatency();
+        bool waitForIo(short events, int timeout_ms);
+        std::vector<ComPortInfo> enumerateLinuxComPorts();
 #endif
 
         ComPortInfo connected_port_;
         std::string last_error_;
         bool connected_;
+        uint32_t baud_rate_ = 0;
 
+        bool writeBytes(const uint8_t *data, size_t length, int timeout_ms);
+        int readBytes(uint8_t *buffer, size_t buffer_size, int timeout_ms);
         void setError(const std::string &error);
     };
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ELRS
+{
+
+    struct RadioSnapshot; // Forward declaration
+
+    /**
+     * Topics a RadioState change belongs to (bit mask)
+     */
+    namespace StateTopic
+    {
+        constexpr uint32_t Link = 1u << 0;       // RSSI, link quality, SNR, TX power, packet counters
+        constexpr uint32_t Battery = 1u << 1;    // Voltage, current, temperature
+        constexpr uint32_t Spectrum = 1u << 2;   // Spectrum bins
+        constexpr uint32_t Connection = 1u << 3; // Connection status, radio mode, device configuration, readiness
+        constexpr uint32_t Error = 1u << 4;      // Last error set or cleared
+        constexpr uint32_t All = Link | Battery | Spectrum | Connection | Error;
+    }
+
+    /**
+     * One coalesced delivery to a subscriber
+     */
+    struct RadioStateChange
+    {
+        uint32_t topics = 0;    // Subscribed topics that changed since the previous delivery
+        uint64_t version = 0;   // State version the snapshot shows
+        uint64_t coalesced = 0; // Published changes folded into this delivery
+        std::shared_ptr<const RadioSnapshot> snapshot;
+    };
+
+    using StateSubscriber = std::function<void(const RadioStateChange &)>;
+    using SubscriptionId = uint64_t;
+
+    /**
+     * Per-subscriber delivery counters (snapshot)
+     * pending is how many published changes the subscriber has not been
+     * handed yet: it stays near zero for a subscriber that keeps up and grows
+     * while one falls behind.
+     */
+    struct SubscriberStats
+    {
+        uint64_t deliveries = 0;
+        uint64_t changes = 0;     // Published changes matching the topics
+        uint64_t coalesced = 0;   // Of which folded into an earlier or later delivery
+        uint64_t pending = 0;     // Published but not yet delivered
+        uint64_t max_pending = 0;
+        double last_latency_ms = 0.0; // First pending change to delivery
+        double max_latency_ms = 0.0;
+        double max_callback_ms = 0.0;
+    };
+
+    /**
+     * Topic-filtered fan-out of RadioState changes
+     * Writers call publish() with the topics they touched; it only marks
+     * subscribers pending and wakes the executor, so a writer never runs
+     * subscriber code. The executor thread waits one tick after the first
+     * change, so a burst folds into a single delivery per subscriber, then
+     * calls each pending subscriber with the union of its changed topics and
+     * one snapshot taken for the whole tick. Callbacks run without any lock
+     * held and may read or write RadioState. Subscribers share the executor,
+     * so a slow one delays the rest; its stats show the lag.
+     */
+    class StateDispatcher
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using SnapshotSource = std::function<std::shared_ptr<const RadioSnapshot>()>;
+
+        static constexpr std::chrono::milliseconds DEFAULT_TICK{20};
+
+        explicit StateDispatcher(SnapshotSource source);
+        ~StateDispatcher();
+
+        StateDispatcher(const StateDispatcher &) = delete;
+        StateDispatcher &operator=(const StateDispatcher &) = delete;
+
+        // Starts the executor on first use
+        SubscriptionId subscribe(uint32_t topics, StateSubscriber callback);
+
+        // Once this returns the callback is not running and will not run again (unless called from the callback itself)
+        void unsubscribe(SubscriptionId id);
+
+        void publish(uint32_t topics);
+
+        bool getStats(SubscriptionId id, SubscriberStats &stats) const;
+
+        void setTick(std::chrono::milliseconds tick) { tick_ns_.store(std::chrono::nanoseconds(tick).count()); }
+
+        // Stop the executor; pending changes are dropped
+        void stop();
+
+    private:
+        struct Subscriber
+        {
+            SubscriptionId id = 0;
+            uint32_t topics = 0;
+            StateSubscriber callback;
+
+            // Guarded by mutex_
+            uint32_t pending_topics = 0;
+            uint64_t pending_count = 0;
+            Clock::time_point pending_since;
+            SubscriberStats stats;
+        };
+
+        struct Delivery
+        {
+            std::shared_ptr<Subscriber> subscriber;
+            RadioStateChange change;
+            Clock::time_point pending_since;
+        };
+
+        SnapshotSource source_;
+        std::atomic<int64_t> tick_ns_{std::chrono::nanoseconds(DEFAULT_TICK).count()};
+
+        mutable std::mutex mutex_; // Guards everything below
+        std::condition_variable cv_;
+        std::map<SubscriptionId, std::shared_ptr<Subscriber>> subscribers_;
+        SubscriptionId next_id_ = 1;
+        bool dirty_ = false;
+        bool running_ = false;
+        const Subscriber *delivering_ = nullptr;
+        std::thread executor_;
+
+        void executorLoop();
+    };
+
+} // namespace ELRS
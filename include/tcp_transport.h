@@ -0,0 +1,51 @@
+#pragma once
+
+#include "transport.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace ELRS
+{
+
+    /**
+     * TCP transport
+     * Reaches a module through a network serial bridge (ESP-Link, ser2net, the
+     * ELRS TX backpack) or a remote emulator. Nagle is disabled so every CRSF
+     * frame leaves in its own segment.
+     */
+    class TcpTransport : public ITransport
+    {
+    public:
+        TcpTransport();
+        ~TcpTransport();
+
+        bool connect(const std::string &host, uint16_t port, int timeout_ms = 3000);
+        void disconnect();
+
+        std::string getTransportName() const override { return "tcp"; }
+        bool isConnected() const override { return socket_.load() != INVALID_SOCKET_VALUE && !peer_closed_.load(); }
+        bool write(const uint8_t *data, size_t length, int timeout_ms = 1000) override;
+        int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50) override;
+        using ITransport::read;
+        bool waitReadable(int timeout_ms) override;
+        std::string getLastError() const override { return last_error_; }
+
+        std::string getEndpoint() const { return endpoint_; }
+
+    private:
+        static constexpr intptr_t INVALID_SOCKET_VALUE = -1;
+
+        // Only connect() and disconnect() (the owner) open or close the socket;
+        // the read path only marks the link down when the peer closes it
+        std::atomic<intptr_t> socket_;
+        std::atomic<bool> peer_closed_{false};
+        std::string endpoint_;
+        std::string last_error_;
+
+        static bool waitSocket(intptr_t socket, bool for_write, int timeout_ms);
+        void setError(const std::string &error);
+    };
+
+} // namespace ELRS
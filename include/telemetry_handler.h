@@ -1,16 +1,27 @@
 #pragma once
 
+#include "broadcast_ring.h"
+#include "byte_ring.h"
+#include "frame_demuxer.h"
+#include "latency_histogram.h"
+#include "mpsc_queue.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <atomic>
 #include <thread>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace ELRS
 {
 
-    class UsbBridge; // Forward declaration
+    class ITransport; // Forward declaration
 
     /**
      * Telemetry data structures
@@ -33,9 +44,102 @@ namespace ELRS
         bool valid = false;
     };
 
+    /**
+     * Module timing from CRSF RADIO_ID (0x3A) / OpenTX sync frames
+     * offset_ns is how far ahead of the module's safety margin our RC frames
+     * arrive before its air-packet slot: positive means early, negative late.
+     */
+    struct TimingSync
+    {
+        int64_t interval_ns = 0; // Module packet interval
+        int64_t offset_ns = 0;   // RC frame phase relative to the slot
+        bool valid = false;
+    };
+
+    /**
+     * Decoded telemetry as broadcast to subscribers
+     * Only the member matching type is meaningful; timestamp_ns is the
+     * steady-clock time the frame was dispatched.
+     */
+    enum class TelemetryEventType : uint8_t
+    {
+        LinkStats = 0,
+        Battery = 1,
+        TimingSync = 2
+    };
+
+    struct TelemetryEvent
+    {
+        TelemetryEventType type = TelemetryEventType::LinkStats;
+        uint64_t sequence = 0;
+        int64_t timestamp_ns = 0;
+        LinkStats link_stats;
+        BatteryInfo battery;
+        TimingSync timing_sync;
+    };
+
+    class TelemetryHandler; // Forward declaration
+
+    /**
+     * One consumer's view of a TelemetryHandler's broadcast
+     * Holds a private cursor into the handler's ring: reading never blocks the
+     * parser or other subscribers, and a subscriber that falls too far behind
+     * skips ahead and counts the events it lost. Must not outlive the handler;
+     * use from one thread at a time.
+     */
+    class TelemetrySubscription
+    {
+    public:
+        // Next event if one is pending
+        bool poll(TelemetryEvent &event);
+
+        // Waits up to timeout for the next event
+        bool wait(TelemetryEvent &event, std::chrono::milliseconds timeout);
+
+        uint64_t getLost() const { return lost_; } // Overwritten before this subscriber read them
+        uint64_t getBacklog() const;               // Published but not yet read
+
+    private:
+        friend class TelemetryHandler;
+        TelemetrySubscription(BroadcastRing<TelemetryEvent> *ring, uint64_t cursor)
+            : ring_(ring), cursor_(cursor) {}
+
+        BroadcastRing<TelemetryEvent> *ring_;
+        uint64_t cursor_;
+        uint64_t lost_ = 0;
+    };
+
+    /**
+     * Receive path counters (snapshot)
+     * Latency runs from the reader waking on readable bytes to the end of the
+     * demuxer pass that dispatched them, in microseconds.
+     */
+    struct TelemetryReaderStats
+    {
+        uint64_t bytes_read = 0;
+        uint64_t wakeups = 0;                 // Readiness wakeups that returned data
+        uint64_t bytes_dropped = 0;           // Ring overflow: the parser fell behind the wire
+        uint64_t transport_bytes_dropped = 0; // Overflow inside the transport itself
+        double latency_mean_us = 0.0;
+        double latency_p50_us = 0.0;
+        double latency_p99_us = 0.0;
+        double latency_max_us = 0.0;
+    };
+
     /**
      * Telemetry Handler for ELRS
      * Processes incoming telemetry data from the transmitter
+     *
+     * A reader thread blocks on transport readiness, drains everything
+     * available into a byte ring and wakes the parser thread, which feeds the
+     * demuxer and runs the callbacks. Slow callbacks therefore back up into the
+     * ring instead of the kernel or USB buffers.
+     *
+     * A transport must have exactly one reader: use acquire() to share the
+     * handler between components. Callbacks are the fast path (TX sync, link
+     * stats into RadioState) and run on the parser thread; every other
+     * consumer should subscribe() and read the decoded-event broadcast at its
+     * own pace.
      */
     class TelemetryHandler
     {
@@ -44,72 +148,153 @@ namespace ELRS
         using LinkStatsCallback = std::function<void(const LinkStats &)>;
         using BatteryCallback = std::function<void(const BatteryInfo &)>;
         using SpectrumCallback = std::function<void(const std::vector<int> &)>;
+        using TimingSyncCallback = std::function<void(const TimingSync &)>;
+        using MspReplyCallback = std::function<void(const MspFrameView &)>;
 
-        TelemetryHandler(UsbBridge *usb_bridge);
+        TelemetryHandler(ITransport *transport);
         ~TelemetryHandler();
 
-        // Start/stop telemetry monitoring
-        void start();
+        TelemetryHandler(const TelemetryHandler &) = delete;
+        TelemetryHandler &operator=(const TelemetryHandler &) = delete;
+
+        // Shared handler for a transport; created on first use, released with its last owner
+        static std::shared_ptr<TelemetryHandler> acquire(ITransport *transport);
+
+        /**
+         * Start/stop telemetry monitoring, counted per owner
+         * The reader runs while at least one start() is outstanding; each owner
+         * calls stop() once for every start() that returned true.
+         * @return false if the transport is not connected (nothing to stop)
+         */
+        bool start();
         void stop();
         bool isRunning() const { return running_.load(); }
 
-        // Register callbacks
-        void setLinkStatsCallback(LinkStatsCallback callback) { link_stats_callback_ = callback; }
-        void setBatteryCallback(BatteryCallback callback) { battery_callback_ = callback; }
-        void setSpectrumCallback(SpectrumCallback callback) { spectrum_callback_ = callback; }
+        /**
+         * Per-owner fast-path callbacks
+         * Every registered callback runs, in registration order, on the parser
+         * thread. removeCallback() waits for a call in progress to return, so
+         * once it returns the owner may be destroyed; it must not be called
+         * from inside a callback.
+         */
+        using CallbackId = uint64_t;
+        CallbackId addLinkStatsCallback(LinkStatsCallback callback);
+        CallbackId addBatteryCallback(BatteryCallback callback);
+        CallbackId addSpectrumCallback(SpectrumCallback callback);
+        CallbackId addTimingSyncCallback(TimingSyncCallback callback);
+
+        // Every MSP frame from the device (after any built-in decoding), for request correlation.
+        // DEVICE_INFO arriving as a CRSF frame is forwarded as an MSP 0x29 reply.
+        CallbackId addMspReplyCallback(MspReplyCallback callback);
+
+        void removeCallback(CallbackId id);
 
         // Get latest telemetry data
         LinkStats getLatestLinkStats() const { return latest_link_stats_; }
         BatteryInfo getLatestBattery() const { return latest_battery_; }
         std::vector<int> getLatestSpectrum() const { return latest_spectrum_; }
+        TimingSync getLatestTimingSync() const { return latest_timing_sync_; }
+
+        // Decoded-event broadcast; starts at the next event published
+        TelemetrySubscription subscribe() { return TelemetrySubscription(&events_, events_.head()); }
+        uint64_t getPublishedEvents() const { return events_.head(); }
+
+        // Framing counters for the incoming stream
+        DemuxerStats getFrameStats() const { return demuxer_.getStats(); }
+
+        // Reader throughput, drops and wire-to-dispatch latency
+        TelemetryReaderStats getReaderStats() const;
+        void resetReaderStats() { wire_latency_ns_.reset(); }
+
+        // Replies to device pings (DEVICE_INFO over MSP or CRSF) and to UART speed proposals
+        uint64_t getDeviceInfoReplies() const { return device_info_replies_.load(std::memory_order_acquire); }
+        uint64_t getSpeedResponses() const { return speed_responses_.load(std::memory_order_acquire); }
+        bool wasLastSpeedAccepted() const { return last_speed_accepted_.load(std::memory_order_acquire); }
 
         std::string getLastError() const { return last_error_; }
 
     private:
-        enum class MspParserState
+        using Clock = std::chrono::steady_clock;
+
+        // Where a drained chunk ends in the ring and when the reader woke for it
+        struct ArrivalMark
         {
-            Idle,
-            ExpectM,
-            ExpectDirection,
-            ExpectLength,
-            ExpectFunction,
-            ReadPayload,
-            ExpectChecksum
+            uint64_t end = 0;
+            Clock::time_point arrival;
         };
 
-        UsbBridge *usb_bridge_;
+        ITransport *transport_;
         std::atomic<bool> running_{false};
+        std::mutex lifecycle_mutex_; // Serialises start/stop and guards users_
+        int users_ = 0;
+        std::unique_ptr<std::thread> reader_thread_;
         std::unique_ptr<std::thread> telemetry_thread_;
 
-        // Callbacks
-        LinkStatsCallback link_stats_callback_;
-        BatteryCallback battery_callback_;
-        SpectrumCallback spectrum_callback_;
+        // Reader -> parser handoff
+        SpscByteRing rx_ring_;
+        BoundedMpscQueue<ArrivalMark> arrivals_;
+        std::mutex parser_mutex_;
+        std::condition_variable parser_cv_;
+        std::atomic<bool> parser_parked_{false};
+        std::atomic<uint64_t> rx_signal_{0};
+        uint64_t rx_accepted_ = 0; // Bytes ever written to the ring (reader thread)
+        uint64_t rx_parsed_ = 0;   // Bytes ever fed to the demuxer (parser thread)
+
+        std::atomic<uint64_t> bytes_read_{0};
+        std::atomic<uint64_t> reader_wakeups_{0};
+        LatencyHistogram wire_latency_ns_;
+
+        // Callbacks, by owner
+        template <typename Callback>
+        using CallbackList = std::vector<std::pair<CallbackId, Callback>>;
+
+        std::mutex callback_mutex_; // Held while callbacks run, so removeCallback() waits them out
+        CallbackId next_callback_id_ = 1;
+        CallbackList<LinkStatsCallback> link_stats_callbacks_;
+        CallbackList<BatteryCallback> battery_callbacks_;
+        CallbackList<SpectrumCallback> spectrum_callbacks_;
+        CallbackList<TimingSyncCallback> timing_sync_callbacks_;
+        CallbackList<MspReplyCallback> msp_reply_callbacks_;
 
         // Latest data
         LinkStats latest_link_stats_;
         BatteryInfo latest_battery_;
         std::vector<int> latest_spectrum_;
+        TimingSync latest_timing_sync_;
+        std::atomic<uint64_t> device_info_replies_{0};
+        std::atomic<uint64_t> speed_responses_{0};
+        std::atomic<bool> last_speed_accepted_{false};
+
+        // Parser -> subscribers
+        BroadcastRing<TelemetryEvent> events_;
 
         std::string last_error_;
 
+        // CRSF + MSP deframing of the incoming stream
+        FrameDemuxer demuxer_;
+
         // Telemetry processing
+        void stopThreads();
+        template <typename Callback>
+        CallbackId addCallback(CallbackList<Callback> &list, Callback callback);
+        template <typename Callback, typename Value>
+        void invokeCallbacks(const CallbackList<Callback> &list, const Value &value);
+        void readerLoop();
         void telemetryLoop();
-        void feedMspByte(uint8_t byte);
-        void resetMspParser();
-        void handleMspFrame(uint8_t function, bool fromDevice, const std::vector<uint8_t> &payload);
+        void wakeParser();
+        void registerFrameHandlers();
+        void publishLinkStats(const LinkStats &stats);
+        void publishBattery(const BatteryInfo &battery);
+        void publishTimingSync(const TimingSync &sync);
+        void forwardMspReply(const MspFrameView &frame);
+        void broadcast(TelemetryEvent &event);
         bool parseLinkStats(const uint8_t *data, int length, LinkStats &stats);
         bool parseBatteryInfo(const uint8_t *data, int length, BatteryInfo &battery);
+        bool parseCrsfLinkStats(const uint8_t *data, int length, LinkStats &stats);
+        bool parseCrsfBattery(const uint8_t *data, int length, BatteryInfo &battery);
+        bool parseCrsfTimingSync(const uint8_t *data, int length, TimingSync &sync);
 
         void setError(const std::string &error);
-
-        // MSP parser state
-        MspParserState msp_state_ = MspParserState::Idle;
-        bool msp_from_device_ = false;
-        uint8_t msp_expected_length_ = 0;
-        uint8_t msp_function_ = 0;
-        uint8_t msp_checksum_ = 0;
-        std::vector<uint8_t> msp_payload_;
     };
 
 } // namespace ELRS
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ELRS
+{
+
+    /**
+     * Columns of the telemetry store
+     */
+    enum class TelemetryColumn : uint8_t
+    {
+        Rssi1,
+        Rssi2,
+        LinkQuality,
+        Snr,
+        TxPower,
+        PacketsReceived,
+        PacketsTransmitted,
+        PacketsLost,
+        Voltage, // Volts (stored as mV)
+        Current, // Amps (stored as mA)
+        Temperature,
+        Count
+    };
+
+    /**
+     * One stored telemetry sample (a row across all columns)
+     */
+    struct TelemetryRow
+    {
+        std::chrono::system_clock::time_point time;
+        int rssi1 = 0;
+        int rssi2 = 0;
+        int linkQuality = 0;
+        int snr = 0;
+        int txPower = 0;
+        uint32_t packetsReceived = 0;
+        uint32_t packetsTransmitted = 0;
+        uint32_t packetsLost = 0;
+        double voltage = 0.0;
+        double current = 0.0;
+        int temperature = 0;
+    };
+
+    /**
+     * Count / min / max / sum of one column over a time window
+     */
+    struct TelemetryAggregate
+    {
+        size_t count = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        std::chrono::system_clock::time_point first; // Time of the first and last sample counted
+        std::chrono::system_clock::time_point last;
+
+        double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    /**
+     * Append-only, time-indexed telemetry store for whole sessions
+     * Rows are kept column by column (structure of arrays) in fixed-size
+     * chunks, with a wall-clock timestamp column. The first timestamp of each
+     * chunk forms a sparse index, so finding a time is a binary search over
+     * chunks and then within one chunk: O(log n). Full chunks carry per-column
+     * min / max / sum, so aggregate() only scans the partial chunks at the
+     * window edges. The visitors hold references to the chunks they cover
+     * and iterate without the lock, so exporting hours of data does not stall
+     * append(). When max rows is exceeded the oldest chunk is dropped.
+     * Timestamps never go backwards: a sample older than the previous one
+     * (wall clock stepped back) is stored at the previous time.
+     * Thread-safe.
+     */
+    class TelemetryStore
+    {
+    public:
+        using Clock = std::chrono::system_clock;
+
+        static constexpr size_t CHUNK_ROWS = 1024;
+        static constexpr size_t DEFAULT_MAX_ROWS = size_t(1) << 20; // About 29 hours at 10 Hz
+        static constexpr size_t COLUMN_COUNT = static_cast<size_t>(TelemetryColumn::Count);
+
+        explicit TelemetryStore(size_t max_rows = DEFAULT_MAX_ROWS);
+
+        void append(const TelemetryRow &row);
+        void clear();
+
+        void setMaxRows(size_t max_rows);
+        size_t getMaxRows() const;
+
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+
+        // Time of the oldest and newest rows; false when empty
+        bool timeSpan(Clock::time_point &first, Clock::time_point &last) const;
+
+        // Rows with from <= time < to
+        size_t count(Clock::time_point from, Clock::time_point to) const;
+
+        TelemetryAggregate aggregate(TelemetryColumn column, Clock::time_point from, Clock::time_point to) const;
+
+        /**
+         * Visit one column over [from, to), oldest first
+         * @param visitor Called with (Clock::time_point, double)
+         */
+        template <typename Visitor>
+        void visitColumn(TelemetryColumn column, Clock::time_point from, Clock::time_point to, Visitor &&visitor) const
+        {
+            const size_t index = static_cast<size_t>(column);
+            const Range range = collect(from, to);
+            for (size_t c = 0; c < range.chunks.size(); ++c)
+            {
+                const Chunk &chunk = *range.chunks[c];
+                const size_t begin = (c == 0) ? range.begin_row : 0;
+                const size_t end = (c + 1 == range.chunks.size()) ? range.end_row : CHUNK_ROWS;
+                for (size_t row = begin; row < end; ++row)
+                {
+                    visitor(toTime(chunk.time[row]), decode(column, chunk.columns[index][row]));
+                }
+            }
+        }
+
+        /**
+         * Visit whole rows over [from, to), oldest first
+         * @param visitor Called with const TelemetryRow &
+         */
+        template <typename Visitor>
+        void visitRows(Clock::time_point from, Clock::time_point to, Visitor &&visitor) const
+        {
+            const Range range = collect(from, to);
+            TelemetryRow row;
+            for (size_t c = 0; c < range.chunks.size(); ++c)
+            {
+                const Chunk &chunk = *range.chunks[c];
+                const size_t begin = (c == 0) ? range.begin_row : 0;
+                const size_t end = (c + 1 == range.chunks.size()) ? range.end_row : CHUNK_ROWS;
+                for (size_t index = begin; index < end; ++index)
+                {
+                    readRow(chunk, index, row);
+                    visitor(static_cast<const TelemetryRow &>(row));
+                }
+            }
+        }
+
+    private:
+        struct ColumnSummary
+        {
+            double min = 0.0;
+            double max = 0.0;
+            double sum = 0.0;
+        };
+
+        struct Chunk
+        {
+            std::array<int64_t, CHUNK_ROWS> time; // Microseconds since the system clock epoch
+            std::array<std::array<int32_t, CHUNK_ROWS>, COLUMN_COUNT> columns;
+            std::array<ColumnSummary, COLUMN_COUNT> summary; // Set once the chunk is full
+        };
+
+        // Chunks covering a window; rows [begin_row, end_row) of first / last chunk
+        struct Range
+        {
+            std::vector<std::shared_ptr<const Chunk>> chunks;
+            size_t begin_row = 0;
+            size_t end_row = 0;
+        };
+
+        mutable std::mutex mutex_; // Guards everything below
+        std::deque<std::shared_ptr<Chunk>> chunks_;
+        std::deque<int64_t> chunk_start_; // Sparse index: first timestamp of each chunk
+        size_t tail_rows_ = 0;            // Rows used in the last chunk
+        size_t max_rows_;
+
+        size_t sizeLocked() const;
+        size_t rowsIn(size_t chunk) const { return chunk + 1 == chunks_.size() ? tail_rows_ : CHUNK_ROWS; }
+        // Global row position of the first row at or after time
+        size_t lowerBound(int64_t time) const;
+        void trimLocked();
+        Range collect(Clock::time_point from, Clock::time_point to) const;
+
+        static int64_t toMicros(Clock::time_point time);
+        static Clock::time_point toTime(int64_t micros);
+        static int32_t encode(TelemetryColumn column, double value);
+        static double decode(TelemetryColumn column, int32_t value);
+        static void readRow(const Chunk &chunk, size_t index, TelemetryRow &row);
+    };
+
+} // namespace ELRS
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "byte_span.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ELRS
+{
+
+    /**
+     * Per-transport I/O counters (snapshot)
+     */
+    struct TransportStats
+    {
+        uint64_t bytes_written = 0;
+        uint64_t bytes_read = 0;
+        uint64_t write_calls = 0;
+        uint64_t read_calls = 0;
+        uint64_t write_errors = 0;
+        uint64_t read_errors = 0;
+        uint64_t bytes_dropped = 0; // Receive-side overflow inside the transport
+    };
+
+    /**
+     * Byte transport to an ELRS module
+     * Serial (including PTYs), USB, TCP and capture-replay backends all sit behind
+     * this interface, so the transmitter, telemetry and MSP code run unchanged on
+     * whichever link the module is reached through.
+     */
+    class ITransport
+    {
+    public:
+        // One element of a gather write
+        struct IoSlice
+        {
+            const uint8_t *data;
+            size_t length;
+        };
+
+        virtual ~ITransport() = default;
+
+        // Short backend name for logs ("serial", "usb", "tcp", "replay")
+        virtual std::string getTransportName() const = 0;
+        virtual bool isConnected() const = 0;
+
+        virtual bool write(const uint8_t *data, size_t length, int timeout_ms = 1000) = 0;
+        virtual int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50) = 0;
+
+        // Gather write; the default coalesces small slices into a single write() call
+        virtual bool writev(const IoSlice *slices, size_t count, int timeout_ms = 1000);
+
+        // Span-based read
+        int read(MutableByteSpan buffer, int timeout_ms = 50)
+        {
+            return read(buffer.data(), buffer.size(), timeout_ms);
+        }
+
+        // Block until read() would return data (true) or the timeout expires (false)
+        virtual bool waitReadable(int timeout_ms) = 0;
+
+        // Line rate of a UART-backed link; 0 / false where the backend has no adjustable rate
+        virtual uint32_t getBaudRate() const { return 0; }
+        virtual bool setBaudRate(uint32_t baud_rate)
+        {
+            (void)baud_rate;
+            return false;
+        }
+
+        virtual TransportStats getStats() const;
+        virtual std::string getLastError() const = 0;
+
+    protected:
+        // Backends call these from their read/write paths
+        void recordWrite(size_t length, bool ok)
+        {
+            write_calls_.fetch_add(1, std::memory_order_relaxed);
+            if (ok)
+            {
+                bytes_written_.fetch_add(length, std::memory_order_relaxed);
+            }
+            else
+            {
+                write_errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void recordRead(int result)
+        {
+            read_calls_.fetch_add(1, std::memory_order_relaxed);
+            if (result > 0)
+            {
+                bytes_read_.fetch_add(static_cast<uint64_t>(result), std::memory_order_relaxed);
+            }
+            else if (result < 0)
+            {
+                read_errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void recordDropped(uint64_t bytes) { bytes_dropped_.fetch_add(bytes, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> bytes_written_{0};
+        std::atomic<uint64_t> bytes_read_{0};
+        std::atomic<uint64_t> write_calls_{0};
+        std::atomic<uint64_t> read_calls_{0};
+        std::atomic<uint64_t> write_errors_{0};
+        std::atomic<uint64_t> read_errors_{0};
+        std::atomic<uint64_t> bytes_dropped_{0};
+    };
+
+} // namespace ELRS
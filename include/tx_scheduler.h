@@ -0,0 +1,117 @@
+#pragma once
+
+#include "latency_histogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ELRS
+{
+
+    /**
+     * TX timing counters (snapshot)
+     * Jitter figures are send-time lateness against the ideal deadline, in microseconds.
+     */
+    struct TxTimingStats
+    {
+        int rate_hz = 0;
+        uint64_t frames = 0;
+        uint64_t missed_deadlines = 0; // Whole periods skipped because the loop overran
+        double jitter_mean_us = 0.0;
+        double jitter_p50_us = 0.0;
+        double jitter_p99_us = 0.0;
+        double jitter_p999_us = 0.0;
+        double jitter_max_us = 0.0;
+
+        // Module timing sync (CRSF RADIO_ID)
+        bool synced = false;           // Period/phase currently follow the module
+        double sync_interval_us = 0.0; // Last interval reported by the module
+        double sync_offset_us = 0.0;   // Last phase offset reported (positive = early)
+        double period_trim_ns = 0.0;   // Drift correction applied on top of the module interval
+        uint64_t sync_updates = 0;
+    };
+
+    /**
+     * Absolute-deadline packet scheduler for the RC loop
+     * Deadlines advance by exactly one period from the previous deadline, not from
+     * when the loop woke up, so sleep overshoot never accumulates into rate drift.
+     * On Linux the wait is clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME); an
+     * optional spin tail wakes early and busy-waits the last few microseconds
+     * for tighter edges at the cost of some CPU.
+     *
+     * When the module reports its timing (CRSF RADIO_ID), the period follows
+     * the module's packet interval and each report nudges the deadline grid so
+     * frames land just ahead of the module's air-packet slot. Reports older
+     * than SYNC_STALE fall back to the free-running nominal rate.
+     *
+     * waitNextDeadline()/recordSend() belong to the TX thread; setRate() and the
+     * statistics accessors may be called from any thread.
+     */
+    class TxScheduler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr int SUPPORTED_RATES[] = {50, 150, 250, 500, 1000};
+        static bool isSupportedRate(int rate_hz);
+
+        explicit TxScheduler(int rate_hz = 250);
+
+        // Takes effect from the next period; returns false for unsupported rates
+        bool setRate(int rate_hz);
+        int getRate() const { return requested_rate_.load(std::memory_order_relaxed); }
+
+        // Feed a module timing report (any thread)
+        void applyTimingSync(Clock::duration interval, Clock::duration offset);
+        bool isSynced() const;
+
+        static constexpr std::chrono::milliseconds SYNC_STALE{250};
+
+        // Busy-wait this long before each deadline (0 disables)
+        void setSpinTail(std::chrono::microseconds spin_tail) { spin_tail_ns_.store(spin_tail.count() * 1000, std::memory_order_relaxed); }
+
+        // Anchor the deadline grid at now (call before the first wait and after stalls)
+        void start();
+
+        // Block until the next deadline; overrun periods are skipped and counted as missed
+        Clock::time_point waitNextDeadline();
+
+        // Record how late the frame for the current deadline actually went out
+        void recordSend();
+
+        TxTimingStats getStats() const;
+        const LatencyHistogram &getJitterHistogram() const { return jitter_ns_; }
+        void resetStats();
+
+    private:
+        std::atomic<int> requested_rate_;
+        std::atomic<int64_t> spin_tail_ns_{0};
+
+        // Latest module timing report; sync_phase_ns_ is consumed once by the TX thread
+        std::atomic<int64_t> sync_interval_ns_{0};
+        std::atomic<int64_t> sync_offset_ns_{0};
+        std::atomic<int64_t> sync_phase_ns_{0};
+        std::atomic<int64_t> sync_time_ns_{0};
+        std::atomic<uint64_t> sync_updates_{0};
+        std::atomic<int64_t> applied_trim_ns_{0};
+
+        // TX thread only
+        int active_rate_ = 0;
+        Clock::duration period_{};
+        Clock::time_point deadline_{};
+        bool synced_ = false;
+        int64_t period_trim_ns_ = 0;     // Integral correction for host/module clock drift
+        uint64_t periods_since_sync_ = 0; // Periods elapsed since the last applied report
+
+        std::atomic<uint64_t> frames_{0};
+        std::atomic<uint64_t> missed_deadlines_{0};
+        LatencyHistogram jitter_ns_;
+
+        void applyRate();
+        void updateTiming(Clock::time_point now);
+        bool syncFresh(Clock::time_point now) const;
+        void sleepUntil(Clock::time_point wake);
+    };
+
+} // namespace ELRS
@@ -4,6 +4,8 @@
 #include <string>
 #include <memory>
 
+#include "transport.h"
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -40,8 +42,13 @@ namespace ELRS
 
     /**
      * USB Bridge for communicating with ELRS transmitter with runtime driver loading
+     *
+     * When linked against libusb the bridge claims the CDC data interface (or the
+     * bulk interface of a CP210x, set up with its vendor requests) and keeps
+     * a ring of bulk transfers permanently queued on both endpoints; an event thread
+     * completes them and inbound bytes land in a lock-free ring that read() drains.
      */
-    class UsbBridge
+    class UsbBridge : public ITransport
     {
     public:
         struct DeviceInfo
@@ -67,19 +74,26 @@ namespace ELRS
         std::vector<DeviceInfo> scanDevices();                      // Alias for findElrsDevices
         bool connect(uint16_t vid = 0x0483, uint16_t pid = 0x5740); // Default STM32 VID/PID
         void disconnect();
-        bool isConnected() const { return device_handle_ != nullptr; }
+        bool isConnected() const override { return device_handle_ != nullptr; }
 
         // Data transmission
-        bool write(const uint8_t *data, size_t length, int timeout_ms = 1000);
-        int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50);
+        std::string getTransportName() const override { return "usb"; }
+        bool write(const uint8_t *data, size_t length, int timeout_ms = 1000) override;
+        int read(uint8_t *buffer, size_t buffer_size, int timeout_ms = 50) override;
+        using ITransport::read;
+        bool waitReadable(int timeout_ms) override;
+        TransportStats getStats() const override;
 
         // Device info
         DeviceInfo getConnectedDeviceInfo() const;
-        std::string getLastError() const { return last_error_; }
+        std::string getLastError() const override { return last_error_; }
 
     private:
+        struct AsyncEngine; // libusb transfer ring + event thread, defined in usb_bridge.cpp
+
         libusb_context *context_;
         libusb_device_handle *device_handle_;
+        std::unique_ptr<AsyncEngine> engine_;
         DeviceInfo connected_device_;
         std::string last_error_;
         bool usb_support_available_;
@@ -88,6 +102,8 @@ namespace ELRS
         static constexpr uint8_t ENDPOINT_OUT = 0x01;
         static constexpr uint8_t ENDPOINT_IN = 0x81;
 
+        bool writeBytes(const uint8_t *data, size_t length, int timeout_ms);
+        int readBytes(uint8_t *buffer, size_t buffer_size, int timeout_ms);
         void setError(const std::string &error);
         std::string getUsbErrorString(int error_code);
 
@@ -96,6 +112,10 @@ namespace ELRS
         bool detectUsbDevices();
         bool scanRealUsbDevices(std::vector<DeviceInfo> &devices);
         bool shouldShowSimulatedDevices() const;
+
+        // Real device access (libusb builds only)
+        bool openDevice(uint16_t vid, uint16_t pid);
+        void closeDevice();
     };
 
 } // namespace ELRS
\ No newline at end of file
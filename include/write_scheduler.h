@@ -0,0 +1,161 @@
+#pragma once
+
+#include "latency_histogram.h"
+#include "mpsc_queue.h"
+#include "transport.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ELRS
+{
+
+    /**
+     * Outgoing traffic classes, highest priority first
+     */
+    enum class WriteClass : uint8_t
+    {
+        Rc = 0,            // RC channel frames from the TX loop
+        Control = 1,       // User-initiated commands (bind, power, model, config)
+        TelemetryPoll = 2, // Periodic link-stats / spectrum requests
+        Bulk = 3           // Large transfers that can always wait
+    };
+
+    /**
+     * Per-class write counters (snapshot)
+     * Queue delay is submit() to the start of the transport write, in microseconds.
+     */
+    struct WriteClassStats
+    {
+        uint64_t submitted = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0; // Queue full or frame too large
+        uint64_t write_errors = 0;
+        uint64_t bytes = 0;
+        double budget_bytes_per_s = 0.0;
+        double delay_mean_us = 0.0;
+        double delay_p50_us = 0.0;
+        double delay_p99_us = 0.0;
+        double delay_max_us = 0.0;
+    };
+
+    /**
+     * Single writer for a shared transport
+     * RC frames, MSP commands and telemetry polls are submitted from their own
+     * threads into one bounded lock-free queue per class; a single writer
+     * thread drains them in strict priority order, so a frame from a lower
+     * class is only started when every higher class is empty.
+     *
+     * Bandwidth is budgeted with token buckets derived from the configured baud
+     * (8N1: baud / 10 bytes/s). A link-wide bucket keeps the total below the
+     * wire rate and each non-RC class is capped at a share of it; RC frames are
+     * never held back by a budget, they only consume it, so MSP traffic backs
+     * off when the RC rate goes up. A frame that has started cannot be
+     * preempted; large transfers belong in Bulk.
+     */
+    class WriteScheduler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t CLASS_COUNT = 4;
+        static constexpr size_t MAX_WRITE_SIZE = 512;
+
+        explicit WriteScheduler(ITransport *transport, uint32_t baud_rate = 420000);
+        ~WriteScheduler();
+
+        WriteScheduler(const WriteScheduler &) = delete;
+        WriteScheduler &operator=(const WriteScheduler &) = delete;
+
+        void start();
+        void stop();
+        bool isRunning() const { return running_.load(); }
+
+        // Non-blocking; false if the class queue is full, the frame is too large or the writer is stopped
+        bool submit(WriteClass write_class, const uint8_t *data, size_t length);
+
+        // Queue every frame or none, back to back in one class (e.g. the chunks of one message)
+        bool submitAll(WriteClass write_class, const ITransport::IoSlice *frames, size_t count);
+
+        // Most frames a class can hold at once
+        size_t queueCapacity(WriteClass write_class) const;
+
+        // Recompute budgets for a new line rate (e.g. after baud negotiation)
+        void setBaudRate(uint32_t baud_rate);
+        uint32_t getBaudRate() const { return baud_rate_.load(std::memory_order_relaxed); }
+
+        // Fraction (0-1] of the link budget a non-RC class may use
+        void setClassShare(WriteClass write_class, double share);
+
+        WriteClassStats getClassStats(WriteClass write_class) const;
+        static const char *className(WriteClass write_class);
+        void resetStats();
+
+        std::string getLastError() const { return last_error_; }
+
+    private:
+        struct WriteRequest
+        {
+            uint16_t length = 0;
+            Clock::time_point submitted;
+            std::array<uint8_t, MAX_WRITE_SIZE> data;
+        };
+
+        struct TokenBucket
+        {
+            double rate = 0.0;  // Bytes per second
+            double burst = 0.0; // Bucket size
+            double tokens = 0.0;
+            Clock::time_point refilled;
+
+            void refill(Clock::time_point now);
+            Clock::duration timeUntil(double bytes) const;
+        };
+
+        struct ClassState
+        {
+            std::unique_ptr<BoundedMpscQueue<WriteRequest>> queue;
+            std::atomic<double> share{1.0};
+            std::atomic<uint64_t> submitted{0};
+            std::atomic<uint64_t> written{0};
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<uint64_t> write_errors{0};
+            std::atomic<uint64_t> bytes{0};
+            LatencyHistogram delay_ns;
+        };
+
+        ITransport *transport_;
+        std::atomic<uint32_t> baud_rate_;
+        std::atomic<bool> budgets_dirty_{true};
+        std::array<ClassState, CLASS_COUNT> classes_;
+
+        std::atomic<bool> running_{false};
+        std::unique_ptr<std::thread> writer_thread_;
+
+        // Writer wake-up: producers only take the mutex when the writer is parked
+        std::mutex wake_mutex_;
+        std::condition_variable wake_cv_;
+        std::atomic<bool> writer_parked_{false};
+        std::atomic<uint64_t> submit_count_{0};
+
+        // Writer thread only
+        TokenBucket link_bucket_;
+        std::array<TokenBucket, CLASS_COUNT> class_buckets_;
+
+        std::string last_error_;
+
+        void writerLoop();
+        void applyBudgets(Clock::time_point now);
+        void wakeWriter();
+        void setError(const std::string &error);
+    };
+
+} // namespace ELRS
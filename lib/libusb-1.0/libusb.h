@@ -16,9 +16,15 @@ extern "C"
 
 #include <stdint.h>
 #ifdef _WIN32
+#include <windows.h> /* struct timeval */
     typedef intptr_t ssize_t;
 #else
 #include <sys/types.h>
+#include <sys/time.h>
+#endif
+
+#ifndef LIBUSB_CALL
+#define LIBUSB_CALL
 #endif
 
 /* libusb version information */
@@ -50,6 +56,136 @@ extern "C"
         uint8_t bNumConfigurations;
     };
 
+    /* Configuration descriptor tree (layout matches libusb-1.0) */
+    struct libusb_endpoint_descriptor
+    {
+        uint8_t bLength;
+        uint8_t bDescriptorType;
+        uint8_t bEndpointAddress;
+        uint8_t bmAttributes;
+        uint16_t wMaxPacketSize;
+        uint8_t bInterval;
+        uint8_t bRefresh;
+        uint8_t bSynchAddress;
+        const unsigned char *extra;
+        int extra_length;
+    };
+
+    struct libusb_interface_descriptor
+    {
+        uint8_t bLength;
+        uint8_t bDescriptorType;
+        uint8_t bInterfaceNumber;
+        uint8_t bAlternateSetting;
+        uint8_t bNumEndpoints;
+        uint8_t bInterfaceClass;
+        uint8_t bInterfaceSubClass;
+        uint8_t bInterfaceProtocol;
+        uint8_t iInterface;
+        const struct libusb_endpoint_descriptor *endpoint;
+        const unsigned char *extra;
+        int extra_length;
+    };
+
+    struct libusb_interface
+    {
+        const struct libusb_interface_descriptor *altsetting;
+        int num_altsetting;
+    };
+
+    struct libusb_config_descriptor
+    {
+        uint8_t bLength;
+        uint8_t bDescriptorType;
+        uint16_t wTotalLength;
+        uint8_t bNumInterfaces;
+        uint8_t bConfigurationValue;
+        uint8_t iConfiguration;
+        uint8_t bmAttributes;
+        uint8_t MaxPower;
+        const struct libusb_interface *interface;
+        const unsigned char *extra;
+        int extra_length;
+    };
+
+    /* Descriptor field values */
+    enum libusb_class_code
+    {
+        LIBUSB_CLASS_COMM = 0x02,
+        LIBUSB_CLASS_DATA = 0x0a,
+        LIBUSB_CLASS_VENDOR_SPEC = 0xff
+    };
+
+    enum libusb_endpoint_direction
+    {
+        LIBUSB_ENDPOINT_OUT = 0x00,
+        LIBUSB_ENDPOINT_IN = 0x80
+    };
+
+#define LIBUSB_ENDPOINT_DIR_MASK 0x80
+#define LIBUSB_TRANSFER_TYPE_MASK 0x03
+
+    enum libusb_transfer_type
+    {
+        LIBUSB_TRANSFER_TYPE_CONTROL = 0,
+        LIBUSB_TRANSFER_TYPE_ISOCHRONOUS = 1,
+        LIBUSB_TRANSFER_TYPE_BULK = 2,
+        LIBUSB_TRANSFER_TYPE_INTERRUPT = 3
+    };
+
+    enum libusb_request_type
+    {
+        LIBUSB_REQUEST_TYPE_STANDARD = (0x00 << 5),
+        LIBUSB_REQUEST_TYPE_CLASS = (0x01 << 5),
+        LIBUSB_REQUEST_TYPE_VENDOR = (0x02 << 5)
+    };
+
+    enum libusb_request_recipient
+    {
+        LIBUSB_RECIPIENT_DEVICE = 0x00,
+        LIBUSB_RECIPIENT_INTERFACE = 0x01,
+        LIBUSB_RECIPIENT_ENDPOINT = 0x02
+    };
+
+    /* Asynchronous transfers */
+    enum libusb_transfer_status
+    {
+        LIBUSB_TRANSFER_COMPLETED,
+        LIBUSB_TRANSFER_ERROR,
+        LIBUSB_TRANSFER_TIMED_OUT,
+        LIBUSB_TRANSFER_CANCELLED,
+        LIBUSB_TRANSFER_STALL,
+        LIBUSB_TRANSFER_NO_DEVICE,
+        LIBUSB_TRANSFER_OVERFLOW
+    };
+
+    struct libusb_iso_packet_descriptor
+    {
+        unsigned int length;
+        unsigned int actual_length;
+        enum libusb_transfer_status status;
+    };
+
+    struct libusb_transfer;
+    typedef void(LIBUSB_CALL *libusb_transfer_cb_fn)(struct libusb_transfer *transfer);
+
+    struct libusb_transfer
+    {
+        libusb_device_handle *dev_handle;
+        uint8_t flags;
+        unsigned char endpoint;
+        unsigned char type;
+        unsigned int timeout;
+        enum libusb_transfer_status status;
+        int length;
+        int actual_length;
+        libusb_transfer_cb_fn callback;
+        void *user_data;
+        unsigned char *buffer;
+        int num_iso_packets;
+        struct libusb_iso_packet_descriptor iso_packet_desc[1];
+    };
+
     /* Error codes */
     enum libusb_error
     {
@@ -90,8 +226,39 @@ extern "C"
     int libusb_kernel_driver_active(libusb_device_handle *handle, int interface_number);
     int libusb_detach_kernel_driver(libusb_device_handle *handle, int interface_number);
 
+    int libusb_set_auto_detach_kernel_driver(libusb_device_handle *handle, int enable);
+    int libusb_attach_kernel_driver(libusb_device_handle *handle, int interface_number);
+
+    int libusb_get_active_config_descriptor(libusb_device *device, struct libusb_config_descriptor **config);
+    void libusb_free_config_descriptor(struct libusb_config_descriptor *config);
+
     int libusb_bulk_transfer(libusb_device_handle *handle, unsigned char endpoint,
                              unsigned char *data, int length, int *actual_length, unsigned int timeout);
+    int libusb_control_transfer(libusb_device_handle *handle, uint8_t request_type, uint8_t bRequest,
+                                uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength,
+                                unsigned int timeout);
+
+    struct libusb_transfer *libusb_alloc_transfer(int iso_packets);
+    void libusb_free_transfer(struct libusb_transfer *transfer);
+    int libusb_submit_transfer(struct libusb_transfer *transfer);
+    int libusb_cancel_transfer(struct libusb_transfer *transfer);
+    int libusb_handle_events_timeout_completed(libusb_context *context, struct timeval *tv, int *completed);
+
+    static inline void libusb_fill_bulk_transfer(struct libusb_transfer *transfer,
+                                                 libusb_device_handle *dev_handle, unsigned char endpoint,
+                                                 unsigned char *buffer, int length,
+                                                 libusb_transfer_cb_fn callback, void *user_data,
+                                                 unsigned int timeout)
+    {
+        transfer->dev_handle = dev_handle;
+        transfer->endpoint = endpoint;
+        transfer->type = LIBUSB_TRANSFER_TYPE_BULK;
+        transfer->timeout = timeout;
+        transfer->buffer = buffer;
+        transfer->length = length;
+        transfer->user_data = user_data;
+        transfer->callback = callback;
+    }
 
     int libusb_get_string_descriptor_ascii(libusb_device_handle *handle, uint8_t desc_index,
                                            unsigned char *data, int length);
@@ -78,6 +78,27 @@ int libusb_detach_kernel_driver(libusb_device_handle *handle, int interface_numb
     return LIBUSB_ERROR_NOT_SUPPORTED;
 }
 
+int libusb_set_auto_detach_kernel_driver(libusb_device_handle *handle, int enable)
+{
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int libusb_attach_kernel_driver(libusb_device_handle *handle, int interface_number)
+{
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int libusb_get_active_config_descriptor(libusb_device *device, struct libusb_config_descriptor **config)
+{
+    *config = nullptr;
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+void libusb_free_config_descriptor(struct libusb_config_descriptor *config)
+{
+    // No-op
+}
+
 int libusb_bulk_transfer(libusb_device_handle *handle, unsigned char endpoint,
                          unsigned char *data, int length, int *actual_length, unsigned int timeout)
 {
@@ -85,6 +106,39 @@ int libusb_bulk_transfer(libusb_device_handle *handle, unsigned char endpoint,
     return LIBUSB_ERROR_NOT_SUPPORTED;
 }
 
+int libusb_control_transfer(libusb_device_handle *handle, uint8_t request_type, uint8_t bRequest,
+                            uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength,
+                            unsigned int timeout)
+{
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+struct libusb_transfer *libusb_alloc_transfer(int iso_packets)
+{
+    return nullptr;
+}
+
+void libusb_free_transfer(struct libusb_transfer *transfer)
+{
+    // No-op
+}
+
+int libusb_submit_transfer(struct libusb_transfer *transfer)
+{
+    std::cerr << "[LIBUSB_STUB] Real libusb-1.0 library required for asynchronous transfers" << std::endl;
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int libusb_cancel_transfer(struct libusb_transfer *transfer)
+{
+    return LIBUSB_ERROR_NOT_FOUND;
+}
+
+int libusb_handle_events_timeout_completed(libusb_context *context, struct timeval *tv, int *completed)
+{
+    return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
 int libusb_get_string_descriptor_ascii(libusb_device_handle *handle, uint8_t desc_index,
                                        unsigned char *data, int length)
 {
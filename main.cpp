@@ -149,54 +149,73 @@ public:
                                     {
             LOG_INFO("TELEMETRY", "Starting telemetry monitoring thread");
             
-            // Initialize telemetry handler for real data
-            ELRS::TelemetryHandler telemetryHandler(&usb_bridge_);
+            // Share the link's single telemetry reader instead of opening a second one on the port
+            auto telemetryHandler = ELRS::TelemetryHandler::acquire(&usb_bridge_);
+            ELRS::TelemetrySubscription telemetry = telemetryHandler->subscribe();
             
-            // Set up callbacks for real telemetry data
-            telemetryHandler.setLinkStatsCallback([&radioState](const ELRS::LinkStats& stats) {
-                if (stats.valid) {
-                    LOG_DEBUG("TELEMETRY", "Received link stats: RSSI=" + std::to_string(stats.rssi1) + 
-                             "dBm, Link Quality=" + std::to_string(stats.link_quality) + "%");
-                    radioState.updateRSSI(stats.rssi1, stats.rssi2);
-                    radioState.updateLinkQuality(stats.link_quality);
-                    radioState.updateTxPower(stats.tx_power);
-                }
-            });
-            
-            telemetryHandler.setBatteryCallback([&radioState](const ELRS::BatteryInfo& battery) {
-                if (battery.valid) {
-                    radioState.updateBattery(battery.voltage_mv / 1000.0, battery.current_ma / 1000.0);
-                }
-            });
-            
-            // Start telemetry monitoring
-            telemetryHandler.start();
+            // Start telemetry monitoring (counted; the reader keeps running while any owner holds it)
+            bool telemetryStarted = telemetryHandler->start();
             
             // Simulate periodic packet counting and additional telemetry
             uint32_t totalRxPackets = 0;
             uint32_t totalTxPackets = 0;
+            ELRS::LinkStats linkStats;
+            uint64_t reportedLost = 0;
+            auto nextUpdate = std::chrono::steady_clock::now();
             
             while (radioState.getConnectionStatus() == ELRS::ConnectionStatus::Connected)
             {
-                // Get real telemetry data
-                auto linkStats = telemetryHandler.getLatestLinkStats();
-                auto batteryInfo = telemetryHandler.getLatestBattery();
+                // Apply every event broadcast since the last pass; a stall here only loses our own backlog
+                ELRS::TelemetryEvent event;
+                while (telemetry.wait(event, std::chrono::milliseconds(200)))
+                {
+                    if (event.type == ELRS::TelemetryEventType::LinkStats && event.link_stats.valid) {
+                        linkStats = event.link_stats;
+                        LOG_DEBUG("TELEMETRY", "Received link stats: RSSI=" + std::to_string(linkStats.rssi1) + 
+                                 "dBm, Link Quality=" + std::to_string(linkStats.link_quality) + "%");
+                        radioState.beginUpdate()
+                            .rssi(linkStats.rssi1, linkStats.rssi2)
+                            .linkQuality(linkStats.link_quality)
+                            .snr(linkStats.snr)
+                            .txPower(linkStats.tx_power)
+                            .commit();
+                    } else if (event.type == ELRS::TelemetryEventType::Battery && event.battery.valid) {
+                        radioState.updateBattery(event.battery.voltage_mv / 1000.0, event.battery.current_ma / 1000.0);
+                    }
+                    
+                    if (std::chrono::steady_clock::now() >= nextUpdate) {
+                        break;
+                    }
+                }
+                
+                if (std::chrono::steady_clock::now() < nextUpdate) {
+                    continue;
+                }
+                nextUpdate = std::chrono::steady_clock::now() + std::chrono::milliseconds(200); // 5 Hz update rate
+                
+                if (telemetry.getLost() != reportedLost) {
+                    reportedLost = telemetry.getLost();
+                    LOG_WARNING("TELEMETRY", "Monitor fell behind; skipped " + std::to_string(reportedLost) + " events so far");
+                }
                 
                 if (linkStats.valid) {
                     // Update packet counters (simulate based on link activity)
                     totalRxPackets += (linkStats.link_quality > 0) ? 1 : 0;
                     totalTxPackets += 1;
                     
-                    radioState.updatePacketStats(totalRxPackets, totalTxPackets);
-                    
-                    // Update temperature (simulate)
-                    radioState.updateTemperature(25 + (linkStats.tx_power / 2)); // Rough estimate
+                    // Temperature is simulated: rough estimate from TX power
+                    radioState.beginUpdate()
+                        .packetStats(totalRxPackets, totalTxPackets)
+                        .temperature(25 + (linkStats.tx_power / 2))
+                        .commit();
                 }
-                
-                std::this_thread::sleep_for(std::chrono::milliseconds(200)); // 5 Hz update rate
             }
             
-            telemetryHandler.stop(); });
+            // Drop our hold on the reader, then our reference to the handler
+            if (telemetryStarted) {
+                telemetryHandler->stop();
+            }
+            telemetryHandler.reset(); });
 
         // Run the FTXUI manager
         ftxuiManager.run();
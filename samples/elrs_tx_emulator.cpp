@@ -0,0 +1,198 @@
+// elrs_tx_emulator.cpp
+//
+// POSIX, C++17. Runs ElrsEmulator as a standalone process: opens a
+// pseudo-terminal, prints its path and behaves like an ELRS TX module on the
+// other end until interrupted (or until --duration elapses).
+//
+// Usage:
+//   elrs_tx_emulator [--link-hz N] [--battery-hz N] [--spectrum-hz N]
+//                    [--rate-multiplier N] [--error-ratio R] [--noise-ratio R]
+//                    [--sync-hz N] [--packet-rate N] [--drift-ppm N]
+//                    [--max-baud N] [--stable-baud N]
+//                    [--bins N] [--msp-version 1|2] [--msp-framing crsf|raw]
+//                    [--seed N] [--duration S]
+//
+// Then point the application (or a test) at the printed /dev/pts/N path.
+
+#include "elrs_emulator.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    std::atomic<bool> g_stop{false};
+
+    void onSignal(int)
+    {
+        g_stop.store(true);
+    }
+
+    void showHelp()
+    {
+        std::cout << "ELRS TX Emulator - Command Line Options" << std::endl;
+        std::cout << "=======================================" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Usage: elrs_tx_emulator [options]" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  --link-hz N           LINK_STATISTICS rate (default 10)" << std::endl;
+        std::cout << "  --battery-hz N        Battery sensor rate (default 1)" << std::endl;
+        std::cout << "  --spectrum-hz N       Spectrum bin push rate, 0 disables (default 2)" << std::endl;
+        std::cout << "  --rate-multiplier N   Scale every rate, e.g. 100 for load tests" << std::endl;
+        std::cout << "  --error-ratio R       Fraction of frames sent with a bad CRC (0-1)" << std::endl;
+        std::cout << "  --noise-ratio R       Fraction of frames preceded by line noise (0-1)" << std::endl;
+        std::cout << "  --sync-hz N           RADIO_ID timing sync rate, 0 disables (default 5)" << std::endl;
+        std::cout << "  --packet-rate N       Simulated air packet rate in Hz (default 250)" << std::endl;
+        std::cout << "  --drift-ppm N         Module clock error against the host (default 0)" << std::endl;
+        std::cout << "  --max-baud N          Highest accepted speed proposal, 0 ignores them (default 5250000)" << std::endl;
+        std::cout << "  --stable-baud N       Corrupt 20% of frames above this rate (default 0 = all stable)" << std::endl;
+        std::cout << "  --bins N              Spectrum bins per push (default 32)" << std::endl;
+        std::cout << "  --msp-version N       MSP framing of spectrum pushes: 1 ($M, jumbo past 245 bins) or 2 ($X)" << std::endl;
+        std::cout << "  --msp-framing F       Spectrum pushes as crsf (MSP_RESP chunks, default) or raw ($ frames)" << std::endl;
+        std::cout << "  --seed N              Random seed for jitter and error injection" << std::endl;
+        std::cout << "  --duration S          Exit after S seconds and print counters" << std::endl;
+        std::cout << "  --help, -h            Show this help message" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ELRS::EmulatorConfig config;
+    double duration_s = 0.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            showHelp();
+            return 0;
+        }
+        else if (!has_value)
+        {
+            std::cout << "Missing value for " << arg << std::endl;
+            showHelp();
+            return 1;
+        }
+        else if (arg == "--link-hz")
+        {
+            config.link_stats_hz = std::atof(argv[++i]);
+        }
+        else if (arg == "--battery-hz")
+        {
+            config.battery_hz = std::atof(argv[++i]);
+        }
+        else if (arg == "--spectrum-hz")
+        {
+            config.spectrum_hz = std::atof(argv[++i]);
+        }
+        else if (arg == "--rate-multiplier")
+        {
+            config.rate_multiplier = std::atof(argv[++i]);
+        }
+        else if (arg == "--error-ratio")
+        {
+            config.error_ratio = std::atof(argv[++i]);
+        }
+        else if (arg == "--noise-ratio")
+        {
+            config.noise_ratio = std::atof(argv[++i]);
+        }
+        else if (arg == "--sync-hz")
+        {
+            config.sync_hz = std::atof(argv[++i]);
+        }
+        else if (arg == "--packet-rate")
+        {
+            config.packet_rate_hz = std::atof(argv[++i]);
+        }
+        else if (arg == "--drift-ppm")
+        {
+            config.clock_drift_ppm = std::atof(argv[++i]);
+        }
+        else if (arg == "--max-baud")
+        {
+            config.max_baud_rate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        }
+        else if (arg == "--stable-baud")
+        {
+            config.max_stable_baud_rate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        }
+        else if (arg == "--bins")
+        {
+            config.spectrum_bins = std::atoi(argv[++i]);
+        }
+        else if (arg == "--msp-version")
+        {
+            config.msp_version = std::atoi(argv[++i]) == 2 ? ELRS::MspVersion::V2 : ELRS::MspVersion::V1;
+        }
+        else if (arg == "--msp-framing")
+        {
+            config.msp_encapsulation = std::string(argv[++i]) == "raw" ? ELRS::MspEncapsulation::Raw
+                                                                      : ELRS::MspEncapsulation::Crsf;
+        }
+        else if (arg == "--seed")
+        {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        }
+        else if (arg == "--duration")
+        {
+            duration_s = std::atof(argv[++i]);
+        }
+        else
+        {
+            std::cout << "Unknown argument: " << arg << std::endl;
+            showHelp();
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    ELRS::ElrsEmulator emulator(config);
+    if (!emulator.start())
+    {
+        return 1;
+    }
+
+    // Machine-readable line for scripts: the device path on its own
+    std::cout << emulator.getDevicePath() << std::endl;
+
+    auto started = std::chrono::steady_clock::now();
+    while (!g_stop.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (duration_s > 0.0 &&
+            std::chrono::steady_clock::now() - started >= std::chrono::duration<double>(duration_s))
+        {
+            break;
+        }
+    }
+
+    ELRS::EmulatorStats stats = emulator.getStats();
+    emulator.stop();
+
+    std::cout << "[EMULATOR] rc_frames=" << stats.rc_frames
+              << " rc_subset_frames=" << stats.rc_subset_frames
+              << " crc_errors=" << stats.crc_errors
+              << " msp_requests=" << stats.msp_requests
+              << " msp_tunnelled=" << stats.msp_tunnelled
+              << " frames_sent=" << stats.frames_sent
+              << " frames_corrupted=" << stats.frames_corrupted
+              << " bytes_sent=" << stats.bytes_sent
+              << " bytes_dropped=" << stats.bytes_dropped
+              << " sync_frames=" << stats.sync_frames
+              << " rc_lead_us=" << stats.rc_lead_us
+              << " baud_rate=" << stats.baud_rate
+              << " speed_changes=" << stats.speed_changes << std::endl;
+    return 0;
+}
@@ -0,0 +1,506 @@
+#include "baud_negotiator.h"
+#include "crsf_protocol.h"
+#include "msp_commands.h"
+#include "radio_state.h"
+#include "telemetry_handler.h"
+#include "transport.h"
+#include "write_scheduler.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace ELRS
+{
+
+    namespace
+    {
+        // Time the module gets to reprogram its UART after accepting a proposal
+        constexpr auto SETTLE_TIME = std::chrono::milliseconds(20);
+
+        // Supervisor polling period for error bursts and verification deadlines
+        constexpr auto SUPERVISOR_TICK = std::chrono::milliseconds(100);
+
+        // Pings per rate while scanning for a module that was lost
+        constexpr int RESYNC_PINGS = 3;
+
+        constexpr int PROPOSAL_ATTEMPTS = 2;
+
+        std::string formatPercent(double ratio)
+        {
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(2) << ratio * 100.0 << "%";
+            return ss.str();
+        }
+    }
+
+    BaudNegotiator::BaudNegotiator(ITransport *transport, TelemetryHandler *telemetry, MspCommands *msp,
+                                   WriteScheduler *write_scheduler)
+        : transport_(transport), telemetry_(telemetry), msp_(msp), write_scheduler_(write_scheduler)
+    {
+    }
+
+    BaudNegotiator::~BaudNegotiator()
+    {
+        stop();
+    }
+
+    void BaudNegotiator::setConfig(const BaudNegotiatorConfig &config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+    }
+
+    BaudNegotiatorConfig BaudNegotiator::getConfig() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return config_;
+    }
+
+    bool BaudNegotiator::start()
+    {
+        if (running_.load())
+        {
+            return true; // Already running
+        }
+
+        if (!transport_ || !telemetry_ || !msp_)
+        {
+            setError("Negotiation needs a transport, telemetry handler and MSP commands");
+            return false;
+        }
+
+        uint32_t baud_rate = transport_->getBaudRate();
+        if (baud_rate == 0)
+        {
+            setError("The " + transport_->getTransportName() + " link has no adjustable line rate");
+            return false;
+        }
+
+        if (!telemetry_->isRunning())
+        {
+            setError("Telemetry handler not running - replies cannot be observed");
+            return false;
+        }
+
+        baud_rate_.store(baud_rate);
+        running_.store(true);
+        thread_ = std::make_unique<std::thread>(&BaudNegotiator::supervisorLoop, this);
+
+        std::cout << "[BAUD] Negotiating line rate from " << baud_rate << " baud (up to "
+                  << getConfig().max_baud_rate << ")" << std::endl;
+        return true;
+    }
+
+    void BaudNegotiator::stop()
+    {
+        if (!running_.load())
+        {
+            return; // Already stopped
+        }
+
+        running_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_cv_.notify_all();
+        }
+
+        if (thread_ && thread_->joinable())
+        {
+            thread_->join();
+        }
+        thread_.reset();
+
+        std::cout << "[BAUD] Negotiator stopped at " << baud_rate_.load() << " baud" << std::endl;
+    }
+
+    void BaudNegotiator::requestRenegotiation()
+    {
+        renegotiate_.store(true);
+    }
+
+    BaudNegotiatorStats BaudNegotiator::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    std::vector<BaudProbeResult> BaudNegotiator::getProbeResults() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return probe_results_;
+    }
+
+    std::string BaudNegotiator::getLastError() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_error_;
+    }
+
+    void BaudNegotiator::supervisorLoop()
+    {
+        negotiate();
+
+        auto last_verify = Clock::now();
+        auto window_start = last_verify;
+        uint64_t window_errors = telemetry_->getFrameStats().crc_errors;
+
+        while (sleepFor(SUPERVISOR_TICK))
+        {
+            BaudNegotiatorConfig config = getConfig();
+            bool checked = false;
+
+            if (renegotiate_.exchange(false))
+            {
+                negotiate();
+                checked = true;
+            }
+            else
+            {
+                // Error burst: the line went bad between verifications
+                uint64_t errors = telemetry_->getFrameStats().crc_errors - window_errors;
+                if (errors >= config.burst_errors)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stats_.error_bursts++;
+                    }
+                    stepDown("CRC error burst (" + std::to_string(errors) + " errors)");
+                    checked = true;
+                }
+                else if (Clock::now() - last_verify >= config.verify_interval)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stats_.verifications++;
+                    }
+                    uint32_t baud_rate = baud_rate_.load();
+                    BaudProbeResult result = probe(baud_rate, config.verify_pings);
+                    if (result.stable)
+                    {
+                        publish(baud_rate, result.error_rate);
+                    }
+                    else if (running_.load())
+                    {
+                        stepDown("Verification failed (" + std::to_string(result.replies) + "/" +
+                                 std::to_string(result.pings_sent) + " replies, " +
+                                 formatPercent(result.error_rate) + " CRC errors)");
+                    }
+                    checked = true;
+                }
+            }
+
+            // Negotiation, verification and fallback traffic start a fresh burst window
+            auto now = Clock::now();
+            if (checked)
+            {
+                last_verify = now;
+            }
+            if (checked || now - window_start >= config.burst_window)
+            {
+                window_start = now;
+                window_errors = telemetry_->getFrameStats().crc_errors;
+            }
+        }
+    }
+
+    bool BaudNegotiator::negotiate()
+    {
+        BaudNegotiatorConfig config = getConfig();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.negotiations++;
+        }
+
+        std::vector<BaudProbeResult> results;
+        uint32_t current = baud_rate_.load();
+        stable_rates_.clear();
+
+        BaudProbeResult baseline = probe(current, config.probe_pings);
+        results.push_back(baseline);
+        double settled_error = baseline.error_rate;
+
+        bool reachable = baseline.replies > 0;
+        if (!reachable)
+        {
+            setError("No reply to device pings at " + std::to_string(current) + " baud");
+        }
+        else if (baseline.stable)
+        {
+            stable_rates_.push_back(current);
+        }
+
+        for (uint32_t rate : CANDIDATE_RATES)
+        {
+            if (!baseline.stable || !running_.load())
+            {
+                break; // A faster rate cannot fix a link that is already unreliable
+            }
+            if (rate <= current || rate > config.max_baud_rate)
+            {
+                continue;
+            }
+
+            BaudProbeResult attempt;
+            attempt.baud_rate = rate;
+            if (!proposeBaudRate(rate))
+            {
+                results.push_back(attempt);
+                std::cout << "[BAUD] Module did not accept " << rate << " baud" << std::endl;
+                break; // Modules accept every rate up to their maximum
+            }
+
+            uint32_t previous = current;
+            if (!switchLocalBaudRate(rate))
+            {
+                results.push_back(attempt);
+                resync(previous);
+                break;
+            }
+            current = rate;
+
+            BaudProbeResult result = probe(rate, config.probe_pings);
+            results.push_back(result);
+            if (result.stable)
+            {
+                stable_rates_.push_back(rate);
+                settled_error = result.error_rate;
+                continue;
+            }
+
+            std::cout << "[BAUD] " << rate << " baud unstable (" << result.replies << "/" << result.pings_sent
+                      << " replies, " << formatPercent(result.error_rate) << " CRC errors)" << std::endl;
+
+            // Back to the last good rate; if the module missed the proposal, go and find it
+            if (!(proposeBaudRate(previous) && switchLocalBaudRate(previous)))
+            {
+                resync(previous);
+            }
+            break;
+        }
+
+        publish(baud_rate_.load(), settled_error);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.negotiated = reachable;
+            probe_results_ = results;
+        }
+
+        std::cout << "[BAUD] Settled on " << baud_rate_.load() << " baud (" << formatPercent(settled_error)
+                  << " CRC errors)" << std::endl;
+        return reachable;
+    }
+
+    BaudProbeResult BaudNegotiator::probe(uint32_t baud_rate, int pings)
+    {
+        BaudNegotiatorConfig config = getConfig();
+
+        BaudProbeResult result;
+        result.baud_rate = baud_rate;
+        result.accepted = true;
+
+        DemuxerStats before = telemetry_->getFrameStats();
+        uint64_t replies_before = telemetry_->getDeviceInfoReplies();
+
+        // DEVICE_PING to every device, answered with DEVICE_INFO (as sendDeviceDiscovery, without the logging)
+        const uint8_t payload[] = {0x00, CrsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER};
+        for (int i = 0; i < pings; ++i)
+        {
+            if (msp_->sendMspCommand(MspCommands::MSP_DEVICE_DISCOVERY, payload, sizeof(payload)))
+            {
+                result.pings_sent++;
+            }
+            if (!sleepFor(config.ping_interval))
+            {
+                break;
+            }
+        }
+
+        // Give the last replies time to arrive
+        auto deadline = Clock::now() + config.reply_timeout;
+        while (telemetry_->getDeviceInfoReplies() - replies_before < result.pings_sent && Clock::now() < deadline &&
+               sleepFor(std::chrono::milliseconds(1)))
+        {
+        }
+
+        DemuxerStats after = telemetry_->getFrameStats();
+        uint64_t replies = telemetry_->getDeviceInfoReplies() - replies_before;
+
+        result.replies = static_cast<uint32_t>(std::min<uint64_t>(replies, result.pings_sent));
+        result.frames = (after.crsf_frames + after.msp_frames) - (before.crsf_frames + before.msp_frames);
+        result.crc_errors = after.crc_errors - before.crc_errors;
+
+        uint64_t total = result.frames + result.crc_errors;
+        result.error_rate = total > 0 ? static_cast<double>(result.crc_errors) / static_cast<double>(total) : 0.0;
+        result.ping_loss = result.pings_sent > 0
+                               ? 1.0 - static_cast<double>(result.replies) / static_cast<double>(result.pings_sent)
+                               : 1.0;
+        result.stable = result.replies > 0 && result.error_rate <= config.max_error_rate &&
+                        result.ping_loss <= config.max_ping_loss;
+        return result;
+    }
+
+    bool BaudNegotiator::proposeBaudRate(uint32_t baud_rate)
+    {
+        std::array<uint8_t, CrsfProtocol::CRSF_FRAME_SIZE_MAX> frame;
+        size_t frame_size = CrsfProtocol::buildSpeedProposalFrame(HANDSET_PORT_ID, baud_rate, frame);
+        auto timeout = getConfig().reply_timeout;
+
+        for (int attempt = 0; attempt < PROPOSAL_ATTEMPTS && running_.load(); ++attempt)
+        {
+            uint64_t responses = telemetry_->getSpeedResponses();
+            if (!sendFrame(frame.data(), frame_size))
+            {
+                return false;
+            }
+
+            auto deadline = Clock::now() + timeout;
+            while (Clock::now() < deadline)
+            {
+                if (telemetry_->getSpeedResponses() != responses)
+                {
+                    return telemetry_->wasLastSpeedAccepted();
+                }
+                if (!sleepFor(std::chrono::milliseconds(1)))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return false; // No response: the module does not support speed changes
+    }
+
+    bool BaudNegotiator::switchLocalBaudRate(uint32_t baud_rate)
+    {
+        if (!transport_->setBaudRate(baud_rate))
+        {
+            setError("Failed to switch to " + std::to_string(baud_rate) + " baud: " + transport_->getLastError());
+            return false;
+        }
+
+        if (write_scheduler_)
+        {
+            write_scheduler_->setBaudRate(baud_rate);
+        }
+        baud_rate_.store(baud_rate);
+
+        sleepFor(SETTLE_TIME);
+        return true;
+    }
+
+    bool BaudNegotiator::stepDown(const std::string &reason)
+    {
+        uint32_t current = baud_rate_.load();
+
+        uint32_t target = current;
+        for (auto it = stable_rates_.rbegin(); it != stable_rates_.rend(); ++it)
+        {
+            if (*it < current)
+            {
+                target = *it;
+                break;
+            }
+        }
+
+        if (target == current)
+        {
+            std::cout << "[BAUD] " << reason << " at " << current << " baud; no lower rate to fall back to" << std::endl;
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.fallbacks++;
+        }
+        std::cout << "[BAUD] " << reason << " at " << current << " baud; falling back to " << target << std::endl;
+
+        // Never climb back to the failed rate without a fresh negotiation
+        stable_rates_.erase(std::remove_if(stable_rates_.begin(), stable_rates_.end(),
+                                           [current](uint32_t rate)
+                                           { return rate >= current; }),
+                            stable_rates_.end());
+
+        bool moved = proposeBaudRate(target) && switchLocalBaudRate(target);
+        if (!moved)
+        {
+            moved = resync(target);
+        }
+
+        BaudProbeResult result = probe(baud_rate_.load(), getConfig().verify_pings);
+        publish(baud_rate_.load(), result.error_rate);
+        return moved && result.replies > 0;
+    }
+
+    bool BaudNegotiator::resync(uint32_t target_rate)
+    {
+        // The module and the port disagree: listen on each rate, fastest first, until pings are answered
+        uint32_t max_rate = std::max(getConfig().max_baud_rate, baud_rate_.load());
+        for (auto it = CANDIDATE_RATES.rbegin(); it != CANDIDATE_RATES.rend() && running_.load(); ++it)
+        {
+            uint32_t rate = *it;
+            if (rate > max_rate || !switchLocalBaudRate(rate))
+            {
+                continue;
+            }
+
+            if (probe(rate, RESYNC_PINGS).replies == 0)
+            {
+                continue;
+            }
+
+            std::cout << "[BAUD] Module found at " << rate << " baud" << std::endl;
+            if (rate != target_rate && proposeBaudRate(target_rate))
+            {
+                switchLocalBaudRate(target_rate);
+            }
+            return true;
+        }
+
+        setError("Module not answering at any candidate rate");
+        switchLocalBaudRate(CANDIDATE_RATES.front());
+        return false;
+    }
+
+    bool BaudNegotiator::sendFrame(const uint8_t *data, size_t length)
+    {
+        if (write_scheduler_ && write_scheduler_->isRunning())
+        {
+            return write_scheduler_->submit(WriteClass::Control, data, length);
+        }
+        return transport_->write(data, length);
+    }
+
+    bool BaudNegotiator::sleepFor(Clock::duration duration)
+    {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_for(lock, duration, [this]()
+                          { return !running_.load(); });
+        return running_.load();
+    }
+
+    void BaudNegotiator::publish(uint32_t baud_rate, double error_rate)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.baud_rate = baud_rate;
+            stats_.error_rate = error_rate;
+        }
+
+        auto &radio_state = RadioState::getInstance();
+        DeviceConfiguration config = radio_state.getDeviceConfiguration();
+        config.baudRate = static_cast<int>(baud_rate);
+        config.baudErrorRate = error_rate;
+        radio_state.setDeviceConfiguration(config);
+    }
+
+    void BaudNegotiator::setError(const std::string &error)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_error_ = error;
+        }
+        std::cerr << "[BAUD_ERROR] " << error << std::endl;
+    }
+
+} // namespace ELRS
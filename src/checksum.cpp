@@ -0,0 +1,321 @@
+#include "checksum.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ELRS_CHECKSUM_X86
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define ELRS_TARGET_PCLMUL
+#else
+#include <cpuid.h>
+#define ELRS_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#endif
+#endif
+
+namespace ELRS
+{
+
+    namespace
+    {
+        // Slicing-by-8 tables: table[k][b] is the CRC of byte b followed by k zero bytes
+        struct Crc8Tables
+        {
+            uint8_t table[8][256];
+        };
+
+        struct Crc32Tables
+        {
+            uint32_t table[8][256];
+        };
+
+        constexpr Crc8Tables makeCrc8Tables(uint8_t poly)
+        {
+            Crc8Tables tables{};
+            for (int b = 0; b < 256; ++b)
+            {
+                uint8_t crc = static_cast<uint8_t>(b);
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ poly : crc << 1);
+                }
+                tables.table[0][b] = crc;
+            }
+            for (int k = 1; k < 8; ++k)
+            {
+                for (int b = 0; b < 256; ++b)
+                {
+                    tables.table[k][b] = tables.table[0][tables.table[k - 1][b]];
+                }
+            }
+            return tables;
+        }
+
+        constexpr Crc32Tables makeCrc32Tables()
+        {
+            Crc32Tables tables{};
+            for (uint32_t b = 0; b < 256; ++b)
+            {
+                uint32_t crc = b;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                }
+                tables.table[0][b] = crc;
+            }
+            for (int k = 1; k < 8; ++k)
+            {
+                for (int b = 0; b < 256; ++b)
+                {
+                    uint32_t prev = tables.table[k - 1][b];
+                    tables.table[k][b] = (prev >> 8) ^ tables.table[0][prev & 0xFF];
+                }
+            }
+            return tables;
+        }
+
+        constexpr Crc8Tables crc8_tables = makeCrc8Tables(0xD5);
+        constexpr Crc8Tables crc8_command_tables = makeCrc8Tables(0xBA);
+        constexpr Crc32Tables crc32_tables = makeCrc32Tables();
+
+        inline uint32_t loadLe32(const uint8_t *p)
+        {
+            return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+                   static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+        }
+
+        // Operates on the inverted register, like zlib's internal loop
+        uint32_t crc32Slice8(const uint8_t *data, size_t length, uint32_t crc)
+        {
+            const auto &t = crc32_tables.table;
+            while (length >= 8)
+            {
+                uint32_t one = loadLe32(data) ^ crc;
+                uint32_t two = loadLe32(data + 4);
+                crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+                      t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+                data += 8;
+                length -= 8;
+            }
+            while (length--)
+            {
+                crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+            }
+            return crc;
+        }
+
+#ifdef ELRS_CHECKSUM_X86
+        /*
+         * Carry-less multiplication folding (Gopal et al., "Fast CRC Computation
+         * for Generic Polynomials Using PCLMULQDQ"), using the bit-reflected
+         * constants from Chromium's zlib crc32_sse42_simd_. Requires length >= 64
+         * and a multiple of 16; crc is the inverted register.
+         */
+        ELRS_TARGET_PCLMUL uint32_t crc32Pclmul(const uint8_t *buf, size_t len, uint32_t crc)
+        {
+            alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+            alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+            alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+            alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+            __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+            x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x00));
+            x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x10));
+            x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x20));
+            x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x30));
+
+            x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+            x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+
+            buf += 64;
+            len -= 64;
+
+            // Fold four 128-bit lanes in parallel
+            while (len >= 64)
+            {
+                x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+                x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+                x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+                x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+                x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+                y5 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x00));
+                y6 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x10));
+                y7 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x20));
+                y8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + 0x30));
+
+                x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+                x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+                x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+                x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+                buf += 64;
+                len -= 64;
+            }
+
+            // Fold the four lanes into one
+            x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+            // Remaining 16-byte blocks
+            while (len >= 16)
+            {
+                x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf));
+
+                x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+                buf += 16;
+                len -= 16;
+            }
+
+            // 128 -> 64 bits
+            x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+            x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+            x1 = _mm_srli_si128(x1, 8);
+            x1 = _mm_xor_si128(x1, x2);
+
+            x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+
+            x2 = _mm_srli_si128(x1, 4);
+            x1 = _mm_and_si128(x1, x3);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_xor_si128(x1, x2);
+
+            // Barrett reduction to 32 bits
+            x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+
+            x2 = _mm_and_si128(x1, x3);
+            x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+            x2 = _mm_and_si128(x2, x3);
+            x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+            x1 = _mm_xor_si128(x1, x2);
+
+            return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+        }
+
+        bool cpuHasPclmul()
+        {
+            // CPUID.1:ECX bit 1 = PCLMULQDQ, bit 19 = SSE4.1
+#ifdef _MSC_VER
+            int regs[4];
+            __cpuid(regs, 1);
+            unsigned ecx = static_cast<unsigned>(regs[2]);
+#else
+            unsigned eax, ebx, ecx, edx;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            {
+                return false;
+            }
+#endif
+            return (ecx & (1u << 1)) && (ecx & (1u << 19));
+        }
+#endif
+
+        // Detected once; the fast path only applies to blocks of at least 64 bytes
+        struct Crc32Dispatch
+        {
+            bool use_pclmul = false;
+
+            Crc32Dispatch()
+            {
+#ifdef ELRS_CHECKSUM_X86
+                use_pclmul = cpuHasPclmul();
+#endif
+            }
+        };
+
+        const Crc32Dispatch crc32_dispatch;
+    }
+
+    uint8_t Checksum::crc8DvbS2(const uint8_t *data, size_t length, uint8_t crc)
+    {
+        const auto &t = crc8_tables.table;
+        while (length >= 8)
+        {
+            crc = t[7][crc ^ data[0]] ^ t[6][data[1]] ^ t[5][data[2]] ^ t[4][data[3]] ^
+                  t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+            data += 8;
+            length -= 8;
+        }
+        while (length--)
+        {
+            crc = t[0][crc ^ *data++];
+        }
+        return crc;
+    }
+
+    uint8_t Checksum::crsfCommandCrc(const uint8_t *data, size_t length, uint8_t crc)
+    {
+        // Command frames are a dozen bytes; the single table is enough
+        const auto &t = crc8_command_tables.table[0];
+        while (length--)
+        {
+            crc = t[crc ^ *data++];
+        }
+        return crc;
+    }
+
+    uint8_t Checksum::mspV1Xor(const uint8_t *data, size_t length, uint8_t checksum)
+    {
+        // XOR eight bytes at a time, then fold the word
+        uint64_t acc = 0;
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            acc ^= word;
+        }
+        acc ^= acc >> 32;
+        acc ^= acc >> 16;
+        acc ^= acc >> 8;
+
+        checksum ^= static_cast<uint8_t>(acc);
+        for (; i < length; ++i)
+        {
+            checksum ^= data[i];
+        }
+        return checksum;
+    }
+
+    uint32_t Checksum::crc32(const uint8_t *data, size_t length, uint32_t crc)
+    {
+        crc = ~crc;
+#ifdef ELRS_CHECKSUM_X86
+        if (crc32_dispatch.use_pclmul && length >= 64)
+        {
+            size_t chunk = length & ~static_cast<size_t>(15);
+            crc = crc32Pclmul(data, chunk, crc);
+            data += chunk;
+            length -= chunk;
+        }
+#endif
+        return ~crc32Slice8(data, length, crc);
+    }
+
+    const char *Checksum::crc32Implementation()
+    {
+        return crc32_dispatch.use_pclmul ? "pclmul" : "slice8";
+    }
+
+} // namespace ELRS
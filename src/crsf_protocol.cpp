@@ -1,9 +1,53 @@
 #include "crsf_protocol.h"
+#include "checksum.h"
 #include <cmath>
+#include <cstring>
 
 namespace ELRS
 {
 
+    namespace
+    {
+        // COMMAND frame: [sync] [len] [0x32] [dest] [origin] [0x0A] [cmd] [args...] [cmd crc] [crc]
+        size_t buildGeneralCommandFrame(uint8_t sync, uint8_t dest, uint8_t origin, uint8_t command,
+                                        const uint8_t *args, size_t arg_count,
+                                        std::array<uint8_t, CrsfProtocol::CRSF_FRAME_SIZE_MAX> &frame_out)
+        {
+            const size_t payload_size = 4 + arg_count + 1; // dest, origin, sub-command, command, args, cmd crc
+
+            frame_out[0] = sync;
+            frame_out[1] = static_cast<uint8_t>(payload_size + 2);
+            frame_out[2] = CrsfProtocol::CRSF_FRAMETYPE_COMMAND;
+            frame_out[3] = dest;
+            frame_out[4] = origin;
+            frame_out[5] = CrsfProtocol::CRSF_COMMAND_SUBCMD_GENERAL;
+            frame_out[6] = command;
+            std::memcpy(&frame_out[7], args, arg_count);
+
+            size_t out = 7 + arg_count;
+            frame_out[out] = Checksum::crsfCommandCrc(&frame_out[2], out - 2);
+            ++out;
+            frame_out[out] = CrsfProtocol::crc8(&frame_out[2], static_cast<uint8_t>(payload_size + 1));
+            return out + 1;
+        }
+
+        // Checks the sub-command header, argument count and inner CRC of a general command payload
+        bool parseGeneralCommandPayload(const uint8_t *payload, size_t length, uint8_t command, size_t arg_count)
+        {
+            if (!payload || length != 4 + arg_count + 1 ||
+                payload[2] != CrsfProtocol::CRSF_COMMAND_SUBCMD_GENERAL || payload[3] != command)
+            {
+                return false;
+            }
+
+            // The inner CRC also covers the frame type byte, which is not part of the payload
+            uint8_t type = CrsfProtocol::CRSF_FRAMETYPE_COMMAND;
+            uint8_t crc = Checksum::crsfCommandCrc(&type, 1);
+            crc = Checksum::crsfCommandCrc(payload, length - 1, crc);
+            return crc == payload[length - 1];
+        }
+    }
+
     uint8_t CrsfProtocol::buildRcChannelsFrame(const uint16_t channels[CRSF_CHANNEL_COUNT],
                                                std::array<uint8_t, 26> &frame_out)
     {
@@ -17,51 +61,299 @@ namespace ELRS
         // Pack 16 channels into 22 bytes
         packChannels(channels, &frame_out[3]);
 
-        // Calculate CRC over length, type, and payload
-        uint8_t crc = crc8(&frame_out[1], CRSF_FRAME_CHANNELS_PAYLOAD_SIZE + 1);
+        // Calculate CRC over type and payload (address and length are not covered)
+        uint8_t crc = crc8(&frame_out[2], CRSF_FRAME_CHANNELS_PAYLOAD_SIZE + 1);
         frame_out[25] = crc;
 
         return 26; // Total frame size
     }
 
+    size_t CrsfProtocol::buildRcChannelsSubsetFrame(const float *channels_us, uint8_t start_channel, uint8_t channel_count,
+                                                    SubsetResolution resolution,
+                                                    std::array<uint8_t, CRSF_FRAME_SIZE_MAX> &frame_out)
+    {
+        if (!channels_us || channel_count == 0 || channel_count > CRSF_CHANNEL_COUNT ||
+            start_channel > CRSF_SUBSET_START_CHANNEL_MAX)
+        {
+            return 0;
+        }
+
+        const unsigned bits = subsetBits(resolution);
+        const float scale = subsetScale(resolution);
+        const uint32_t value_max = (1u << bits) - 1;
+        const size_t payload_size = 1 + (channel_count * bits + 7) / 8; // config byte + packed channels
+
+        frame_out[0] = CRSF_ADDRESS_FLIGHT_CONTROLLER;
+        frame_out[1] = static_cast<uint8_t>(payload_size + 2); // payload + type + crc
+        frame_out[2] = CRSF_FRAMETYPE_RC_CHANNELS_SUBSET;
+        frame_out[3] = static_cast<uint8_t>(start_channel | (static_cast<uint8_t>(resolution) << 5));
+
+        // LSB-first bitstream, same bit order as RC_CHANNELS_PACKED
+        uint64_t acc = 0;
+        unsigned acc_bits = 0;
+        size_t out = 4;
+        for (uint8_t i = 0; i < channel_count; ++i)
+        {
+            float value = std::round((channels_us[i] - CRSF_SUBSET_US_OFFSET) / scale);
+            uint32_t v = value <= 0.0f ? 0 : (value >= static_cast<float>(value_max) ? value_max : static_cast<uint32_t>(value));
+
+            acc |= static_cast<uint64_t>(v) << acc_bits;
+            acc_bits += bits;
+            while (acc_bits >= 8)
+            {
+                frame_out[out++] = static_cast<uint8_t>(acc);
+                acc >>= 8;
+                acc_bits -= 8;
+            }
+        }
+        if (acc_bits > 0)
+        {
+            frame_out[out++] = static_cast<uint8_t>(acc);
+        }
+
+        frame_out[out] = crc8(&frame_out[2], static_cast<uint8_t>(payload_size + 1));
+        return out + 1;
+    }
+
+    size_t CrsfProtocol::buildSpeedProposalFrame(uint8_t port_id, uint32_t baud_rate,
+                                                 std::array<uint8_t, CRSF_FRAME_SIZE_MAX> &frame_out)
+    {
+        const uint8_t args[] = {
+            port_id,
+            static_cast<uint8_t>(baud_rate >> 24), static_cast<uint8_t>(baud_rate >> 16),
+            static_cast<uint8_t>(baud_rate >> 8), static_cast<uint8_t>(baud_rate)};
+        return buildGeneralCommandFrame(CRSF_ADDRESS_CRSF_TRANSMITTER, CRSF_ADDRESS_CRSF_TRANSMITTER,
+                                        CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_COMMAND_SPEED_PROPOSAL,
+                                        args, sizeof(args), frame_out);
+    }
+
+    size_t CrsfProtocol::buildSpeedResponseFrame(uint8_t port_id, bool accepted,
+                                                 std::array<uint8_t, CRSF_FRAME_SIZE_MAX> &frame_out)
+    {
+        const uint8_t args[] = {port_id, static_cast<uint8_t>(accepted ? 1 : 0)};
+        return buildGeneralCommandFrame(CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_ADDRESS_RADIO_TRANSMITTER,
+                                        CRSF_ADDRESS_CRSF_TRANSMITTER, CRSF_COMMAND_SPEED_RESPONSE,
+                                        args, sizeof(args), frame_out);
+    }
+
+    bool CrsfProtocol::parseSpeedProposalPayload(const uint8_t *payload, size_t length, uint8_t &port_id_out,
+                                                 uint32_t &baud_rate_out)
+    {
+        if (!parseGeneralCommandPayload(payload, length, CRSF_COMMAND_SPEED_PROPOSAL, 5))
+        {
+            return false;
+        }
+
+        port_id_out = payload[4];
+        baud_rate_out = static_cast<uint32_t>(payload[5]) << 24 | static_cast<uint32_t>(payload[6]) << 16 |
+                        static_cast<uint32_t>(payload[7]) << 8 | static_cast<uint32_t>(payload[8]);
+        return true;
+    }
+
+    bool CrsfProtocol::parseSpeedResponsePayload(const uint8_t *payload, size_t length, uint8_t &port_id_out,
+                                                 bool &accepted_out)
+    {
+        if (!parseGeneralCommandPayload(payload, length, CRSF_COMMAND_SPEED_RESPONSE, 2))
+        {
+            return false;
+        }
+
+        port_id_out = payload[4];
+        accepted_out = payload[5] != 0;
+        return true;
+    }
+
+    size_t CrsfProtocol::parseRcChannelsSubsetPayload(const uint8_t *payload, size_t length, uint8_t &start_channel_out,
+                                                      SubsetResolution &resolution_out, float *channels_us_out,
+                                                      size_t max_channels)
+    {
+        if (!payload || length < 2)
+        {
+            return 0;
+        }
+
+        start_channel_out = payload[0] & 0x1F;
+        resolution_out = static_cast<SubsetResolution>((payload[0] >> 5) & 0x03);
+
+        const unsigned bits = subsetBits(resolution_out);
+        const float scale = subsetScale(resolution_out);
+        const uint32_t value_mask = (1u << bits) - 1;
+
+        // Padding is always shorter than one channel, so this is exact
+        size_t count = (length - 1) * 8 / bits;
+        if (count > max_channels)
+        {
+            count = max_channels;
+        }
+
+        uint64_t acc = 0;
+        unsigned acc_bits = 0;
+        size_t in = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            while (acc_bits < bits)
+            {
+                acc |= static_cast<uint64_t>(payload[in++]) << acc_bits;
+                acc_bits += 8;
+            }
+            channels_us_out[i] = static_cast<float>(acc & value_mask) * scale + CRSF_SUBSET_US_OFFSET;
+            acc >>= bits;
+            acc_bits -= bits;
+        }
+
+        return count;
+    }
+
+    float CrsfProtocol::channelValueToMicroseconds(uint16_t value)
+    {
+        return CRSF_SUBSET_US_OFFSET + (static_cast<float>(value) - CRSF_CHANNEL_VALUE_MIN) * 1024.0f /
+                                           static_cast<float>(CRSF_CHANNEL_VALUE_MAX - CRSF_CHANNEL_VALUE_MIN);
+    }
+
+    void CrsfProtocol::updateRcChannelsFrame(const uint16_t channels[CRSF_CHANNEL_COUNT], uint16_t dirty_mask,
+                                             std::array<uint8_t, 26> &frame)
+    {
+        if (dirty_mask == 0)
+        {
+            return; // Frame and CRC are already current
+        }
+
+        for (size_t i = 0; i < CRSF_CHANNEL_COUNT; ++i)
+        {
+            if (dirty_mask & (1u << i))
+            {
+                setPackedChannel(&frame[3], i, channels[i]);
+            }
+        }
+
+        frame[25] = crc8(&frame[2], CRSF_FRAME_CHANNELS_PAYLOAD_SIZE + 1);
+    }
+
+    void CrsfProtocol::setPackedChannel(uint8_t packed[CRSF_FRAME_CHANNELS_PAYLOAD_SIZE], size_t channel, uint16_t value)
+    {
+        // Channel n occupies bits [11n, 11n + 11) of the little-endian bitstream
+        size_t bit = channel * 11;
+        size_t byte = bit >> 3;
+        unsigned shift = static_cast<unsigned>(bit & 7);
+        size_t span = (shift + 11 + 7) >> 3; // 2 or 3 bytes
+
+        uint32_t field_mask = 0x07FFu << shift;
+        uint32_t field = static_cast<uint32_t>(value & 0x07FF) << shift;
+        for (size_t i = 0; i < span; ++i)
+        {
+            uint8_t keep = static_cast<uint8_t>(~(field_mask >> (8 * i)));
+            packed[byte + i] = static_cast<uint8_t>((packed[byte + i] & keep) | (field >> (8 * i)));
+        }
+    }
+
+    namespace
+    {
+        /*
+         * Eight 11-bit channels occupy 88 bits = 11 bytes: channels 0-4 and the low
+         * 9 bits of channel 5 fill a 64-bit word, the rest a 24-bit tail. Packing a
+         * group is a handful of shifts and ORs with no per-byte masking or branches,
+         * then one 8-byte store plus a 3-byte tail.
+         */
+        inline uint64_t loadLe64(const uint8_t *p)
+        {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            uint64_t v = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                v |= static_cast<uint64_t>(p[i]) << (8 * i);
+            }
+            return v;
+#else
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+#endif
+        }
+
+        inline void storeLe64(uint8_t *p, uint64_t v)
+        {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            for (int i = 0; i < 8; ++i)
+            {
+                p[i] = static_cast<uint8_t>(v >> (8 * i));
+            }
+#else
+            std::memcpy(p, &v, sizeof(v));
+#endif
+        }
+
+        inline void packGroup(const uint16_t *ch, uint8_t *out)
+        {
+            uint64_t lo = static_cast<uint64_t>(ch[0] & 0x07FF) |
+                          static_cast<uint64_t>(ch[1] & 0x07FF) << 11 |
+                          static_cast<uint64_t>(ch[2] & 0x07FF) << 22 |
+                          static_cast<uint64_t>(ch[3] & 0x07FF) << 33 |
+                          static_cast<uint64_t>(ch[4] & 0x07FF) << 44 |
+                          static_cast<uint64_t>(ch[5] & 0x07FF) << 55;
+            uint32_t hi = static_cast<uint32_t>(ch[5] & 0x07FF) >> 9 |
+                          static_cast<uint32_t>(ch[6] & 0x07FF) << 2 |
+                          static_cast<uint32_t>(ch[7] & 0x07FF) << 13;
+
+            storeLe64(out, lo);
+            out[8] = static_cast<uint8_t>(hi);
+            out[9] = static_cast<uint8_t>(hi >> 8);
+            out[10] = static_cast<uint8_t>(hi >> 16);
+        }
+
+        inline void unpackGroup(const uint8_t *in, uint16_t *ch)
+        {
+            uint64_t lo = loadLe64(in);
+            uint32_t hi = static_cast<uint32_t>(in[8]) |
+                          static_cast<uint32_t>(in[9]) << 8 |
+                          static_cast<uint32_t>(in[10]) << 16;
+
+            ch[0] = static_cast<uint16_t>(lo & 0x07FF);
+            ch[1] = static_cast<uint16_t>((lo >> 11) & 0x07FF);
+            ch[2] = static_cast<uint16_t>((lo >> 22) & 0x07FF);
+            ch[3] = static_cast<uint16_t>((lo >> 33) & 0x07FF);
+            ch[4] = static_cast<uint16_t>((lo >> 44) & 0x07FF);
+            ch[5] = static_cast<uint16_t>(((lo >> 55) | (static_cast<uint64_t>(hi) << 9)) & 0x07FF);
+            ch[6] = static_cast<uint16_t>((hi >> 2) & 0x07FF);
+            ch[7] = static_cast<uint16_t>((hi >> 13) & 0x07FF);
+        }
+    }
+
     void CrsfProtocol::packChannels(const uint16_t channels[CRSF_CHANNEL_COUNT],
                                     uint8_t packed_out[CRSF_FRAME_CHANNELS_PAYLOAD_SIZE])
     {
-        // Pack 16 channels (11-bit each) into 22 bytes
-        // This is a bit-packing operation where each channel uses 11 bits
-
-        packed_out[0] = static_cast<uint8_t>(channels[0] & 0x07FF);
-        packed_out[1] = static_cast<uint8_t>((channels[0] & 0x07FF) >> 8 | (channels[1] & 0x07FF) << 3);
-        packed_out[2] = static_cast<uint8_t>((channels[1] & 0x07FF) >> 5 | (channels[2] & 0x07FF) << 6);
-        packed_out[3] = static_cast<uint8_t>((channels[2] & 0x07FF) >> 2);
-        packed_out[4] = static_cast<uint8_t>((channels[2] & 0x07FF) >> 10 | (channels[3] & 0x07FF) << 1);
-        packed_out[5] = static_cast<uint8_t>((channels[3] & 0x07FF) >> 7 | (channels[4] & 0x07FF) << 4);
-        packed_out[6] = static_cast<uint8_t>((channels[4] & 0x07FF) >> 4 | (channels[5] & 0x07FF) << 7);
-        packed_out[7] = static_cast<uint8_t>((channels[5] & 0x07FF) >> 1);
-        packed_out[8] = static_cast<uint8_t>((channels[5] & 0x07FF) >> 9 | (channels[6] & 0x07FF) << 2);
-        packed_out[9] = static_cast<uint8_t>((channels[6] & 0x07FF) >> 6 | (channels[7] & 0x07FF) << 5);
-        packed_out[10] = static_cast<uint8_t>((channels[7] & 0x07FF) >> 3);
-        packed_out[11] = static_cast<uint8_t>((channels[8] & 0x07FF));
-        packed_out[12] = static_cast<uint8_t>((channels[8] & 0x07FF) >> 8 | (channels[9] & 0x07FF) << 3);
-        packed_out[13] = static_cast<uint8_t>((channels[9] & 0x07FF) >> 5 | (channels[10] & 0x07FF) << 6);
-        packed_out[14] = static_cast<uint8_t>((channels[10] & 0x07FF) >> 2);
-        packed_out[15] = static_cast<uint8_t>((channels[10] & 0x07FF) >> 10 | (channels[11] & 0x07FF) << 1);
-        packed_out[16] = static_cast<uint8_t>((channels[11] & 0x07FF) >> 7 | (channels[12] & 0x07FF) << 4);
-        packed_out[17] = static_cast<uint8_t>((channels[12] & 0x07FF) >> 4 | (channels[13] & 0x07FF) << 7);
-        packed_out[18] = static_cast<uint8_t>((channels[13] & 0x07FF) >> 1);
-        packed_out[19] = static_cast<uint8_t>((channels[13] & 0x07FF) >> 9 | (channels[14] & 0x07FF) << 2);
-        packed_out[20] = static_cast<uint8_t>((channels[14] & 0x07FF) >> 6 | (channels[15] & 0x07FF) << 5);
-        packed_out[21] = static_cast<uint8_t>((channels[15] & 0x07FF) >> 3);
+        // 16 channels x 11 bits = two 11-byte groups of 8 channels
+        packGroup(channels, packed_out);
+        packGroup(channels + 8, packed_out + 11);
     }
 
-    uint8_t CrsfProtocol::crc8(const uint8_t *data, uint8_t length)
+    void CrsfProtocol::unpackChannels(const uint8_t packed[CRSF_FRAME_CHANNELS_PAYLOAD_SIZE],
+                                      uint16_t channels_out[CRSF_CHANNEL_COUNT])
+    {
+        unpackGroup(packed, channels_out);
+        unpackGroup(packed + 11, channels_out + 8);
+    }
+
+    void CrsfProtocol::packChannelsBatch(const uint16_t *channels, size_t frame_count,
+                                         uint8_t *packed_out, size_t packed_stride)
     {
-        uint8_t crc = 0;
-        for (uint8_t i = 0; i < length; i++)
+        for (size_t i = 0; i < frame_count; ++i)
         {
-            crc = crc8_table[crc ^ data[i]];
+            packChannels(channels + i * CRSF_CHANNEL_COUNT, packed_out + i * packed_stride);
         }
-        return crc;
+    }
+
+    void CrsfProtocol::unpackChannelsBatch(const uint8_t *packed, size_t frame_count,
+                                           uint16_t *channels_out, size_t packed_stride)
+    {
+        for (size_t i = 0; i < frame_count; ++i)
+        {
+            unpackChannels(packed + i * packed_stride, channels_out + i * CRSF_CHANNEL_COUNT);
+        }
+    }
+
+    uint8_t CrsfProtocol::crc8(const uint8_t *data, uint8_t length)
+    {
+        return Checksum::crc8DvbS2(data, length);
     }
 
     uint16_t CrsfProtocol::microsecondsToChannelValue(float microseconds)
@@ -0,0 +1,626 @@
+#include "elrs_emulator.h"
+#include "crsf_protocol.h"
+#include "msp_commands.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace ELRS
+{
+
+    namespace
+    {
+        constexpr uint8_t CRSF_ADDRESS_RADIO_TRANSMITTER = 0xEA;
+        constexpr uint8_t CRSF_ADDRESS_CRSF_TRANSMITTER = 0xEE;
+        constexpr uint8_t CRSF_FRAMETYPE_BATTERY_SENSOR = 0x08;
+        constexpr uint8_t CRSF_FRAMETYPE_LINK_STATISTICS = 0x14;
+        constexpr uint8_t CRSF_FRAMETYPE_RADIO_ID = 0x3A;
+        constexpr uint8_t CRSF_RADIO_ID_SUBTYPE_TIMING = 0x10;
+        constexpr uint8_t MSP_DEVICE_INFO = 0x29;
+
+        // Corruption applied to everything emitted above max_stable_baud_rate
+        constexpr double UNSTABLE_ERROR_RATIO = 0.2;
+
+        // Selectable TX power levels and their CRSF LINK_STATISTICS power enum
+        constexpr int POWER_LEVELS_MW[] = {10, 25, 50, 100, 250, 500, 1000};
+        constexpr uint8_t POWER_CRSF_ENUM[] = {1, 2, 8, 3, 7, 4, 5};
+        constexpr size_t POWER_LEVEL_COUNT = sizeof(POWER_LEVELS_MW) / sizeof(POWER_LEVELS_MW[0]);
+
+        using Clock = std::chrono::steady_clock;
+
+        // Inverse of CrsfProtocol::channelValueToMicroseconds (988us = 172, 2012us = 1811)
+        uint16_t microsecondsToChannelValue(float microseconds)
+        {
+            float value = CrsfProtocol::CRSF_CHANNEL_VALUE_MIN +
+                          (microseconds - 988.0f) *
+                              (CrsfProtocol::CRSF_CHANNEL_VALUE_MAX - CrsfProtocol::CRSF_CHANNEL_VALUE_MIN) / 1024.0f;
+            return static_cast<uint16_t>(std::max(0.0f, std::min(2047.0f, std::round(value))));
+        }
+
+        Clock::duration periodFor(double hz, double multiplier)
+        {
+            double rate = hz * multiplier;
+            if (rate <= 0.0)
+            {
+                return Clock::duration::max();
+            }
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+        }
+    }
+
+    ElrsEmulator::ElrsEmulator(const EmulatorConfig &config)
+        : config_(config), rng_(config.seed)
+    {
+        channels_.fill(CrsfProtocol::CRSF_CHANNEL_VALUE_MID);
+
+        demuxer_.setCrsfHandler(CrsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_PACKED, [this](const CrsfFrameView &frame)
+                                {
+                                    if (frame.payload.size() != CrsfProtocol::CRSF_FRAME_CHANNELS_PAYLOAD_SIZE)
+                                    {
+                                        return;
+                                    }
+                                    std::array<uint16_t, 16> channels;
+                                    CrsfProtocol::unpackChannels(frame.payload.data(), channels.data());
+
+                                    std::lock_guard<std::mutex> lock(state_mutex_);
+                                    channels_ = channels;
+                                    last_rc_time_ = std::chrono::steady_clock::now();
+                                    stats_.rc_frames++; });
+
+        demuxer_.setCrsfHandler(CrsfProtocol::CRSF_FRAMETYPE_RC_CHANNELS_SUBSET, [this](const CrsfFrameView &frame)
+                                {
+                                    uint8_t start = 0;
+                                    CrsfProtocol::SubsetResolution resolution;
+                                    std::array<float, 32> channels_us;
+                                    size_t count = CrsfProtocol::parseRcChannelsSubsetPayload(
+                                        frame.payload.data(), frame.payload.size(), start, resolution,
+                                        channels_us.data(), channels_us.size());
+                                    if (count == 0)
+                                    {
+                                        return;
+                                    }
+
+                                    std::lock_guard<std::mutex> lock(state_mutex_);
+                                    for (size_t i = 0; i < count && start + i < channels_.size(); ++i)
+                                    {
+                                        channels_[start + i] = microsecondsToChannelValue(channels_us[i]);
+                                    }
+                                    last_rc_time_ = std::chrono::steady_clock::now();
+                                    stats_.rc_subset_frames++; });
+
+        demuxer_.setCrsfHandler(CrsfProtocol::CRSF_FRAMETYPE_COMMAND, [this](const CrsfFrameView &frame)
+                                {
+                                    uint8_t port_id = 0;
+                                    uint32_t baud_rate = 0;
+                                    if (CrsfProtocol::parseSpeedProposalPayload(frame.payload.data(), frame.payload.size(),
+                                                                                port_id, baud_rate))
+                                    {
+                                        handleSpeedProposal(port_id, baud_rate);
+                                    } });
+
+        demuxer_.setDefaultMspHandler([this](const MspFrameView &frame)
+                                      {
+                                          if (frame.direction != '<')
+                                          {
+                                              return; // Only host requests are answered
+                                          }
+                                          {
+                                              std::lock_guard<std::mutex> lock(state_mutex_);
+                                              stats_.msp_requests++;
+                                              if (frame.crsf_origin != 0)
+                                              {
+                                                  stats_.msp_tunnelled++;
+                                              }
+                                          }
+                                          handleMspRequest(frame); });
+    }
+
+    ElrsEmulator::~ElrsEmulator()
+    {
+        stop();
+    }
+
+    bool ElrsEmulator::start()
+    {
+        if (running_.load())
+        {
+            return true;
+        }
+
+#ifdef _WIN32
+        setError("PTY emulation is only available on POSIX systems");
+        return false;
+#else
+        master_fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master_fd_ < 0 || grantpt(master_fd_) != 0 || unlockpt(master_fd_) != 0)
+        {
+            setError("Failed to allocate pseudo-terminal: " + std::string(std::strerror(errno)));
+            if (master_fd_ >= 0)
+            {
+                ::close(master_fd_);
+                master_fd_ = -1;
+            }
+            return false;
+        }
+
+        const char *slave = ptsname(master_fd_);
+        device_path_ = slave ? slave : "";
+
+        // Raw line discipline so binary frames pass through untouched
+        termios tio;
+        if (tcgetattr(master_fd_, &tio) == 0)
+        {
+            cfmakeraw(&tio);
+            tcsetattr(master_fd_, TCSANOW, &tio);
+        }
+        fcntl(master_fd_, F_SETFL, fcntl(master_fd_, F_GETFL, 0) | O_NONBLOCK);
+
+        running_.store(true);
+        thread_ = std::make_unique<std::thread>(&ElrsEmulator::emulatorLoop, this);
+
+        std::cout << "[EMULATOR] Virtual TX module on " << device_path_
+                  << " (x" << config_.rate_multiplier << " rate, "
+                  << config_.error_ratio * 100.0 << "% CRC errors)" << std::endl;
+        return true;
+#endif
+    }
+
+    void ElrsEmulator::stop()
+    {
+        if (!running_.exchange(false))
+        {
+            return;
+        }
+
+        if (thread_ && thread_->joinable())
+        {
+            thread_->join();
+        }
+        thread_.reset();
+
+#ifndef _WIN32
+        if (master_fd_ >= 0)
+        {
+            ::close(master_fd_);
+            master_fd_ = -1;
+        }
+#endif
+        std::cout << "[EMULATOR] Stopped" << std::endl;
+    }
+
+    EmulatorStats ElrsEmulator::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return stats_;
+    }
+
+    std::array<uint16_t, 16> ElrsEmulator::getLastChannels() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return channels_;
+    }
+
+    int ElrsEmulator::getPowerLevelMw() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return POWER_LEVELS_MW[power_index_];
+    }
+
+    uint8_t ElrsEmulator::getModelId() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return model_id_;
+    }
+
+    void ElrsEmulator::emulatorLoop()
+    {
+#ifndef _WIN32
+        auto link_period = periodFor(config_.link_stats_hz, config_.rate_multiplier);
+        auto battery_period = periodFor(config_.battery_hz, config_.rate_multiplier);
+        auto spectrum_period = periodFor(config_.spectrum_hz, config_.rate_multiplier);
+        // Sync frames describe the air link, so they are not load-test scaled
+        auto sync_period = config_.packet_rate_hz > 0.0 ? periodFor(config_.sync_hz, 1.0) : Clock::duration::max();
+
+        auto now = Clock::now();
+        auto next_link = now + std::min(link_period, Clock::duration(std::chrono::hours(1)));
+        auto next_battery = now + std::min(battery_period, Clock::duration(std::chrono::hours(1)));
+        auto next_spectrum = now + std::min(spectrum_period, Clock::duration(std::chrono::hours(1)));
+        auto next_sync = now + std::min(sync_period, Clock::duration(std::chrono::hours(1)));
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            slot_origin_ = now;
+        }
+
+        while (running_.load())
+        {
+            now = Clock::now();
+            auto next = std::min({next_link, next_battery, next_spectrum, next_sync});
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count();
+            wait = std::max<long long>(0, std::min<long long>(wait, 50)); // Stay responsive to stop()
+
+            pollfd pfd{master_fd_, POLLIN, 0};
+            int rc = ::poll(&pfd, 1, static_cast<int>(wait));
+            if (rc > 0 && (pfd.revents & POLLIN))
+            {
+                processInput();
+            }
+
+            // Catch up without bursting: skip periods that were missed entirely
+            now = Clock::now();
+            if (now >= next_link)
+            {
+                sendLinkStats();
+                next_link = std::max(next_link + link_period, now);
+            }
+            if (now >= next_battery)
+            {
+                sendBattery();
+                next_battery = std::max(next_battery + battery_period, now);
+            }
+            if (now >= next_spectrum)
+            {
+                sendSpectrum(true, config_.msp_version, config_.msp_encapsulation);
+                next_spectrum = std::max(next_spectrum + spectrum_period, now);
+            }
+            if (now >= next_sync)
+            {
+                sendTimingSync();
+                next_sync = std::max(next_sync + sync_period, now);
+            }
+        }
+#endif
+    }
+
+    void ElrsEmulator::processInput()
+    {
+#ifndef _WIN32
+        uint8_t chunk[512];
+        for (;;)
+        {
+            ssize_t n = ::read(master_fd_, chunk, sizeof(chunk));
+            if (n <= 0)
+            {
+                break;
+            }
+            demuxer_.feed(chunk, static_cast<size_t>(n));
+        }
+
+        uint64_t crc_errors = demuxer_.getStats().crc_errors;
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stats_.crc_errors = crc_errors;
+#endif
+    }
+
+    void ElrsEmulator::handleMspRequest(const MspFrameView &request)
+    {
+        const uint16_t function = request.function;
+        const uint8_t *payload = request.payload.data();
+        const size_t length = request.payload.size();
+        const MspEncapsulation encapsulation = request.crsf_origin != 0 ? MspEncapsulation::Crsf : MspEncapsulation::Raw;
+
+        switch (function)
+        {
+        case MspCommands::MSP_DEVICE_DISCOVERY:
+        {
+            // Reply in CRSF DEVICE_INFO layout: dest, origin, name, serial, hw, sw, field count, version
+            std::vector<uint8_t> info = {CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_ADDRESS_CRSF_TRANSMITTER};
+            info.insert(info.end(), config_.device_name.begin(), config_.device_name.end());
+            info.push_back(0x00);
+            const uint8_t tail[] = {'E', 'L', 'R', 'S', 0, 0, 0, 0, 0, 3, 5, 0, 0, 0};
+            info.insert(info.end(), std::begin(tail), std::end(tail));
+            sendMspResponse(MSP_DEVICE_INFO, info.data(), info.size(), request.version, encapsulation);
+            break;
+        }
+
+        case MspCommands::MSP_ELRS_TELEMETRY_PUSH:
+            // { deviceId, handsetId, fieldId, status } - status bit0 asks for spectrum bins
+            sendSpectrum(length >= 4 && (payload[3] & 0x01), request.version, encapsulation);
+            break;
+
+        case MspCommands::MSP_POWER_CONTROL:
+        {
+            uint8_t level;
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                if (length >= 1 && payload[0] == 0x01 && power_index_ + 1 < POWER_LEVEL_COUNT)
+                {
+                    power_index_++;
+                }
+                else if (length >= 1 && payload[0] == 0x00 && power_index_ > 0)
+                {
+                    power_index_--;
+                }
+                level = static_cast<uint8_t>(power_index_);
+            }
+            sendMspResponse(function, &level, 1, request.version, encapsulation);
+            break;
+        }
+
+        case MspCommands::MSP_MODEL_SELECT:
+        {
+            uint8_t model;
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                if (length >= 1)
+                {
+                    model_id_ = payload[0];
+                }
+                model = model_id_;
+            }
+            sendMspResponse(function, &model, 1, request.version, encapsulation);
+            break;
+        }
+
+        default:
+            sendMspResponse(function, nullptr, 0, request.version, encapsulation, '!'); // MSP error reply
+            break;
+        }
+    }
+
+    void ElrsEmulator::handleSpeedProposal(uint8_t port_id, uint32_t baud_rate)
+    {
+        if (config_.max_baud_rate == 0)
+        {
+            return; // Behave like a module without speed negotiation
+        }
+
+        // Reply at the current rate, then switch (a PTY does not care, but the host does the same)
+        bool accepted = baud_rate >= 115200 && baud_rate <= config_.max_baud_rate;
+
+        std::array<uint8_t, CrsfProtocol::CRSF_FRAME_SIZE_MAX> frame;
+        size_t frame_size = CrsfProtocol::buildSpeedResponseFrame(port_id, accepted, frame);
+        sendCrsfFrame(frame[0], frame[2], &frame[3], static_cast<uint8_t>(frame_size - 4));
+
+        if (accepted)
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            stats_.baud_rate = baud_rate;
+            stats_.speed_changes++;
+        }
+    }
+
+    void ElrsEmulator::sendLinkStats()
+    {
+        std::uniform_int_distribution<int> jitter(-3, 3);
+        uint8_t power_enum;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            power_enum = POWER_CRSF_ENUM[power_index_];
+        }
+
+        uint8_t payload[10];
+        payload[0] = static_cast<uint8_t>(62 + jitter(rng_)); // Uplink RSSI ant1 (-dBm)
+        payload[1] = static_cast<uint8_t>(65 + jitter(rng_)); // Uplink RSSI ant2 (-dBm)
+        payload[2] = static_cast<uint8_t>(std::min(100, 98 + jitter(rng_)));
+        payload[3] = static_cast<uint8_t>(static_cast<int8_t>(9 + jitter(rng_))); // Uplink SNR
+        payload[4] = 0;                                                           // Active antenna
+        payload[5] = 2;                                                           // RF mode
+        payload[6] = power_enum;
+        payload[7] = static_cast<uint8_t>(70 + jitter(rng_)); // Downlink RSSI (-dBm)
+        payload[8] = static_cast<uint8_t>(std::min(100, 97 + jitter(rng_)));
+        payload[9] = static_cast<uint8_t>(static_cast<int8_t>(7 + jitter(rng_)));
+
+        sendCrsfFrame(CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_FRAMETYPE_LINK_STATISTICS, payload, sizeof(payload));
+    }
+
+    void ElrsEmulator::sendBattery()
+    {
+        uint64_t sent;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            sent = stats_.frames_sent;
+        }
+
+        // 4S pack slowly discharging under a steady 12A load
+        uint16_t decivolts = static_cast<uint16_t>(168 - std::min<uint64_t>(sent / 200, 28));
+        uint16_t deciamps = 120;
+        uint32_t used_mah = static_cast<uint32_t>(std::min<uint64_t>(sent / 10, 1500));
+        uint8_t remaining = static_cast<uint8_t>(100 - used_mah * 100 / 1500);
+
+        uint8_t payload[8] = {
+            static_cast<uint8_t>(decivolts >> 8), static_cast<uint8_t>(decivolts),
+            static_cast<uint8_t>(deciamps >> 8), static_cast<uint8_t>(deciamps),
+            static_cast<uint8_t>(used_mah >> 16), static_cast<uint8_t>(used_mah >> 8), static_cast<uint8_t>(used_mah),
+            remaining};
+
+        sendCrsfFrame(CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_FRAMETYPE_BATTERY_SENSOR, payload, sizeof(payload));
+    }
+
+    void ElrsEmulator::sendSpectrum(bool include_bins, MspVersion version, MspEncapsulation encapsulation)
+    {
+        std::uniform_int_distribution<int> jitter(-3, 3);
+        uint8_t power_enum;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            power_enum = POWER_CRSF_ENUM[power_index_];
+        }
+
+        // Legacy 10-byte link block understood by TelemetryHandler, then spectrum bins
+        std::vector<uint8_t> payload = {
+            static_cast<uint8_t>(static_cast<int8_t>(-62 + jitter(rng_))),
+            static_cast<uint8_t>(static_cast<int8_t>(-65 + jitter(rng_))),
+            static_cast<uint8_t>(std::min(100, 98 + jitter(rng_))),
+            static_cast<uint8_t>(static_cast<int8_t>(9 + jitter(rng_))),
+            power_enum,
+            static_cast<uint8_t>(static_cast<int8_t>(-70 + jitter(rng_))),
+            static_cast<uint8_t>(std::min(100, 97 + jitter(rng_))),
+            static_cast<uint8_t>(static_cast<int8_t>(7 + jitter(rng_))),
+            0,
+            2};
+
+        if (include_bins)
+        {
+            // Noise floor with a moving interferer
+            int room = static_cast<int>(MspProtocol::MSP_MAX_PAYLOAD - payload.size());
+            int bins = std::max(0, std::min(config_.spectrum_bins, room));
+            int peak = bins > 0 ? static_cast<int>(rng_() % static_cast<uint32_t>(bins)) : 0;
+            std::uniform_int_distribution<int> floor(8, 20);
+            for (int i = 0; i < bins; ++i)
+            {
+                int level = floor(rng_) + std::max(0, 60 - 12 * std::abs(i - peak));
+                payload.push_back(static_cast<uint8_t>(std::min(level, 100)));
+            }
+        }
+
+        sendMspResponse(MspCommands::MSP_ELRS_TELEMETRY_PUSH, payload.data(), payload.size(), version, encapsulation);
+    }
+
+    void ElrsEmulator::sendTimingSync()
+    {
+        // Nominal interval as the module reports it; its actual slots run on a drifting clock
+        int64_t interval_ns = static_cast<int64_t>(1e9 / config_.packet_rate_hz);
+        int64_t slot_ns = static_cast<int64_t>(static_cast<double>(interval_ns) * (1.0 + config_.clock_drift_ppm * 1e-6));
+
+        Clock::time_point origin;
+        Clock::time_point last_rc;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            origin = slot_origin_;
+            last_rc = last_rc_time_;
+        }
+        if (last_rc <= origin)
+        {
+            return; // Nothing to measure until RC frames flow
+        }
+
+        // Lead of the last RC frame ahead of the next air slot, minus the safety margin
+        int64_t since_origin = std::chrono::duration_cast<std::chrono::nanoseconds>(last_rc - origin).count();
+        int64_t lead_ns = slot_ns - since_origin % slot_ns;
+        int64_t offset_ns = lead_ns - static_cast<int64_t>(config_.sync_margin_us) * 1000;
+
+        int32_t interval = static_cast<int32_t>(interval_ns / 100); // 0.1us units
+        int32_t offset = static_cast<int32_t>(offset_ns / 100);
+        uint8_t payload[11] = {
+            CRSF_ADDRESS_RADIO_TRANSMITTER,
+            CRSF_ADDRESS_CRSF_TRANSMITTER,
+            CRSF_RADIO_ID_SUBTYPE_TIMING,
+            static_cast<uint8_t>(interval >> 24), static_cast<uint8_t>(interval >> 16),
+            static_cast<uint8_t>(interval >> 8), static_cast<uint8_t>(interval),
+            static_cast<uint8_t>(offset >> 24), static_cast<uint8_t>(offset >> 16),
+            static_cast<uint8_t>(offset >> 8), static_cast<uint8_t>(offset)};
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            stats_.sync_frames++;
+            stats_.rc_lead_us = lead_ns / 1000;
+        }
+        sendCrsfFrame(CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_FRAMETYPE_RADIO_ID, payload, sizeof(payload));
+    }
+
+    void ElrsEmulator::sendCrsfFrame(uint8_t address, uint8_t type, const uint8_t *payload, uint8_t length)
+    {
+        std::vector<uint8_t> frame;
+        frame.reserve(static_cast<size_t>(length) + 4);
+        frame.push_back(address);
+        frame.push_back(static_cast<uint8_t>(length + 2)); // type + payload + crc
+        frame.push_back(type);
+        frame.insert(frame.end(), payload, payload + length);
+        frame.push_back(CrsfProtocol::crc8(&frame[2], static_cast<uint8_t>(length + 1)));
+        emit(frame, frame.size() - 1);
+    }
+
+    void ElrsEmulator::sendMspResponse(uint16_t function, const uint8_t *payload, size_t length, MspVersion version,
+                                       MspEncapsulation encapsulation, char direction)
+    {
+        if (encapsulation == MspEncapsulation::Crsf)
+        {
+            // One emit per chunk, so error and noise injection hit chunks independently
+            tunnel_sequence_ += static_cast<uint8_t>(MspTunnel::encode(
+                MspTunnel::CRSF_FRAMETYPE_MSP_RESP, CRSF_ADDRESS_RADIO_TRANSMITTER, CRSF_ADDRESS_RADIO_TRANSMITTER,
+                CRSF_ADDRESS_CRSF_TRANSMITTER, version, direction == '!', function, payload, length, tunnel_sequence_,
+                [this](const uint8_t *chunk, size_t size)
+                {
+                    std::vector<uint8_t> frame(chunk, chunk + size);
+                    emit(frame, frame.size() - 1);
+                    return true;
+                }));
+            return;
+        }
+
+        std::vector<uint8_t> frame;
+        if (MspProtocol::encode(version, direction, function, payload, length, frame) == 0)
+        {
+            return;
+        }
+        emit(frame, frame.size() - 1);
+    }
+
+    void ElrsEmulator::emit(std::vector<uint8_t> &frame, size_t crc_offset)
+    {
+        double error_ratio = config_.error_ratio;
+        if (config_.max_stable_baud_rate > 0)
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (stats_.baud_rate > config_.max_stable_baud_rate)
+            {
+                error_ratio = std::max(error_ratio, UNSTABLE_ERROR_RATIO);
+            }
+        }
+
+        bool corrupt = chance(error_ratio);
+        if (corrupt)
+        {
+            frame[crc_offset] ^= 0x5A;
+        }
+        if (chance(config_.noise_ratio))
+        {
+            std::uniform_int_distribution<int> noise_len(1, 8);
+            std::uniform_int_distribution<int> noise_byte(0, 255);
+            std::vector<uint8_t> noise(static_cast<size_t>(noise_len(rng_)));
+            for (auto &b : noise)
+            {
+                b = static_cast<uint8_t>(noise_byte(rng_));
+            }
+            frame.insert(frame.begin(), noise.begin(), noise.end());
+        }
+
+        size_t written = 0;
+#ifndef _WIN32
+        while (written < frame.size())
+        {
+            ssize_t n = ::write(master_fd_, frame.data() + written, frame.size() - written);
+            if (n <= 0)
+            {
+                break; // PTY buffer full: the host is not keeping up
+            }
+            written += static_cast<size_t>(n);
+        }
+#endif
+
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stats_.frames_sent++;
+        stats_.bytes_sent += written;
+        stats_.bytes_dropped += frame.size() - written;
+        if (corrupt)
+        {
+            stats_.frames_corrupted++;
+        }
+    }
+
+    bool ElrsEmulator::chance(double ratio)
+    {
+        if (ratio <= 0.0)
+        {
+            return false;
+        }
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < ratio;
+    }
+
+    void ElrsEmulator::setError(const std::string &error)
+    {
+        last_error_ = error;
+        std::cerr << "[EMULATOR_ERROR] " << error << std::endl;
+    }
+
+} // namespace ELRS
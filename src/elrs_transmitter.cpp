@@ -1,9 +1,11 @@
 #include "elrs_transmitter.h"
-#include "usb_bridge.h"
-#include "serial_bridge.h"
+#include "baud_negotiator.h"
+#include "transport.h"
 #include "telemetry_handler.h"
 #include "msp_commands.h"
+#include "msp_correlator.h"
 #include "crsf_protocol.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <mutex>
@@ -12,28 +14,53 @@
 namespace ELRS
 {
 
-    ElrsTransmitter::ElrsTransmitter(UsbBridge *usb_bridge)
-        : usb_bridge_(usb_bridge), serial_bridge_(nullptr), using_serial_mode_(false)
+    ElrsTransmitter::ElrsTransmitter(ITransport *transport)
+        : transport_(transport)
     {
-        // Initialize subsystems
-        telemetry_handler_ = std::make_unique<TelemetryHandler>(usb_bridge);
-        msp_commands_ = std::make_unique<MspCommands>(usb_bridge);
-
-        std::cout << "[INIT] ELRS_TX: Transmitter initialized (USB mode)" << std::endl;
-    }
-
-    ElrsTransmitter::ElrsTransmitter(SerialBridge *serial_bridge)
-        : usb_bridge_(nullptr), serial_bridge_(serial_bridge), using_serial_mode_(true)
-    {
-        // For serial mode, we'll create simplified telemetry and MSP handlers
-        // or implement serial versions later
-        std::cout << "[INIT] ELRS_TX: Transmitter initialized (Serial mode)" << std::endl;
-        std::cout << "[INIT] SERIAL_TX: Ready for CRSF over serial at 420kbaud" << std::endl;
+        // Telemetry and MSP share the transmitter's link regardless of backend; the
+        // link has a single reader no matter how many components consume telemetry
+        telemetry_handler_ = TelemetryHandler::acquire(transport);
+        write_scheduler_ = std::make_unique<WriteScheduler>(transport);
+        msp_commands_ = std::make_unique<MspCommands>(transport);
+        msp_commands_->setWriteScheduler(write_scheduler_.get());
+        msp_correlator_ = std::make_unique<MspCorrelator>(msp_commands_.get());
+        baud_negotiator_ = std::make_unique<BaudNegotiator>(transport, telemetry_handler_.get(), msp_commands_.get(),
+                                                            write_scheduler_.get());
+
+        // Seed the RC frame cache with the initial (safe) inputs
+        ControlInputs initial;
+        rc_frame_version_ = published_inputs_.load(initial);
+        rc_inputs_ = initial;
+        mapInputsToChannels(initial, rc_channels_);
+        CrsfProtocol::buildRcChannelsFrame(rc_channels_.data(), rc_frame_);
+
+        // MSP replies from the module complete outstanding correlated requests
+        msp_reply_callback_id_ = telemetry_handler_->addMspReplyCallback([this](const MspFrameView &frame)
+                                                                         { msp_correlator_->onReply(frame); });
+
+        // Phase-lock the RC loop to the module's air-packet timing when it reports it
+        timing_sync_callback_id_ = telemetry_handler_->addTimingSyncCallback([this](const TimingSync &sync)
+                                                                             {
+                                                                                 bool was_synced = scheduler_.isSynced();
+                                                                                 scheduler_.applyTimingSync(std::chrono::nanoseconds(sync.interval_ns),
+                                                                                                            std::chrono::nanoseconds(sync.offset_ns));
+                                                                                 if (!was_synced && scheduler_.isSynced())
+                                                                                 {
+                                                                                     std::cout << "[CRSF] TX_SYNC: Locked to module timing (interval "
+                                                                                               << sync.interval_ns / 1000 << "us)" << std::endl;
+                                                                                 } });
+
+        std::cout << "[INIT] ELRS_TX: Transmitter initialized ("
+                  << (transport ? transport->getTransportName() : std::string("no transport")) << " mode)" << std::endl;
     }
 
     ElrsTransmitter::~ElrsTransmitter()
     {
         stop();
+
+        // The handler may outlive us in another owner's hands; removal waits out a running callback
+        telemetry_handler_->removeCallback(timing_sync_callback_id_);
+        telemetry_handler_->removeCallback(msp_reply_callback_id_);
     }
 
     bool ElrsTransmitter::start()
@@ -43,43 +70,38 @@ namespace ELRS
             return true; // Already running
         }
 
-        // Check connection based on mode
-        if (using_serial_mode_)
+        if (!transport_ || !transport_->isConnected())
         {
-            if (!serial_bridge_ || !serial_bridge_->isConnected())
-            {
-                setError("Serial device not connected");
-                return false;
-            }
+            setError("Transport not connected");
+            return false;
         }
-        else
+
+        // RC frames and MSP traffic share the link through one prioritised writer
+        if (transport_->getBaudRate() != 0)
         {
-            if (!usb_bridge_ || !usb_bridge_->isConnected())
-            {
-                setError("USB device not connected");
-                return false;
-            }
+            write_scheduler_->setBaudRate(transport_->getBaudRate());
         }
+        write_scheduler_->start();
 
         running_.store(true);
         tx_thread_ = std::make_unique<std::thread>(&ElrsTransmitter::transmissionLoop, this);
 
-        // Start telemetry monitoring (USB mode only for now)
+        // Start telemetry monitoring on the same link
         if (telemetry_handler_)
         {
-            telemetry_handler_->start();
+            telemetry_started_ = telemetry_handler_->start();
         }
+        msp_correlator_->start();
 
-        if (using_serial_mode_)
-        {
-            std::cout << "[CRSF] SERIAL_TX_START: ✅ CRSF transmitter active at 250Hz (Serial mode)!" << std::endl;
-            std::cout << "[CRSF] SERIAL_ACTIVE: Sending channel data every 4ms over COM port" << std::endl;
-        }
-        else
+        // Climb to the fastest line rate the module and the link sustain
+        if (auto_baud_ && transport_->getBaudRate() != 0)
         {
-            std::cout << "[CRSF] TX_LOOP_START: [OK] CRSF transmitter active at 250Hz!" << std::endl;
-            std::cout << "[CRSF] TX_LOOP_ACTIVE: Sending channel data every 4ms" << std::endl;
+            baud_negotiator_->start();
         }
+
+        std::cout << "[CRSF] TX_LOOP_START: [OK] CRSF transmitter active at " << scheduler_.getRate() << "Hz ("
+                  << transport_->getTransportName() << ")!" << std::endl;
+        std::cout << "[CRSF] TX_LOOP_ACTIVE: Sending channel data every " << 1000000 / scheduler_.getRate() << "us" << std::endl;
         std::cout << "[CRSF] TX_CHANNELS: AETR + AUX mapping active" << std::endl;
 
         return true;
@@ -94,8 +116,16 @@ namespace ELRS
 
         running_.store(false);
 
-        // Stop telemetry first
-        telemetry_handler_->stop();
+        // The negotiator relies on telemetry to see replies, so it goes first
+        baud_negotiator_->stop();
+        msp_correlator_->stop();
+
+        // Release our hold on the shared reader; it keeps running for other owners
+        if (telemetry_started_)
+        {
+            telemetry_handler_->stop();
+            telemetry_started_ = false;
+        }
 
         // Wait for TX thread to finish
         if (tx_thread_ && tx_thread_->joinable())
@@ -104,27 +134,61 @@ namespace ELRS
         }
         tx_thread_.reset();
 
+        write_scheduler_->stop();
+
         std::cout << "🚁 TX_LOOP_STOP: ✅ CRSF transmission stopped" << std::endl;
         std::cout << "🚁 TX_LOOP_INACTIVE: Transmitter should show 'No Signal'" << std::endl;
     }
 
+    bool ElrsTransmitter::setPacketRate(int rate_hz)
+    {
+        if (!scheduler_.setRate(rate_hz))
+        {
+            setError("Unsupported packet rate: " + std::to_string(rate_hz) + "Hz");
+            return false;
+        }
+
+        std::cout << "[CRSF] TX_RATE: Packet rate set to " << rate_hz << "Hz" << std::endl;
+        return true;
+    }
+
+    bool ElrsTransmitter::setRcFrameConfig(const RcFrameConfig &config)
+    {
+        if (config.hot_sticks &&
+            (config.hot_channel_count == 0 || config.hot_channel_count >= CrsfProtocol::CRSF_CHANNEL_COUNT ||
+             config.full_refresh_interval < 1))
+        {
+            setError("Invalid hot-stick configuration");
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(inputs_mutex_);
+        rc_config_.store(config);
+
+        std::cout << "[CRSF] TX_FRAME_MODE: "
+                  << (config.hot_sticks ? "hot sticks (" + std::to_string(config.hot_channel_count) + " ch @ " +
+                                              std::to_string(CrsfProtocol::subsetBits(config.hot_resolution)) +
+                                              "-bit, full refresh every " + std::to_string(config.full_refresh_interval) + ")"
+                                        : std::string("full 16-channel frames"))
+                  << std::endl;
+        return true;
+    }
+
     void ElrsTransmitter::setControlInputs(const ControlInputs &inputs)
     {
         std::lock_guard<std::mutex> lock(inputs_mutex_);
 
         // Log significant control changes
-        static ControlInputs last_inputs;
-        static int input_counter = 0;
-
-        bool significant_change = (std::abs(inputs.roll - last_inputs.roll) > 0.1f) ||
-                                  (std::abs(inputs.pitch - last_inputs.pitch) > 0.1f) ||
-                                  (std::abs(inputs.yaw - last_inputs.yaw) > 0.1f) ||
-                                  (std::abs(inputs.throttle - last_inputs.throttle) > 0.1f) ||
-                                  (inputs.armed != last_inputs.armed);
+        bool significant_change = (std::abs(inputs.roll - last_logged_inputs_.roll) > 0.1f) ||
+                                  (std::abs(inputs.pitch - last_logged_inputs_.pitch) > 0.1f) ||
+                                  (std::abs(inputs.yaw - last_logged_inputs_.yaw) > 0.1f) ||
+                                  (std::abs(inputs.throttle - last_logged_inputs_.throttle) > 0.1f) ||
+                                  (inputs.armed != last_logged_inputs_.armed);
 
         control_inputs_ = inputs;
+        publishInputs();
 
-        if (significant_change || (++input_counter % 100 == 0))
+        if (significant_change || (++input_log_counter_ % 100 == 0))
         {
             std::cout << "🎮 CONTROL_INPUT: R=" << inputs.roll << " P=" << inputs.pitch
                       << " Y=" << inputs.yaw << " T=" << inputs.throttle;
@@ -134,16 +198,10 @@ namespace ELRS
             }
             std::cout << std::endl;
 
-            last_inputs = inputs;
+            last_logged_inputs_ = inputs;
         }
     }
 
-    ElrsTransmitter::ControlInputs ElrsTransmitter::getControlInputs() const
-    {
-        std::lock_guard<std::mutex> lock(inputs_mutex_);
-        return control_inputs_;
-    }
-
     void ElrsTransmitter::setArmed(bool armed)
     {
         std::lock_guard<std::mutex> lock(inputs_mutex_);
@@ -151,6 +209,7 @@ namespace ELRS
         if (armed != control_inputs_.armed)
         {
             control_inputs_.armed = armed;
+            publishInputs();
 
             if (armed)
             {
@@ -170,104 +229,150 @@ namespace ELRS
         std::lock_guard<std::mutex> lock(inputs_mutex_);
 
         // Emergency: Set everything to safe values
-        control_inputs_.roll = 0.0f;
-        control_inputs_.pitch = 0.0f;
-        control_inputs_.yaw = 0.0f;
-        control_inputs_.throttle = 0.0f;
-        control_inputs_.armed = false;
-        control_inputs_.mode1 = false;
-        control_inputs_.mode2 = false;
+        control_inputs_ = ControlInputs{};
+        publishInputs();
 
         std::cout << "🚨 EMERGENCY_STOP: All controls zeroed and disarmed!" << std::endl;
     }
 
+    void ElrsTransmitter::publishInputs()
+    {
+        // Caller holds inputs_mutex_, which keeps the seqlock single-writer
+        published_inputs_.store(control_inputs_);
+        armed_.store(control_inputs_.armed, std::memory_order_release);
+    }
+
     void ElrsTransmitter::transmissionLoop()
     {
-        std::array<uint8_t, 26> crsf_frame;
-        auto last_time = std::chrono::high_resolution_clock::now();
+        std::cout << "🚁 TX_LOOP: Started " << scheduler_.getRate() << "Hz transmission loop ("
+                  << transport_->getTransportName() << ")" << std::endl;
 
-        if (using_serial_mode_)
-        {
-            std::cout << "🚁 SERIAL_TX_LOOP: Started 250Hz transmission loop (Serial mode)" << std::endl;
-        }
-        else
-        {
-            std::cout << "🚁 TX_LOOP: Started 250Hz transmission loop (USB mode)" << std::endl;
-        }
+        scheduler_.start();
 
         while (running_.load())
         {
-            // Check connection based on mode
-            bool connected = false;
-            if (using_serial_mode_)
-            {
-                connected = serial_bridge_ && serial_bridge_->isConnected();
-            }
-            else
-            {
-                connected = usb_bridge_ && usb_bridge_->isConnected();
-            }
-
-            if (!connected)
+            if (!transport_->isConnected())
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                // Re-anchor so the outage is not counted as missed deadlines
+                scheduler_.start();
                 continue;
             }
 
-            // Build CRSF frame with current inputs
-            buildChannelFrame(crsf_frame);
+            // Sleep to the next absolute deadline, then send immediately
+            scheduler_.waitNextDeadline();
 
-            // Send frame to transmitter based on mode
-            bool write_success = false;
-            if (using_serial_mode_)
-            {
-                write_success = serial_bridge_->write(crsf_frame.data(), crsf_frame.size());
-            }
-            else
-            {
-                write_success = usb_bridge_->write(crsf_frame.data(), crsf_frame.size());
-            }
+            // Full or hot-stick frame, brought up to date with the current inputs
+            ByteSpan crsf_frame = nextRcFrame();
 
-            if (!write_success)
+            // Hand the frame to the writer; RC outranks every other class
+            if (!write_scheduler_->submit(WriteClass::Rc, crsf_frame.data(), crsf_frame.size()))
             {
                 // Don't spam errors, just continue
                 static int error_count = 0;
                 if (++error_count % 50 == 0)
-                { // Every 200ms
-                    if (using_serial_mode_)
-                    {
-                        std::cout << "⚠️  SERIAL_TX_ERROR: Failed to send CRSF frame (count: " << error_count << ")" << std::endl;
-                    }
-                    else
-                    {
-                        std::cout << "⚠️  TX_ERROR: Failed to send CRSF frame (count: " << error_count << ")" << std::endl;
-                    }
+                {
+                    std::cout << "⚠️  TX_ERROR: Failed to queue CRSF frame for " << transport_->getTransportName()
+                              << " (count: " << error_count << ")" << std::endl;
                 }
             }
 
-            // Maintain 250Hz (4ms interval)
-            auto now = std::chrono::high_resolution_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - last_time);
-            auto target_interval = std::chrono::microseconds(4000); // 4ms = 250Hz
+            scheduler_.recordSend();
+        }
 
-            if (elapsed < target_interval)
-            {
-                std::this_thread::sleep_for(target_interval - elapsed);
-            }
+        TxTimingStats stats = scheduler_.getStats();
+        std::cout << "🚁 TX_LOOP: Transmission loop exited (" << stats.frames << " frames, "
+                  << stats.missed_deadlines << " missed, jitter p99 " << stats.jitter_p99_us << "us)" << std::endl;
+    }
+
+    ByteSpan ElrsTransmitter::nextRcFrame()
+    {
+        const std::array<uint8_t, 26> &full_frame = buildChannelFrame();
+
+        RcFrameConfig config = rc_config_.load();
+        if (!config.hot_sticks)
+        {
+            rc_pending_dirty_ = 0;
+            return ByteSpan(full_frame.data(), full_frame.size());
+        }
+
+        // Switch changes must never wait for the periodic refresh
+        uint16_t hot_mask = static_cast<uint16_t>((1u << config.hot_channel_count) - 1);
+        bool cold_dirty = (rc_pending_dirty_ & ~hot_mask) != 0;
+
+        if (cold_dirty || ++frames_since_full_ >= config.full_refresh_interval)
+        {
+            frames_since_full_ = 0;
+            rc_pending_dirty_ = 0;
+            return ByteSpan(full_frame.data(), full_frame.size());
+        }
+
+        rc_subset_frames_.fetch_add(1, std::memory_order_relaxed);
+        return buildSubsetFrame(config);
+    }
 
-            last_time = std::chrono::high_resolution_clock::now();
+    ByteSpan ElrsTransmitter::buildSubsetFrame(const RcFrameConfig &config)
+    {
+        bool same_config = subset_frame_config_.hot_channel_count == config.hot_channel_count &&
+                           subset_frame_config_.hot_resolution == config.hot_resolution;
+        if (subset_frame_size_ == 0 || subset_frame_version_ != rc_frame_version_ || !same_config)
+        {
+            // Encoded from the float inputs so 12/13-bit modes keep their extra precision
+            std::array<float, 16> channels_us;
+            mapInputsToMicroseconds(rc_inputs_, channels_us);
+            subset_frame_size_ = CrsfProtocol::buildRcChannelsSubsetFrame(channels_us.data(), 0, config.hot_channel_count,
+                                                                          config.hot_resolution, subset_frame_);
+            subset_frame_version_ = rc_frame_version_;
+            subset_frame_config_ = config;
         }
 
-        std::cout << "🚁 TX_LOOP: Transmission loop exited" << std::endl;
+        return ByteSpan(subset_frame_.data(), subset_frame_size_);
     }
 
-    void ElrsTransmitter::buildChannelFrame(std::array<uint8_t, 26> &frame)
+    const std::array<uint8_t, 26> &ElrsTransmitter::buildChannelFrame()
     {
-        ControlInputs inputs = getControlInputs();
+        // Inputs untouched since the last frame: resend it as-is
+        if (published_inputs_.version() == rc_frame_version_)
+        {
+            rc_frames_reused_.fetch_add(1, std::memory_order_relaxed);
+            return rc_frame_;
+        }
+
+        // Lock-free snapshot; retries only if a producer is mid-write
+        ControlInputs &inputs = rc_inputs_;
+        rc_frame_version_ = published_inputs_.load(inputs);
 
-        // Build 16-channel array for CRSF
-        uint16_t channels[16];
+        std::array<uint16_t, 16> channels;
+        mapInputsToChannels(inputs, channels);
 
+        uint16_t dirty_mask = 0;
+        uint64_t dirty_count = 0;
+        for (size_t i = 0; i < channels.size(); ++i)
+        {
+            if (channels[i] != rc_channels_[i])
+            {
+                dirty_mask |= static_cast<uint16_t>(1u << i);
+                rc_channels_[i] = channels[i];
+                ++dirty_count;
+            }
+        }
+
+        if (dirty_mask == 0)
+        {
+            // New snapshot, but every channel quantised to the same value
+            rc_frames_reused_.fetch_add(1, std::memory_order_relaxed);
+            return rc_frame_;
+        }
+
+        CrsfProtocol::updateRcChannelsFrame(rc_channels_.data(), dirty_mask, rc_frame_);
+        rc_pending_dirty_ |= dirty_mask;
+        rc_channels_encoded_.fetch_add(dirty_count, std::memory_order_relaxed);
+
+        return rc_frame_;
+    }
+
+    void ElrsTransmitter::mapInputsToChannels(const ControlInputs &inputs, std::array<uint16_t, 16> &channels)
+    {
         // AETR mapping (Aileron, Elevator, Throttle, Rudder)
         channels[0] = CrsfProtocol::mapStickToChannel(inputs.roll);        // Aileron (Roll)
         channels[1] = CrsfProtocol::mapStickToChannel(inputs.pitch);       // Elevator (Pitch)
@@ -280,13 +385,33 @@ namespace ELRS
         channels[6] = inputs.mode2 ? CrsfProtocol::CRSF_CHANNEL_VALUE_MAX : CrsfProtocol::CRSF_CHANNEL_VALUE_MIN; // AUX3
 
         // Fill remaining channels with middle values
-        for (int i = 7; i < 16; i++)
+        for (size_t i = 7; i < channels.size(); i++)
         {
             channels[i] = CrsfProtocol::CRSF_CHANNEL_VALUE_MID;
         }
+    }
 
-        // Build CRSF frame
-        CrsfProtocol::buildRcChannelsFrame(channels, frame);
+    void ElrsTransmitter::mapInputsToMicroseconds(const ControlInputs &inputs, std::array<float, 16> &channels_us)
+    {
+        // Same AETR + AUX layout as mapInputsToChannels, without 11-bit quantisation
+        auto stick = [](float value)
+        {
+            return 1500.0f + std::max(-1.0f, std::min(1.0f, value)) * 512.0f;
+        };
+        const float low = CrsfProtocol::channelValueToMicroseconds(CrsfProtocol::CRSF_CHANNEL_VALUE_MIN);
+        const float high = CrsfProtocol::channelValueToMicroseconds(CrsfProtocol::CRSF_CHANNEL_VALUE_MAX);
+
+        channels_us[0] = stick(inputs.roll);
+        channels_us[1] = stick(inputs.pitch);
+        channels_us[2] = stick(inputs.throttle * 2.0f - 1.0f);
+        channels_us[3] = stick(inputs.yaw);
+        channels_us[4] = inputs.armed ? high : low;
+        channels_us[5] = inputs.mode1 ? high : low;
+        channels_us[6] = inputs.mode2 ? high : low;
+        for (size_t i = 7; i < channels_us.size(); i++)
+        {
+            channels_us[i] = CrsfProtocol::channelValueToMicroseconds(CrsfProtocol::CRSF_CHANNEL_VALUE_MID);
+        }
     }
 
     void ElrsTransmitter::setError(const std::string &error)
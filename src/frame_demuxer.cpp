@@ -0,0 +1,472 @@
+#include "frame_demuxer.h"
+#include "checksum.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ELRS_DEMUX_SSE2
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ELRS_DEMUX_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+namespace ELRS
+{
+
+    namespace
+    {
+        // Scalar fallback: one table lookup per byte instead of five compares
+        struct SyncTable
+        {
+            bool is_sync[256] = {};
+
+            SyncTable()
+            {
+                is_sync[static_cast<uint8_t>('$')] = true;
+                is_sync[FrameDemuxer::CRSF_SYNC_FLIGHT_CONTROLLER] = true;
+                is_sync[FrameDemuxer::CRSF_SYNC_RADIO_TRANSMITTER] = true;
+                is_sync[FrameDemuxer::CRSF_SYNC_RECEIVER] = true;
+                is_sync[FrameDemuxer::CRSF_SYNC_TRANSMITTER] = true;
+            }
+        };
+
+        const SyncTable sync_table;
+
+        size_t findSyncScalar(const uint8_t *data, size_t length)
+        {
+            size_t i = 0;
+            while (i < length && !sync_table.is_sync[data[i]])
+            {
+                ++i;
+            }
+            return i;
+        }
+
+#ifdef ELRS_DEMUX_SSE2
+        size_t findSyncSse2(const uint8_t *data, size_t length)
+        {
+            const __m128i dollar = _mm_set1_epi8('$');
+            const __m128i fc = _mm_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_FLIGHT_CONTROLLER));
+            const __m128i radio = _mm_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_RADIO_TRANSMITTER));
+            const __m128i rx = _mm_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_RECEIVER));
+            const __m128i tx = _mm_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_TRANSMITTER));
+
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, dollar), _mm_cmpeq_epi8(block, fc)),
+                                            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, radio), _mm_cmpeq_epi8(block, rx)),
+                                                         _mm_cmpeq_epi8(block, tx)));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+                if (mask != 0)
+                {
+#ifdef _MSC_VER
+                    unsigned long bit;
+                    _BitScanForward(&bit, mask);
+                    return i + bit;
+#else
+                    return i + static_cast<size_t>(__builtin_ctz(mask));
+#endif
+                }
+            }
+            return i + findSyncScalar(data + i, length - i);
+        }
+#endif
+
+#ifdef ELRS_DEMUX_AVX2
+        __attribute__((target("avx2"))) size_t findSyncAvx2(const uint8_t *data, size_t length)
+        {
+            const __m256i dollar = _mm256_set1_epi8('$');
+            const __m256i fc = _mm256_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_FLIGHT_CONTROLLER));
+            const __m256i radio = _mm256_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_RADIO_TRANSMITTER));
+            const __m256i rx = _mm256_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_RECEIVER));
+            const __m256i tx = _mm256_set1_epi8(static_cast<char>(FrameDemuxer::CRSF_SYNC_TRANSMITTER));
+
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                __m256i hits = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, dollar), _mm256_cmpeq_epi8(block, fc)),
+                    _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, radio), _mm256_cmpeq_epi8(block, rx)),
+                                    _mm256_cmpeq_epi8(block, tx)));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+                if (mask != 0)
+                {
+                    return i + static_cast<size_t>(__builtin_ctz(mask));
+                }
+            }
+            return i + findSyncSse2(data + i, length - i);
+        }
+#endif
+
+        using FindSyncFn = size_t (*)(const uint8_t *, size_t);
+
+        FindSyncFn selectFindSync()
+        {
+#if defined(ELRS_DEMUX_AVX2)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return findSyncAvx2;
+            }
+#endif
+#if defined(ELRS_DEMUX_SSE2)
+            return findSyncSse2;
+#else
+            return findSyncScalar;
+#endif
+        }
+
+        // Chosen once; the CPU does not change under us
+        const FindSyncFn find_sync = selectFindSync();
+    }
+
+    void FrameDemuxer::feed(const uint8_t *data, size_t length)
+    {
+        if (!data || length == 0)
+        {
+            return;
+        }
+
+        size_t pos = 0;
+
+        // Finish a frame split across feeds by topping the staging buffer up with
+        // only as many bytes as that frame still needs
+        while (pending_size_ > 0 && pos < length)
+        {
+            size_t needed = bytesNeeded(pending_.data(), pending_size_);
+            if (needed > pending_.size())
+            {
+                pending_.resize(needed);
+            }
+            size_t take = std::min(needed - pending_size_, length - pos);
+            std::memcpy(pending_.data() + pending_size_, data + pos, take);
+            pending_size_ += take;
+            pos += take;
+            drainPending();
+        }
+
+        if (pos == length)
+        {
+            return;
+        }
+
+        // Fast path: frames are dispatched straight out of the caller's buffer
+        size_t consumed = scan(data + pos, length - pos);
+        size_t tail = length - pos - consumed;
+        if (tail > 0)
+        {
+            if (tail > pending_.size())
+            {
+                pending_.resize(tail);
+            }
+            std::memcpy(pending_.data(), data + pos + consumed, tail);
+            pending_size_ = tail;
+        }
+    }
+
+    DemuxerStats FrameDemuxer::getStats() const
+    {
+        DemuxerStats stats;
+        stats.crsf_frames = crsf_frames_.load(std::memory_order_relaxed);
+        stats.msp_frames = msp_frames_.load(std::memory_order_relaxed);
+        stats.crc_errors = crc_errors_.load(std::memory_order_relaxed);
+        stats.discarded_bytes = discarded_bytes_.load(std::memory_order_relaxed);
+        stats.msp_tunnelled = msp_tunnelled_.load(std::memory_order_relaxed);
+        stats.tunnel_errors = msp_reassembler_.getErrors();
+        return stats;
+    }
+
+    size_t FrameDemuxer::scan(const uint8_t *data, size_t length)
+    {
+        size_t pos = 0;
+        uint64_t discarded = 0;
+
+        while (pos < length)
+        {
+            if (!isSyncByte(data[pos]))
+            {
+                // Skip line noise a vector at a time
+                size_t skip = find_sync(data + pos, length - pos);
+                pos += skip;
+                discarded += skip;
+                continue;
+            }
+
+            size_t frame_size = 0;
+            ParseResult result = parseFrame(data + pos, length - pos, frame_size);
+            if (result == ParseResult::Incomplete)
+            {
+                break;
+            }
+            if (result == ParseResult::Invalid)
+            {
+                // Resync one byte later: the real frame may start inside this one
+                ++pos;
+                ++discarded;
+                continue;
+            }
+
+            if (data[pos] == '$')
+            {
+                dispatchMsp(data + pos, frame_size);
+            }
+            else
+            {
+                dispatchCrsf(data + pos, frame_size);
+            }
+            pos += frame_size;
+        }
+
+        if (discarded > 0)
+        {
+            discarded_bytes_.fetch_add(discarded, std::memory_order_relaxed);
+        }
+        return pos;
+    }
+
+    FrameDemuxer::ParseResult FrameDemuxer::parseFrame(const uint8_t *data, size_t available, size_t &frame_size)
+    {
+        return data[0] == '$' ? parseMsp(data, available, frame_size) : parseCrsf(data, available, frame_size);
+    }
+
+    FrameDemuxer::ParseResult FrameDemuxer::parseCrsf(const uint8_t *data, size_t available, size_t &frame_size)
+    {
+        // [address] [length] [type] [payload...] [crc], length = type + payload + crc
+        if (available < 2)
+        {
+            return ParseResult::Incomplete;
+        }
+
+        uint8_t length = data[1];
+        if (length < 2 || length > CRSF_MAX_LENGTH)
+        {
+            return ParseResult::Invalid;
+        }
+        if (available < static_cast<size_t>(length) + 2)
+        {
+            return ParseResult::Incomplete;
+        }
+
+        if (Checksum::crc8DvbS2(&data[2], length - 1u) != data[length + 1])
+        {
+            crc_errors_.fetch_add(1, std::memory_order_relaxed);
+            return ParseResult::Invalid;
+        }
+
+        frame_size = static_cast<size_t>(length) + 2;
+        return ParseResult::Frame;
+    }
+
+    FrameDemuxer::ParseResult FrameDemuxer::parseMsp(const uint8_t *data, size_t available, size_t &frame_size)
+    {
+        // v1: '$' 'M' [direction] [size] [function] [payload...] [xor]
+        //     size 0xFF: [function] [size16] [payload...] [xor] (jumbo)
+        // v2: '$' 'X' [direction] [flags] [function16] [size16] [payload...] [crc8]
+        if (available < 2)
+        {
+            return ParseResult::Incomplete;
+        }
+        if (data[1] != 'M' && data[1] != 'X')
+        {
+            return ParseResult::Invalid;
+        }
+        if (available < 3)
+        {
+            return ParseResult::Incomplete;
+        }
+        if (!MspProtocol::isDirection(data[2]))
+        {
+            return ParseResult::Invalid;
+        }
+
+        size_t total = mspFrameSize(data, available);
+        if (total == 0)
+        {
+            return ParseResult::Incomplete; // Header not complete yet
+        }
+        if (total > MspProtocol::MSP_V2_HEADER_SIZE + MspProtocol::MSP_MAX_PAYLOAD + 1)
+        {
+            return ParseResult::Invalid; // Implausible size: a false sync byte
+        }
+        if (available < total)
+        {
+            return ParseResult::Incomplete;
+        }
+
+        // Both checksums cover everything between the direction byte and themselves
+        uint8_t expected = data[1] == 'X' ? Checksum::mspV2Crc(data + 3, total - 4) : Checksum::mspV1Xor(data + 3, total - 4);
+        if (expected != data[total - 1])
+        {
+            crc_errors_.fetch_add(1, std::memory_order_relaxed);
+            return ParseResult::Invalid;
+        }
+
+        frame_size = total;
+        return ParseResult::Frame;
+    }
+
+    size_t FrameDemuxer::mspFrameSize(const uint8_t *data, size_t available)
+    {
+        if (data[1] == 'X')
+        {
+            if (available < MspProtocol::MSP_V2_HEADER_SIZE)
+            {
+                return 0;
+            }
+            size_t size = static_cast<size_t>(data[6]) | static_cast<size_t>(data[7]) << 8;
+            return MspProtocol::MSP_V2_HEADER_SIZE + size + 1;
+        }
+
+        if (available < 4)
+        {
+            return 0;
+        }
+        if (data[3] != MspProtocol::MSP_V1_JUMBO_SIZE)
+        {
+            return MspProtocol::MSP_V1_HEADER_SIZE + data[3] + 1;
+        }
+        if (available < MspProtocol::MSP_V1_JUMBO_HEADER_SIZE)
+        {
+            return 0;
+        }
+        size_t size = static_cast<size_t>(data[5]) | static_cast<size_t>(data[6]) << 8;
+        return MspProtocol::MSP_V1_JUMBO_HEADER_SIZE + size + 1;
+    }
+
+    size_t FrameDemuxer::bytesNeeded(const uint8_t *data, size_t available)
+    {
+        if (data[0] == '$')
+        {
+            if (available < 3)
+            {
+                return 3;
+            }
+            if (data[1] != 'M' && data[1] != 'X')
+            {
+                return available; // parseMsp() rejects it as it stands
+            }
+
+            size_t total = mspFrameSize(data, available);
+            if (total == 0)
+            {
+                return data[1] == 'X' ? MspProtocol::MSP_V2_HEADER_SIZE
+                                      : (available < 4 ? 4 : MspProtocol::MSP_V1_JUMBO_HEADER_SIZE);
+            }
+            // Never wait for more than the largest frame parseMsp() would accept
+            return std::min(total, MspProtocol::MSP_V2_HEADER_SIZE + MspProtocol::MSP_MAX_PAYLOAD + 1);
+        }
+        return available < 2 ? 2 : static_cast<size_t>(data[1]) + 2;
+    }
+
+    bool FrameDemuxer::isSyncByte(uint8_t byte)
+    {
+        return sync_table.is_sync[byte];
+    }
+
+    void FrameDemuxer::dispatchCrsf(const uint8_t *frame, size_t frame_size)
+    {
+        crsf_frames_.fetch_add(1, std::memory_order_relaxed);
+
+        CrsfFrameView view;
+        view.address = frame[0];
+        view.type = frame[2];
+        view.payload = ByteSpan(frame + 3, frame_size - 4);
+        view.raw = ByteSpan(frame, frame_size);
+
+        const CrsfHandler &handler = crsf_handlers_[view.type];
+        if (handler)
+        {
+            handler(view);
+        }
+        else if (MspTunnel::isMspFrameType(view.type))
+        {
+            dispatchTunnelledMsp(view);
+        }
+        else if (default_crsf_handler_)
+        {
+            default_crsf_handler_(view);
+        }
+    }
+
+    void FrameDemuxer::dispatchMsp(const uint8_t *frame, size_t frame_size)
+    {
+        msp_frames_.fetch_add(1, std::memory_order_relaxed);
+
+        MspFrameView view;
+        view.direction = static_cast<char>(frame[2]);
+        view.raw = ByteSpan(frame, frame_size);
+
+        size_t header;
+        if (frame[1] == 'X')
+        {
+            view.version = MspVersion::V2;
+            view.flags = frame[3];
+            view.function = static_cast<uint16_t>(frame[4] | frame[5] << 8);
+            header = MspProtocol::MSP_V2_HEADER_SIZE;
+        }
+        else
+        {
+            view.function = frame[4];
+            header = frame[3] == MspProtocol::MSP_V1_JUMBO_SIZE ? MspProtocol::MSP_V1_JUMBO_HEADER_SIZE
+                                                                 : MspProtocol::MSP_V1_HEADER_SIZE;
+        }
+        view.payload = ByteSpan(frame + header, frame_size - header - 1);
+        routeMsp(view);
+    }
+
+    void FrameDemuxer::dispatchTunnelledMsp(const CrsfFrameView &chunk)
+    {
+        if (!msp_reassembler_.feed(chunk.type, chunk.payload.data(), chunk.payload.size()))
+        {
+            return; // Waiting for more chunks, or dropped
+        }
+
+        msp_frames_.fetch_add(1, std::memory_order_relaxed);
+        msp_tunnelled_.fetch_add(1, std::memory_order_relaxed);
+
+        MspFrameView view;
+        if (msp_reassembler_.frameType() == MspTunnel::CRSF_FRAMETYPE_MSP_RESP)
+        {
+            view.direction = msp_reassembler_.error() ? '!' : '>';
+        }
+        else
+        {
+            view.direction = '<';
+        }
+        view.version = msp_reassembler_.version();
+        view.flags = msp_reassembler_.flags();
+        view.function = msp_reassembler_.function();
+        view.payload = msp_reassembler_.payload();
+        view.raw = view.payload;
+        view.crsf_origin = msp_reassembler_.origin();
+        routeMsp(view);
+    }
+
+    void FrameDemuxer::routeMsp(const MspFrameView &view)
+    {
+        const MspHandler *handler = view.function < msp_handlers_.size() ? &msp_handlers_[view.function] : nullptr;
+        if (handler && *handler)
+        {
+            (*handler)(view);
+        }
+        else if (default_msp_handler_)
+        {
+            default_msp_handler_(view);
+        }
+    }
+
+    void FrameDemuxer::drainPending()
+    {
+        size_t consumed = scan(pending_.data(), pending_size_);
+        if (consumed > 0)
+        {
+            std::memmove(pending_.data(), pending_.data() + consumed, pending_size_ - consumed);
+            pending_size_ -= consumed;
+        }
+    }
+
+} // namespace ELRS
@@ -2,6 +2,7 @@
 #include "elrs_transmitter.h"
 #include "telemetry_handler.h"
 #include "msp_commands.h"
+#include "msp_correlator.h"
 #include "log_manager.h"
 #include "radio_state.h"
 
@@ -34,10 +35,13 @@ namespace ELRS
               currentScreen_(ScreenType::Main),
               running_(false),
               initialized_(false),
+              callbackGuard_(std::make_shared<CallbackGuard>()),
               lastUpdate_(std::chrono::steady_clock::now()),
               updateIntervalMs_(DEFAULT_UPDATE_INTERVAL_MS),
               telemetryHandler_(nullptr),
+              telemetryStarted_(false),
               mspCommands_(nullptr),
+              mspCorrelator_(nullptr),
               refreshThreadRunning_(false),
               autoLinkStatsRunning_(false),
               spectrumRequestRunning_(false),
@@ -135,6 +139,7 @@ namespace ELRS
             transmitter_ = std::move(transmitter);
             telemetryHandler_ = transmitter_ ? transmitter_->getTelemetryHandler() : nullptr;
             mspCommands_ = transmitter_ ? transmitter_->getMspCommands() : nullptr;
+            mspCorrelator_ = transmitter_ ? transmitter_->getMspCorrelator() : nullptr;
         }
 
         void FTXUIManager::scheduleAutomaticPowerTest(std::chrono::milliseconds duration)
@@ -215,7 +220,13 @@ namespace ELRS
                 mainContainer_->Add(currentComponent_);
             }
 
-            auto mainComponent = CatchEvent(mainContainer_, [this](Event event)
+            // Every panel drawn in one pass reads the same RadioState version
+            auto frame = Renderer(mainContainer_, [this]
+                                  {
+                                      frameSnapshot_ = RadioState::getInstance().getSnapshot();
+                                      return mainContainer_->Render(); });
+
+            auto mainComponent = CatchEvent(frame, [this](Event event)
                                             { return handleGlobalKey(event); });
 
             screen_.Loop(mainComponent);
@@ -234,6 +245,12 @@ namespace ELRS
 
             running_ = false;
 
+            // Late MSP completions (including those cancelled by the correlator's stop()) must not touch us
+            {
+                std::lock_guard<std::mutex> lock(callbackGuard_->mutex);
+                callbackGuard_->alive = false;
+            }
+
             stopTxTest(false);
             stopSpectrumRequestThread();
             stopAutoLinkStatsThread();
@@ -381,7 +398,6 @@ namespace ELRS
             auto renderer = Renderer([this]
                                      {
                                           auto &radioState = RadioState::getInstance();
-                                          auto telemetry = radioState.getLiveTelemetry();
 
                                           auto rssiHistory = radioState.getRSSIHistory(60);
                                           auto linkHistory = radioState.getLinkQualityHistory(60);
@@ -432,7 +448,15 @@ namespace ELRS
                                 auto rssiHistory = radioState.getRSSIHistory(120);
                                 auto linkHistory = radioState.getLinkQualityHistory(120);
                                 auto powerHistory = radioState.getTxPowerHistory(120);
-                                auto telemetry = radioState.getLiveTelemetry();
+
+                                // Whole-session view from the 1 min rollup tier: worst link quality per minute
+                                std::vector<int> sessionLinkMin;
+                                radioState.visitHistoryRollups(HistoryMetric::LinkQuality, HistoryResolution::Minute, 120,
+                                                               [&sessionLinkMin](const HistoryRollup &bucket)
+                                                               { sessionLinkMin.push_back(bucket.min); });
+
+                                const RadioSnapshot &snapshot = frameSnapshot();
+                                const LiveTelemetry &telemetry = snapshot.telemetry;
 
                                 constexpr double bandStartMHz = 2400.0;
                                 constexpr double bandEndMHz = 2483.5;
@@ -448,9 +472,9 @@ namespace ELRS
                                 double freqStep = (sampleCount > 1) ? (bandEndMHz - bandStartMHz) / static_cast<double>(sampleCount - 1) : 0.0;
                                 double peakFrequency = bandStartMHz + freqStep * peakIndex;
 
-                                auto binsReported = radioState.getSpectrumBinCount();
+                                auto binsReported = snapshot.spectrum->size();
                                 auto now = std::chrono::steady_clock::now();
-                                auto lastUpdate = radioState.getSpectrumLastUpdate();
+                                auto lastUpdate = snapshot.spectrumLastUpdate;
                                 auto ageMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate).count();
                                 if (ageMs < 0)
                                 {
@@ -531,6 +555,26 @@ namespace ELRS
 
                                 std::stringstream linkSummary;
                                 linkSummary << "RSSI " << telemetry.rssi1 << " dBm | LQ " << telemetry.linkQuality << "% | SNR " << telemetry.snr << " dB";
+
+                                // Recent window aggregated from the session store
+                                const auto windowEnd = std::chrono::system_clock::now();
+                                const auto windowStart = windowEnd - std::chrono::minutes(10);
+                                const auto &store = radioState.getTelemetryStore();
+                                auto rssiWindow = store.aggregate(TelemetryColumn::Rssi1, windowStart, windowEnd);
+                                auto linkWindow = store.aggregate(TelemetryColumn::LinkQuality, windowStart, windowEnd);
+                                std::stringstream windowSummary;
+                                if (rssiWindow.count > 0)
+                                {
+                                    windowSummary << "Last 10 min: RSSI " << static_cast<int>(rssiWindow.min) << " / "
+                                                  << std::fixed << std::setprecision(1) << rssiWindow.mean() << " / "
+                                                  << static_cast<int>(rssiWindow.max) << " dBm (min/avg/max) | worst LQ "
+                                                  << static_cast<int>(linkWindow.min) << "%";
+                                }
+                                else
+                                {
+                                    windowSummary << "Last 10 min: no telemetry";
+                                }
+
                                 ftxui::Color linkColor = ftxui::Color::Yellow;
                                 if (telemetry.linkQuality >= 80)
                                 {
@@ -553,10 +597,14 @@ namespace ELRS
                                                              separator(),
                                                              text("TX Power Trend") | bold,
                                                              createSparkline(powerHistory) | flex,
+                                                             separator(),
+                                                             text("Session Link Quality (worst per minute, " + std::to_string(sessionLinkMin.size()) + " min)") | bold,
+                                                             createSparkline(sessionLinkMin) | flex,
                                                          }) |
                                                              flex,
                                                          separator(),
                                                          text(linkSummary.str()) | center | color(linkColor) | bold,
+                                                         text(windowSummary.str()) | center | dim,
                                                      }) |
                                                      border | flex;
 
@@ -899,7 +947,42 @@ namespace ELRS
         {
             auto checkButton = Button("Check for Updates", [this]
                                       {
-                                          if (mspCommands_)
+                                          if (mspCorrelator_ && mspCorrelator_->isRunning())
+                                          {
+                                              // Report the module's answer (or its absence) instead of just the send
+                                              const uint8_t payload[] = {0x00, 0xEA}; // Same ping as sendDeviceDiscovery()
+                                              updateStatusMessage_ = "Discovery request sent. Awaiting response.";
+                                              mspCorrelator_->request(MspCommands::MSP_DEVICE_DISCOVERY, payload, sizeof(payload),
+                                                                      [this, guard = std::weak_ptr<CallbackGuard>(callbackGuard_)](const MspReply &reply)
+                                                                      {
+                                                                          // Runs on the parser or timer thread: build the text here, assign it on the UI thread
+                                                                          std::string message;
+                                                                          if (reply.ok())
+                                                                          {
+                                                                              message = "Module answered in " +
+                                                                                        std::to_string(reply.round_trip.count() / 1000) + "ms.";
+                                                                          }
+                                                                          else
+                                                                          {
+                                                                              message = reply.status == MspStatus::Timeout ? "No response from module." : "Device discovery failed.";
+                                                                          }
+
+                                                                          auto live = guard.lock();
+                                                                          if (!live)
+                                                                          {
+                                                                              return;
+                                                                          }
+                                                                          std::lock_guard<std::mutex> lock(live->mutex);
+                                                                          if (!live->alive)
+                                                                          {
+                                                                              return;
+                                                                          }
+                                                                          screen_.Post([this, message]
+                                                                                       { updateStatusMessage_ = message; });
+                                                                          screen_.PostEvent(Event::Custom);
+                                                                      });
+                                          }
+                                          else if (mspCommands_)
                                           {
                                               bool success = mspCommands_->sendDeviceDiscovery();
                                               updateStatusMessage_ = success ? "Discovery request sent. Awaiting response." : "Device discovery failed.";
@@ -1110,9 +1193,9 @@ namespace ELRS
 
         Element FTXUIManager::createDeviceInfo()
         {
-            auto &radioState = RadioState::getInstance();
-            auto config = radioState.getDeviceConfiguration();
-            auto status = radioState.getConnectionStatusString();
+            const RadioSnapshot &snapshot = frameSnapshot();
+            const DeviceConfiguration &config = *snapshot.device;
+            auto status = RadioState::connectionStatusToString(snapshot.connectionStatus);
 
             std::stringstream vidpid;
             vidpid << std::uppercase << std::hex << std::setfill('0') << std::setw(4) << config.vid << ":" << std::setw(4) << config.pid;
@@ -1125,6 +1208,7 @@ namespace ELRS
                        hbox({text("Serial: "), text(config.serialNumber.empty() ? "N/A" : config.serialNumber)}),
                        hbox({text("Firmware: "), text(config.firmwareVersion.empty() ? "Unknown" : config.firmwareVersion)}),
                        hbox({text("VID:PID: "), text(vidpid.str())}),
+                       hbox({text("Baud: "), text(std::to_string(config.baudRate))}),
                        hbox({text("Status: "), text(status) | color(status == "Connected" ? ftxui::Color::Green : ftxui::Color::Yellow)}),
                    }) |
                    border;
@@ -1132,8 +1216,7 @@ namespace ELRS
 
         Element FTXUIManager::createConnectionStats()
         {
-            auto &radioState = RadioState::getInstance();
-            auto telemetry = radioState.getLiveTelemetry();
+            const LiveTelemetry &telemetry = frameSnapshot().telemetry;
 
             return vbox({
                        text("Connection Statistics") | bold,
@@ -1271,9 +1354,11 @@ namespace ELRS
 
         std::vector<int> FTXUIManager::generateSpectrumSamples(bool *usingRealData) const
         {
-            auto &radioState = RadioState::getInstance();
-            auto observed = radioState.getSpectrumData();
-            bool fresh = !observed.empty() && radioState.isSpectrumFresh(SPECTRUM_FRESHNESS_WINDOW_MS);
+            const RadioSnapshot &snapshot = frameSnapshot();
+            const std::vector<int> &observed = *snapshot.spectrum;
+            auto spectrumAge = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                                     snapshot.spectrumLastUpdate);
+            bool fresh = !observed.empty() && spectrumAge.count() <= SPECTRUM_FRESHNESS_WINDOW_MS;
 
             if (usingRealData)
             {
@@ -1288,7 +1373,7 @@ namespace ELRS
             constexpr int sampleCount = 96;
             std::vector<int> samples(sampleCount, 0);
 
-            auto telemetry = radioState.getLiveTelemetry();
+            const LiveTelemetry &telemetry = snapshot.telemetry;
 
             double qualityFactor = telemetry.linkQuality / 100.0;
             if (qualityFactor < 0.0)
@@ -1321,13 +1406,23 @@ namespace ELRS
             return samples;
         }
 
+        const RadioSnapshot &FTXUIManager::frameSnapshot() const
+        {
+            // Before the first render pass, fall back to the current state
+            if (!frameSnapshot_)
+            {
+                frameSnapshot_ = RadioState::getInstance().getSnapshot();
+            }
+            return *frameSnapshot_;
+        }
+
         std::string FTXUIManager::getConnectionInfo()
         {
-            auto &radioState = RadioState::getInstance();
-            auto telemetry = radioState.getLiveTelemetry();
+            const RadioSnapshot &snapshot = frameSnapshot();
+            const LiveTelemetry &telemetry = snapshot.telemetry;
 
             std::stringstream ss;
-            ss << "Status: " << radioState.getConnectionStatusString();
+            ss << "Status: " << RadioState::connectionStatusToString(snapshot.connectionStatus);
             ss << " | LQ: " << telemetry.linkQuality << "%";
             ss << " | Voltage: " << formatVoltage(telemetry.voltage);
             ss << " | Updated: " << formatTimePoint(telemetry.lastUpdate);
@@ -1336,11 +1431,11 @@ namespace ELRS
 
         std::string FTXUIManager::getDeviceStatus()
         {
-            auto &radioState = RadioState::getInstance();
-            auto config = radioState.getDeviceConfiguration();
+            const RadioSnapshot &snapshot = frameSnapshot();
+            const DeviceConfiguration &config = *snapshot.device;
             std::stringstream ss;
             ss << (config.productName.empty() ? "ELRS Device" : config.productName) << " - "
-               << radioState.getConnectionStatusString();
+               << RadioState::connectionStatusToString(snapshot.connectionStatus);
             return ss.str();
         }
 
@@ -1419,45 +1514,46 @@ namespace ELRS
                 return;
             }
 
-            telemetryHandler_->setLinkStatsCallback([this](const LinkStats &stats)
-                                                    {
-                                                         auto telemetry = RadioState::getInstance().getLiveTelemetry();
-                                                         telemetry.rssi1 = stats.rssi1;
-                                                         telemetry.rssi2 = stats.rssi2;
-                                                         telemetry.linkQuality = stats.link_quality;
-                                                         telemetry.snr = stats.snr;
-                                                         telemetry.txPower = stats.tx_power;
-                                                         telemetry.isValid = stats.valid;
-                                                         RadioState::getInstance().updateTelemetry(telemetry);
-
-                                                         if (running_)
-                                                         {
-                                                             screen_.PostEvent(Event::Custom);
-                                                         } });
+            // Re-running setup replaces our callbacks rather than stacking them
+            removeTelemetryCallbacks();
 
-            telemetryHandler_->setBatteryCallback([this](const BatteryInfo &battery)
-                                                  {
-                                                       auto telemetry = RadioState::getInstance().getLiveTelemetry();
-                                                       telemetry.voltage = battery.voltage_mv / 1000.0;
-                                                       telemetry.current = battery.current_ma / 1000.0;
-                                                       telemetry.isValid = battery.valid;
-                                                       RadioState::getInstance().updateTelemetry(telemetry);
+            telemetryCallbacks_.push_back(telemetryHandler_->addLinkStatsCallback([this](const LinkStats &stats)
+                                                                                  {
+                                                                                       RadioState::getInstance()
+                                                                                           .beginUpdate()
+                                                                                           .rssi(stats.rssi1, stats.rssi2)
+                                                                                           .linkQuality(stats.link_quality)
+                                                                                           .snr(stats.snr)
+                                                                                           .txPower(stats.tx_power)
+                                                                                           .commit();
 
-                                                       if (running_)
-                                                       {
-                                                           screen_.PostEvent(Event::Custom);
-                                                       } });
+                                                                                       if (running_)
+                                                                                       {
+                                                                                           screen_.PostEvent(Event::Custom);
+                                                                                       } }));
 
-            telemetryHandler_->setSpectrumCallback([this](const std::vector<int> &)
-                                                   {
-                                                        if (running_)
-                                                        {
-                                                            screen_.PostEvent(Event::Custom);
-                                                        } });
+            telemetryCallbacks_.push_back(telemetryHandler_->addBatteryCallback([this](const BatteryInfo &battery)
+                                                                                {
+                                                                                     RadioState::getInstance()
+                                                                                         .beginUpdate()
+                                                                                         .battery(battery.voltage_mv / 1000.0, battery.current_ma / 1000.0)
+                                                                                         .commit();
+
+                                                                                     if (running_)
+                                                                                     {
+                                                                                         screen_.PostEvent(Event::Custom);
+                                                                                     } }));
 
-            if (!telemetryHandler_->isRunning())
+            telemetryCallbacks_.push_back(telemetryHandler_->addSpectrumCallback([this](const std::vector<int> &)
+                                                                                 {
+                                                                                      if (running_)
+                                                                                      {
+                                                                                          screen_.PostEvent(Event::Custom);
+                                                                                      } }));
+
+            if (!telemetryStarted_)
             {
-                telemetryHandler_->start();
+                telemetryStarted_ = telemetryHandler_->start();
             }
 
             telemetryActive_ = telemetryHandler_->isRunning();
@@ -1471,13 +1567,25 @@ namespace ELRS
         void FTXUIManager::teardownTelemetry()
         {
             stopSpectrumRequestThread();
-            if (telemetryHandler_ && telemetryHandler_->isRunning())
+            removeTelemetryCallbacks();
+            if (telemetryHandler_ && telemetryStarted_)
             {
                 telemetryHandler_->stop();
+                telemetryStarted_ = false;
             }
             telemetryActive_ = false;
         }
 
+        void FTXUIManager::removeTelemetryCallbacks()
+        {
+            // Waits for a callback already running on the parser thread
+            for (auto id : telemetryCallbacks_)
+            {
+                telemetryHandler_->removeCallback(id);
+            }
+            telemetryCallbacks_.clear();
+        }
+
         Element FTXUIManager::buildTelemetryGrid()
         {
             auto telemetry = RadioState::getInstance().getLiveTelemetry();
@@ -1514,6 +1622,9 @@ namespace ELRS
             refreshThreadRunning_ = true;
             refreshThread_ = std::thread([this]
                                          {
+                                             // Redraw when the radio state moved on; otherwise once a second so ages and clocks keep ticking
+                                             uint64_t drawnVersion = 0;
+                                             auto lastPost = std::chrono::steady_clock::now();
                                              while (refreshThreadRunning_)
                                              {
                                                  std::this_thread::sleep_for(std::chrono::milliseconds(updateIntervalMs_));
@@ -1521,6 +1632,15 @@ namespace ELRS
                                                  {
                                                      break;
                                                  }
+
+                                                 uint64_t version = RadioState::getInstance().getVersion();
+                                                 auto now = std::chrono::steady_clock::now();
+                                                 if (version == drawnVersion && now - lastPost < std::chrono::seconds(1))
+                                                 {
+                                                     continue;
+                                                 }
+                                                 drawnVersion = version;
+                                                 lastPost = now;
                                                  screen_.PostEvent(Event::Custom);
                                              } });
         }
@@ -1940,7 +2060,8 @@ namespace ELRS
             file << "  \"pid\": " << config.pid << ",\n";
             file << "  \"frequency\": \"" << config.frequency << "\",\n";
             file << "  \"protocol\": \"" << config.protocol << "\",\n";
-            file << "  \"baudRate\": " << config.baudRate << "\n";
+            file << "  \"baudRate\": " << config.baudRate << ",\n";
+            file << "  \"baudErrorRate\": " << config.baudErrorRate << "\n";
             file << "}\n";
 
             return true;
@@ -2095,6 +2216,20 @@ namespace ELRS
             configOptions_.push_back(telemetryOption);
             configOptionLabels_.push_back(telemetryOption.name);
 
+            auto deviceConfig = RadioState::getInstance().getDeviceConfiguration();
+            std::ostringstream baudValue;
+            baudValue << deviceConfig.baudRate << " baud (" << std::fixed << std::setprecision(2)
+                      << deviceConfig.baudErrorRate * 100.0 << "% CRC errors)";
+
+            ConfigOption baudOption;
+            baudOption.name = "Link Baud Rate";
+            baudOption.description = "UART rate negotiated with the module and its measured CRC error rate.";
+            baudOption.values = {baudValue.str()};
+            baudOption.currentIndex = 0;
+            baudOption.editable = false;
+            configOptions_.push_back(baudOption);
+            configOptionLabels_.push_back(baudOption.name);
+
             ConfigOption linkStatsOption;
             linkStatsOption.name = "Request Link Stats";
             linkStatsOption.description = "Send an immediate link statistics request via MSP.";
@@ -2206,9 +2341,8 @@ namespace ELRS
             bool success = direction > 0 ? mspCommands_->sendPowerIncrease() : mspCommands_->sendPowerDecrease();
             if (success)
             {
-                auto telemetry = RadioState::getInstance().getLiveTelemetry();
-                telemetry.txPower += direction > 0 ? 5 : -5;
-                RadioState::getInstance().updateTelemetry(telemetry);
+                auto &radioState = RadioState::getInstance();
+                radioState.beginUpdate().txPower(radioState.getTxPower() + (direction > 0 ? 5 : -5)).commit();
             }
             else
             {
@@ -0,0 +1,78 @@
+#include "metric_history.h"
+
+namespace ELRS
+{
+
+    MetricHistory::MetricHistory(size_t depth)
+        : raw_(depth),
+          tiers_{{{std::chrono::seconds(1), HistoryRing<HistoryRollup>(SECOND_TIER_DEPTH), {}, 0},
+                  {std::chrono::seconds(10), HistoryRing<HistoryRollup>(TEN_SECOND_TIER_DEPTH), {}, 0},
+                  {std::chrono::minutes(1), HistoryRing<HistoryRollup>(MINUTE_TIER_DEPTH), {}, 0}}}
+    {
+    }
+
+    void MetricHistory::append(Clock::time_point time, int value)
+    {
+        raw_.push(HistorySample{time, value});
+
+        for (auto &tier : tiers_)
+        {
+            const int64_t index = time.time_since_epoch() / tier.resolution;
+            if (tier.open.count > 0 && index != tier.open_index)
+            {
+                tier.closed.push(tier.open);
+                tier.open.count = 0;
+            }
+
+            if (tier.open.count == 0)
+            {
+                tier.open_index = index;
+                tier.open.start = Clock::time_point(tier.resolution * index);
+                tier.open.min = value;
+                tier.open.max = value;
+                tier.open.sum = value;
+                tier.open.count = 1;
+                continue;
+            }
+
+            tier.open.min = std::min(tier.open.min, value);
+            tier.open.max = std::max(tier.open.max, value);
+            tier.open.sum += value;
+            tier.open.count++;
+        }
+    }
+
+    void MetricHistory::clear()
+    {
+        raw_.clear();
+        for (auto &tier : tiers_)
+        {
+            tier.closed.clear();
+            tier.open.count = 0;
+        }
+    }
+
+    size_t MetricHistory::rollupCount(HistoryResolution resolution) const
+    {
+        if (resolution == HistoryResolution::Raw)
+        {
+            return raw_.size();
+        }
+        const Tier &tier = tierFor(resolution);
+        return tier.closed.size() + (tier.open.count > 0 ? 1 : 0);
+    }
+
+    const MetricHistory::Tier &MetricHistory::tierFor(HistoryResolution resolution) const
+    {
+        switch (resolution)
+        {
+        case HistoryResolution::TenSeconds:
+            return tiers_[1];
+        case HistoryResolution::Minute:
+            return tiers_[2];
+        default:
+            return tiers_[0];
+        }
+    }
+
+} // namespace ELRS
@@ -1,12 +1,14 @@
 #include "msp_commands.h"
-#include "usb_bridge.h"
+#include "crsf_protocol.h"
+#include "msp_tunnel.h"
+#include "transport.h"
 #include <iostream>
 
 namespace ELRS
 {
 
-    MspCommands::MspCommands(UsbBridge *usb_bridge)
-        : usb_bridge_(usb_bridge)
+    MspCommands::MspCommands(ITransport *transport)
+        : transport_(transport)
     {
     }
 
@@ -69,7 +71,7 @@ namespace ELRS
 
         std::cout << "📊 ELRS_LINKSTATS: Requesting telemetry data"
                   << (includeSpectrum ? " + spectrum bins" : "") << "..." << std::endl;
-        bool result = sendMspCommand(MSP_ELRS_TELEMETRY_PUSH, payload, sizeof(payload));
+        bool result = sendMspCommand(MSP_ELRS_TELEMETRY_PUSH, payload, sizeof(payload), WriteClass::TelemetryPoll);
 
         if (result)
         {
@@ -141,60 +143,139 @@ namespace ELRS
         return result;
     }
 
-    bool MspCommands::sendMspCommand(uint8_t function, const uint8_t *payload, uint8_t payload_size)
+    bool MspCommands::sendMspCommand(uint16_t function, const uint8_t *payload, size_t payload_size,
+                                     WriteClass write_class)
     {
-        if (!usb_bridge_ || !usb_bridge_->isConnected())
+        if (!transport_ || !transport_->isConnected())
         {
-            setError("USB device not connected");
+            setError("Transport not connected");
             return false;
         }
 
-        std::array<uint8_t, 64> frame;
-        uint8_t frame_size;
+        // A raw frame cannot be split (RC bytes would land inside it) and a long one would hold the
+        // writer for a whole RC period or more, so payloads that do not fit one write go tunnelled
+        const MspVersion version = function > 0xFF ? MspVersion::V2 : msp_version_.load();
+        if (encapsulation_.load() == MspEncapsulation::Crsf ||
+            MspProtocol::frameSize(version, payload_size) > WriteScheduler::MAX_WRITE_SIZE)
+        {
+            return sendTunnelled(function, payload, payload_size, write_class);
+        }
 
-        buildMspCommand(function, payload, payload_size, frame, frame_size);
+        // '<' = to the module
+        std::vector<uint8_t> frame;
+        if (MspProtocol::encode(version, '<', function, payload, payload_size, frame) == 0)
+        {
+            setError("MSP payload too large (" + std::to_string(payload_size) + " bytes)");
+            return false;
+        }
 
-        return usb_bridge_->write(frame.data(), frame_size);
+        return writeFrame(frame.data(), frame.size(), write_class);
     }
 
-    void MspCommands::buildMspCommand(uint8_t function, const uint8_t *payload, uint8_t payload_size,
-                                      std::array<uint8_t, 64> &out, uint8_t &out_size)
+    bool MspCommands::sendTunnelled(uint16_t function, const uint8_t *payload, size_t payload_size,
+                                    WriteClass write_class)
     {
-        // MSP v2 frame format: $M< or $M> [size] [function] [payload...] [crc]
-        out[0] = '$';
-        out[1] = 'M';
-        out[2] = '<'; // Direction (< = to FC)
-        out[3] = payload_size;
-        out[4] = function;
+        if (payload_size > MspProtocol::MSP_MAX_PAYLOAD || (payload_size > 0 && !payload))
+        {
+            setError("MSP payload too large (" + std::to_string(payload_size) + " bytes)");
+            return false;
+        }
+
+        // A receiver drops a message whose chunks are interleaved with another one or cut short, so
+        // one message's chunks are encoded first and then queued together, all or none, under the lock
+        const MspVersion version = msp_version_.load();
+        std::lock_guard<std::mutex> lock(tunnel_mutex_);
+
+        // Each chunk is its own write, so RC frames can slip in between the chunks of a long message
+        const uint8_t frame_type = payload_size > 0 ? MspTunnel::CRSF_FRAMETYPE_MSP_WRITE : MspTunnel::CRSF_FRAMETYPE_MSP_REQ;
+        std::vector<uint8_t> bytes;
+        std::vector<size_t> ends; // End offset of each chunk in bytes
+        const size_t chunks = MspTunnel::encode(frame_type, CrsfProtocol::CRSF_ADDRESS_CRSF_TRANSMITTER,
+                                                CrsfProtocol::CRSF_ADDRESS_CRSF_TRANSMITTER, CrsfProtocol::CRSF_ADDRESS_RADIO_TRANSMITTER,
+                                                version, false, function, payload, payload_size, tunnel_sequence_,
+                                                [&](const uint8_t *frame, size_t size)
+                                                {
+                                                    bytes.insert(bytes.end(), frame, frame + size);
+                                                    ends.push_back(bytes.size());
+                                                    return true;
+                                                });
+        if (chunks == 0)
+        {
+            setError("MSP payload too large (" + std::to_string(payload_size) + " bytes)");
+            return false;
+        }
+
+        std::vector<ITransport::IoSlice> frames(chunks);
+        for (size_t i = 0; i < chunks; ++i)
+        {
+            const size_t begin = i == 0 ? 0 : ends[i - 1];
+            frames[i] = {bytes.data() + begin, ends[i] - begin};
+        }
 
-        // Copy payload
-        if (payload && payload_size > 0)
+        WriteScheduler *scheduler = write_scheduler_.load();
+        if (scheduler && scheduler->isRunning())
         {
-            for (uint8_t i = 0; i < payload_size; i++)
+            // A message longer than its class queue goes on Bulk, which is deep enough for MSP_MAX_PAYLOAD
+            if (chunks > scheduler->queueCapacity(write_class))
             {
-                out[5 + i] = payload[i];
+                write_class = WriteClass::Bulk;
+            }
+            if (chunks > scheduler->queueCapacity(write_class))
+            {
+                setError("MSP message too long (" + std::to_string(chunks) + " chunks, queue holds " +
+                         std::to_string(scheduler->queueCapacity(write_class)) + ")");
+                return false;
+            }
+            if (!scheduler->submitAll(write_class, frames.data(), chunks))
+            {
+                setError(std::string("Write queue full (") + WriteScheduler::className(write_class) + ", " +
+                         std::to_string(chunks) + " chunks)");
+                return false;
+            }
+        }
+        else
+        {
+            for (const auto &frame : frames)
+            {
+                if (!transport_->write(frame.data, frame.length))
+                {
+                    setError("Transport write failed");
+                    tunnel_sequence_ += static_cast<uint8_t>(chunks); // Part of it may be on the wire
+                    return false;
+                }
             }
         }
 
-        // Calculate CRC (size + function + payload)
-        uint8_t crc = calculateMspCrc(&out[3], payload_size + 1);
-        out[5 + payload_size] = crc;
-
-        out_size = 6 + payload_size;
+        // Sequence numbers only move on for a message that was actually queued
+        tunnel_sequence_ += static_cast<uint8_t>(chunks);
+        return true;
     }
 
-    uint8_t MspCommands::calculateMspCrc(const uint8_t *data, uint8_t length)
+    bool MspCommands::writeFrame(const uint8_t *frame, size_t size, WriteClass write_class)
     {
-        uint8_t crc = 0;
-        for (uint8_t i = 0; i < length; i++)
+        WriteScheduler *scheduler = write_scheduler_.load();
+        if (scheduler && scheduler->isRunning())
         {
-            crc ^= data[i];
+            if (!scheduler->submit(write_class, frame, size))
+            {
+                setError(std::string("Write queue full or frame too large (") + WriteScheduler::className(write_class) + ")");
+                return false;
+            }
+            return true;
         }
-        return crc;
+
+        return transport_->write(frame, size);
+    }
+
+    std::string MspCommands::getLastError() const
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        return last_error_;
     }
 
     void MspCommands::setError(const std::string &error)
     {
+        std::lock_guard<std::mutex> lock(error_mutex_);
         last_error_ = error;
     }
 
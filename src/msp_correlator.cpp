@@ -0,0 +1,410 @@
+#include "msp_correlator.h"
+#include "frame_demuxer.h"
+#include "msp_commands.h"
+#include "msp_protocol.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+namespace ELRS
+{
+
+    namespace
+    {
+        constexpr uint8_t MSP_DEVICE_INFO = 0x29;
+
+        // How long after a timeout a straggling reply is still attributed to the expired request
+        constexpr std::chrono::milliseconds STALE_REPLY_GRACE{250};
+
+        // Timer wake-up when nothing is outstanding; bounds how long stop() takes
+        constexpr std::chrono::milliseconds IDLE_WAIT{1000};
+    }
+
+    MspCorrelator::MspCorrelator(MspCommands *msp, size_t max_in_flight)
+        : msp_(msp), max_in_flight_(std::max<size_t>(max_in_flight, 1))
+    {
+    }
+
+    MspCorrelator::~MspCorrelator()
+    {
+        stop();
+    }
+
+    void MspCorrelator::start()
+    {
+        if (running_.load())
+        {
+            return; // Already running
+        }
+
+        running_.store(true);
+        timer_thread_ = std::make_unique<std::thread>(&MspCorrelator::timerLoop, this);
+
+        std::cout << "[MSP] Correlator started (" << getMaxInFlight() << " requests in flight)" << std::endl;
+    }
+
+    void MspCorrelator::stop()
+    {
+        if (!running_.load())
+        {
+            return; // Already stopped
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_.store(false);
+            timer_cv_.notify_one();
+        }
+
+        if (timer_thread_ && timer_thread_->joinable())
+        {
+            timer_thread_->join();
+        }
+        timer_thread_.reset();
+
+        std::vector<Request> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &entry : in_flight_)
+            {
+                std::move(entry.second.begin(), entry.second.end(), std::back_inserter(cancelled));
+            }
+            in_flight_.clear();
+            stale_.clear();
+            std::move(queued_.begin(), queued_.end(), std::back_inserter(cancelled));
+            queued_.clear();
+            in_flight_count_ = 0;
+        }
+
+        for (auto &request : cancelled)
+        {
+            complete(request, MspStatus::Cancelled);
+        }
+
+        std::cout << "[MSP] Correlator stopped" << std::endl;
+    }
+
+    std::future<MspReply> MspCorrelator::request(uint16_t function, const uint8_t *payload, size_t payload_size,
+                                                  std::chrono::milliseconds timeout, WriteClass write_class)
+    {
+        auto promise = std::make_shared<std::promise<MspReply>>();
+        std::future<MspReply> future = promise->get_future();
+        request(function, payload, payload_size, [promise](const MspReply &reply)
+                { promise->set_value(reply); }, timeout, write_class);
+        return future;
+    }
+
+    uint64_t MspCorrelator::request(uint16_t function, const uint8_t *payload, size_t payload_size, Callback callback,
+                                    std::chrono::milliseconds timeout, WriteClass write_class)
+    {
+        Request request;
+        request.function = function;
+        request.reply_function = replyFunctionFor(function);
+        request.write_class = write_class;
+        request.callback = std::move(callback);
+
+        if (!msp_ || payload_size > MspProtocol::MSP_MAX_PAYLOAD || (payload_size > 0 && !payload))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.send_failures++;
+        }
+        else if (running_.load())
+        {
+            if (payload_size > 0)
+            {
+                request.payload.assign(payload, payload + payload_size);
+            }
+
+            std::vector<Request> to_send;
+            uint64_t sequence;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                sequence = next_sequence_++;
+                request.sequence = sequence;
+                request.deadline = Clock::now() + timeout;
+                queued_.push_back(std::move(request));
+                stats_.requests++;
+                admitLocked(to_send);
+                timer_cv_.notify_one(); // A new earliest deadline
+            }
+            send(to_send);
+            return sequence;
+        }
+
+        complete(request, running_.load() ? MspStatus::SendFailed : MspStatus::Cancelled);
+        return 0;
+    }
+
+    void MspCorrelator::onReply(const MspFrameView &frame)
+    {
+        if (!frame.fromDevice())
+        {
+            return; // Our own request echoed back
+        }
+
+        Request request;
+        std::vector<Request> to_send;
+        auto now = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto &stale = stale_[frame.function];
+            while (!stale.empty() && stale.front() < now)
+            {
+                stale.pop_front();
+            }
+            if (!stale.empty())
+            {
+                // Most likely the late answer to a request that already timed out
+                stale.pop_front();
+                stats_.unmatched++;
+                return;
+            }
+
+            auto &queue = in_flight_[frame.function];
+            if (queue.empty())
+            {
+                stats_.unmatched++;
+                return;
+            }
+
+            request = std::move(queue.front());
+            queue.pop_front();
+            in_flight_count_--;
+            stats_.replies++;
+            if (frame.direction == '!')
+            {
+                stats_.errors++;
+            }
+            admitLocked(to_send);
+        }
+
+        send(to_send);
+
+        auto round_trip = std::chrono::duration_cast<std::chrono::nanoseconds>(now - request.sent);
+        rtt_ns_.record(static_cast<uint64_t>(round_trip.count()));
+
+        MspReply reply;
+        reply.status = frame.direction == '!' ? MspStatus::Error : MspStatus::Ok;
+        reply.function = frame.function;
+        reply.sequence = request.sequence;
+        reply.payload.assign(frame.payload.begin(), frame.payload.end());
+        reply.round_trip = std::chrono::duration_cast<std::chrono::microseconds>(round_trip);
+        if (request.callback)
+        {
+            request.callback(reply);
+        }
+    }
+
+    void MspCorrelator::setMaxInFlight(size_t max_in_flight)
+    {
+        std::vector<Request> to_send;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            max_in_flight_.store(std::max<size_t>(max_in_flight, 1), std::memory_order_relaxed);
+            admitLocked(to_send);
+        }
+        send(to_send);
+    }
+
+    MspCorrelatorStats MspCorrelator::getStats() const
+    {
+        MspCorrelatorStats stats;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats = stats_;
+            stats.in_flight = in_flight_count_;
+            stats.queued = queued_.size();
+        }
+        stats.rtt_mean_us = rtt_ns_.getMean() / 1000.0;
+        stats.rtt_p50_us = static_cast<double>(rtt_ns_.getPercentile(50.0)) / 1000.0;
+        stats.rtt_p99_us = static_cast<double>(rtt_ns_.getPercentile(99.0)) / 1000.0;
+        stats.rtt_max_us = static_cast<double>(rtt_ns_.getMax()) / 1000.0;
+        return stats;
+    }
+
+    void MspCorrelator::resetStats()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_ = MspCorrelatorStats();
+        }
+        rtt_ns_.reset();
+    }
+
+    uint16_t MspCorrelator::replyFunctionFor(uint16_t request_function)
+    {
+        return request_function == MspCommands::MSP_DEVICE_DISCOVERY ? MSP_DEVICE_INFO : request_function;
+    }
+
+    void MspCorrelator::timerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_.load())
+        {
+            auto now = Clock::now();
+            std::vector<Request> expired;
+
+            for (auto &entry : in_flight_)
+            {
+                const uint16_t function = entry.first;
+                auto &queue = entry.second;
+                for (auto it = queue.begin(); it != queue.end();)
+                {
+                    if (it->deadline <= now)
+                    {
+                        auto &stale = stale_[function];
+                        while (!stale.empty() && stale.front() < now)
+                        {
+                            stale.pop_front();
+                        }
+                        stale.push_back(now + STALE_REPLY_GRACE);
+                        expired.push_back(std::move(*it));
+                        it = queue.erase(it);
+                        in_flight_count_--;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            for (auto it = queued_.begin(); it != queued_.end();)
+            {
+                if (it->deadline <= now)
+                {
+                    expired.push_back(std::move(*it));
+                    it = queued_.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (!expired.empty())
+            {
+                stats_.timeouts += expired.size();
+
+                std::vector<Request> to_send;
+                admitLocked(to_send);
+
+                lock.unlock();
+                send(to_send);
+                for (auto &request : expired)
+                {
+                    complete(request, MspStatus::Timeout);
+                }
+                lock.lock();
+                continue; // Re-scan: time has moved on while unlocked
+            }
+
+            timer_cv_.wait_until(lock, nextDeadlineLocked());
+        }
+    }
+
+    void MspCorrelator::admitLocked(std::vector<Request> &to_send)
+    {
+        const size_t limit = max_in_flight_.load(std::memory_order_relaxed);
+        while (in_flight_count_ < limit && !queued_.empty())
+        {
+            Request request = std::move(queued_.front());
+            queued_.pop_front();
+            request.sent = Clock::now();
+
+            // The wire copy carries no callback; the in-flight entry keeps it
+            Request wire;
+            wire.sequence = request.sequence;
+            wire.function = request.function;
+            wire.reply_function = request.reply_function;
+            wire.write_class = request.write_class;
+            wire.payload = request.payload;
+            to_send.push_back(std::move(wire));
+
+            in_flight_[request.reply_function].push_back(std::move(request));
+            in_flight_count_++;
+        }
+    }
+
+    void MspCorrelator::send(std::vector<Request> &to_send)
+    {
+        // Registered as in flight before writing, so even an instant reply finds its request
+        while (!to_send.empty())
+        {
+            std::vector<Request> batch;
+            batch.swap(to_send);
+
+            for (auto &wire : batch)
+            {
+                if (msp_->sendMspCommand(wire.function, wire.payload.empty() ? nullptr : wire.payload.data(),
+                                         wire.payload.size(), wire.write_class))
+                {
+                    continue;
+                }
+                const std::string error = msp_->getLastError();
+
+                Request failed;
+                bool found = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto &queue = in_flight_[wire.reply_function];
+                    auto it = std::find_if(queue.begin(), queue.end(), [&](const Request &request)
+                                           { return request.sequence == wire.sequence; });
+                    if (it != queue.end())
+                    {
+                        failed = std::move(*it);
+                        queue.erase(it);
+                        in_flight_count_--;
+                        stats_.send_failures++;
+                        found = true;
+                        admitLocked(to_send);
+                    }
+                }
+
+                if (found)
+                {
+                    std::cerr << "[MSP_ERROR] Request 0x" << std::hex << static_cast<int>(wire.function) << std::dec
+                              << " not sent: " << error << std::endl;
+                    complete(failed, MspStatus::SendFailed);
+                }
+            }
+        }
+    }
+
+    MspCorrelator::Clock::time_point MspCorrelator::nextDeadlineLocked() const
+    {
+        Clock::time_point next = Clock::now() + IDLE_WAIT;
+        if (in_flight_count_ > 0)
+        {
+            for (const auto &entry : in_flight_)
+            {
+                for (const auto &request : entry.second)
+                {
+                    next = std::min(next, request.deadline);
+                }
+            }
+        }
+        for (const auto &request : queued_)
+        {
+            next = std::min(next, request.deadline);
+        }
+        return next;
+    }
+
+    void MspCorrelator::complete(Request &request, MspStatus status)
+    {
+        if (!request.callback)
+        {
+            return;
+        }
+
+        MspReply reply;
+        reply.status = status;
+        reply.function = request.reply_function;
+        reply.sequence = request.sequence;
+        request.callback(reply);
+    }
+
+} // namespace ELRS
@@ -0,0 +1,74 @@
+#include "msp_protocol.h"
+#include "checksum.h"
+#include <cstring>
+
+namespace ELRS
+{
+
+    size_t MspProtocol::frameSize(MspVersion version, size_t payload_size)
+    {
+        if (version == MspVersion::V2)
+        {
+            return MSP_V2_HEADER_SIZE + payload_size + 1;
+        }
+        return (payload_size < MSP_V1_JUMBO_SIZE ? MSP_V1_HEADER_SIZE : MSP_V1_JUMBO_HEADER_SIZE) + payload_size + 1;
+    }
+
+    size_t MspProtocol::encode(MspVersion version, char direction, uint16_t function, const uint8_t *payload,
+                               size_t payload_size, std::vector<uint8_t> &out, uint8_t flags)
+    {
+        if (payload_size > MSP_MAX_PAYLOAD || (payload_size > 0 && !payload))
+        {
+            out.clear();
+            return 0;
+        }
+
+        if (function > 0xFF)
+        {
+            version = MspVersion::V2;
+        }
+
+        const size_t total = frameSize(version, payload_size);
+        out.resize(total);
+
+        out[0] = '$';
+        out[1] = version == MspVersion::V2 ? 'X' : 'M';
+        out[2] = static_cast<uint8_t>(direction);
+
+        size_t header;
+        if (version == MspVersion::V2)
+        {
+            out[3] = flags;
+            out[4] = static_cast<uint8_t>(function & 0xFF);
+            out[5] = static_cast<uint8_t>(function >> 8);
+            out[6] = static_cast<uint8_t>(payload_size & 0xFF);
+            out[7] = static_cast<uint8_t>(payload_size >> 8);
+            header = MSP_V2_HEADER_SIZE;
+        }
+        else if (payload_size < MSP_V1_JUMBO_SIZE)
+        {
+            out[3] = static_cast<uint8_t>(payload_size);
+            out[4] = static_cast<uint8_t>(function);
+            header = MSP_V1_HEADER_SIZE;
+        }
+        else
+        {
+            out[3] = MSP_V1_JUMBO_SIZE;
+            out[4] = static_cast<uint8_t>(function);
+            out[5] = static_cast<uint8_t>(payload_size & 0xFF);
+            out[6] = static_cast<uint8_t>(payload_size >> 8);
+            header = MSP_V1_JUMBO_HEADER_SIZE;
+        }
+
+        if (payload_size > 0)
+        {
+            std::memcpy(&out[header], payload, payload_size);
+        }
+
+        // Checksum over everything between the direction byte and itself
+        out[total - 1] = version == MspVersion::V2 ? Checksum::mspV2Crc(&out[3], total - 4)
+                                                   : Checksum::mspV1Xor(&out[3], total - 4);
+        return total;
+    }
+
+} // namespace ELRS
@@ -0,0 +1,212 @@
+#include "msp_tunnel.h"
+#include "crsf_protocol.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ELRS
+{
+
+    namespace
+    {
+        constexpr size_t TUNNEL_V1_HEADER_SIZE = 2;       // size function
+        constexpr size_t TUNNEL_V1_JUMBO_HEADER_SIZE = 4; // 0xFF function size_lo size_hi
+        constexpr size_t TUNNEL_V2_HEADER_SIZE = 5;       // flags function_lo function_hi size_lo size_hi
+
+        // Destination, origin and status ahead of the chunk
+        constexpr size_t EXTENDED_HEADER_SIZE = 3;
+
+        MspVersion tunnelVersion(MspVersion version, uint16_t function, size_t payload_size)
+        {
+            return (function > 0xFF || payload_size >= MspProtocol::MSP_V1_JUMBO_SIZE) ? MspVersion::V2 : version;
+        }
+    }
+
+    size_t MspTunnel::chunkCount(MspVersion version, uint16_t function, size_t payload_size)
+    {
+        const size_t header = tunnelVersion(version, function, payload_size) == MspVersion::V2 ? TUNNEL_V2_HEADER_SIZE
+                                                                                               : TUNNEL_V1_HEADER_SIZE;
+        return (header + payload_size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    }
+
+    size_t MspTunnel::encode(uint8_t frame_type, uint8_t sync, uint8_t destination, uint8_t origin, MspVersion version,
+                             bool error, uint16_t function, const uint8_t *payload, size_t payload_size,
+                             uint8_t first_sequence, const std::function<bool(const uint8_t *, size_t)> &emit)
+    {
+        if (payload_size > MspProtocol::MSP_MAX_PAYLOAD || (payload_size > 0 && !payload))
+        {
+            return 0;
+        }
+
+        version = tunnelVersion(version, function, payload_size);
+
+        uint8_t header[TUNNEL_V2_HEADER_SIZE];
+        size_t header_size;
+        if (version == MspVersion::V2)
+        {
+            header[0] = 0; // flags
+            header[1] = static_cast<uint8_t>(function & 0xFF);
+            header[2] = static_cast<uint8_t>(function >> 8);
+            header[3] = static_cast<uint8_t>(payload_size & 0xFF);
+            header[4] = static_cast<uint8_t>(payload_size >> 8);
+            header_size = TUNNEL_V2_HEADER_SIZE;
+        }
+        else
+        {
+            header[0] = static_cast<uint8_t>(payload_size);
+            header[1] = static_cast<uint8_t>(function);
+            header_size = TUNNEL_V1_HEADER_SIZE;
+        }
+
+        const uint8_t status_bits = static_cast<uint8_t>((static_cast<uint8_t>(version) << STATUS_VERSION_SHIFT) & STATUS_VERSION_MASK) |
+                                    (error ? STATUS_ERROR : 0);
+
+        std::array<uint8_t, CrsfProtocol::CRSF_FRAME_SIZE_MAX> frame;
+        const size_t total = header_size + payload_size;
+        size_t offset = 0; // Into header followed by payload
+        size_t chunks = 0;
+
+        do
+        {
+            const size_t chunk_size = std::min(CHUNK_SIZE, total - offset);
+            uint8_t status = static_cast<uint8_t>((first_sequence + chunks) & STATUS_SEQUENCE_MASK) | status_bits;
+            if (chunks == 0)
+            {
+                status |= STATUS_START;
+            }
+
+            frame[0] = sync;
+            frame[1] = static_cast<uint8_t>(chunk_size + EXTENDED_HEADER_SIZE + 2); // Type .. CRC
+            frame[2] = frame_type;
+            frame[3] = destination;
+            frame[4] = origin;
+            frame[5] = status;
+
+            uint8_t *out = &frame[3 + EXTENDED_HEADER_SIZE];
+            for (size_t i = 0; i < chunk_size; i++, offset++)
+            {
+                out[i] = offset < header_size ? header[offset] : payload[offset - header_size];
+            }
+
+            const size_t frame_size = frame[1] + 2;
+            frame[frame_size - 1] = CrsfProtocol::crc8(&frame[2], static_cast<uint8_t>(frame[1] - 1));
+
+            if (!emit(frame.data(), frame_size))
+            {
+                return 0;
+            }
+            chunks++;
+        } while (offset < total);
+
+        return chunks;
+    }
+
+    bool MspReassembler::feed(uint8_t frame_type, const uint8_t *payload, size_t length)
+    {
+        if (length <= EXTENDED_HEADER_SIZE)
+        {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const uint8_t origin = payload[1];
+        const uint8_t status = payload[2];
+        const uint8_t sequence = status & MspTunnel::STATUS_SEQUENCE_MASK;
+        const uint8_t *chunk = payload + EXTENDED_HEADER_SIZE;
+        const size_t chunk_size = length - EXTENDED_HEADER_SIZE;
+
+        if (status & MspTunnel::STATUS_START)
+        {
+            if (active_)
+            {
+                errors_.fetch_add(1, std::memory_order_relaxed); // Previous message never completed
+                active_ = false;
+            }
+
+            const uint8_t version = (status & MspTunnel::STATUS_VERSION_MASK) >> MspTunnel::STATUS_VERSION_SHIFT;
+            size_t header_size;
+            size_t size;
+            uint8_t flags = 0;
+            uint16_t function;
+            if (version == static_cast<uint8_t>(MspVersion::V1) && chunk_size >= TUNNEL_V1_HEADER_SIZE)
+            {
+                size = chunk[0];
+                function = chunk[1];
+                header_size = TUNNEL_V1_HEADER_SIZE;
+                if (size == MspProtocol::MSP_V1_JUMBO_SIZE)
+                {
+                    if (chunk_size < TUNNEL_V1_JUMBO_HEADER_SIZE)
+                    {
+                        errors_.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    size = chunk[2] | (chunk[3] << 8);
+                    header_size = TUNNEL_V1_JUMBO_HEADER_SIZE;
+                }
+            }
+            else if (version == static_cast<uint8_t>(MspVersion::V2) && chunk_size >= TUNNEL_V2_HEADER_SIZE)
+            {
+                flags = chunk[0];
+                function = static_cast<uint16_t>(chunk[1] | (chunk[2] << 8));
+                size = chunk[3] | (chunk[4] << 8);
+                header_size = TUNNEL_V2_HEADER_SIZE;
+            }
+            else
+            {
+                errors_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            if (size > buffer_.size())
+            {
+                errors_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            frame_type_ = frame_type;
+            origin_ = origin;
+            version_ = static_cast<MspVersion>(version);
+            error_ = (status & MspTunnel::STATUS_ERROR) != 0;
+            flags_ = flags;
+            function_ = function;
+            expected_ = size;
+            received_ = 0;
+            active_ = true;
+            next_sequence_ = (sequence + 1) & MspTunnel::STATUS_SEQUENCE_MASK;
+            return append(chunk + header_size, chunk_size - header_size);
+        }
+
+        if (!active_)
+        {
+            errors_.fetch_add(1, std::memory_order_relaxed); // Continuation of a message we never saw start
+            return false;
+        }
+        if (sequence != next_sequence_ || frame_type != frame_type_ || origin != origin_)
+        {
+            errors_.fetch_add(1, std::memory_order_relaxed); // Lost a chunk: the message cannot be completed
+            active_ = false;
+            return false;
+        }
+
+        next_sequence_ = (sequence + 1) & MspTunnel::STATUS_SEQUENCE_MASK;
+        return append(chunk, chunk_size);
+    }
+
+    bool MspReassembler::append(const uint8_t *data, size_t length)
+    {
+        // Bytes past the announced size are padding
+        const size_t take = std::min(length, expected_ - received_);
+        if (take > 0)
+        {
+            std::memcpy(&buffer_[received_], data, take);
+            received_ += take;
+        }
+
+        if (received_ < expected_)
+        {
+            return false;
+        }
+        active_ = false;
+        return true;
+    }
+
+} // namespace ELRS
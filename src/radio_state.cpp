@@ -13,15 +13,22 @@ namespace ELRS
     }
 
     RadioState::RadioState()
+        : dispatcher_([this]()
+                      { return getSnapshot(); })
     {
         start_time_ = std::chrono::steady_clock::now();
         live_telemetry_.lastUpdate = start_time_;
 
-        // Initialize history vectors
-        rssi_history_.reserve(MAX_HISTORY_SIZE);
-        link_quality_history_.reserve(MAX_HISTORY_SIZE);
-        tx_power_history_.reserve(MAX_HISTORY_SIZE);
         spectrum_last_update_ = start_time_;
+
+        device_config_ = std::make_shared<const DeviceConfiguration>();
+        spectrum_data_ = std::make_shared<const std::vector<int>>();
+        publishLocked();
+    }
+
+    std::shared_ptr<const RadioSnapshot> RadioState::getSnapshot() const
+    {
+        return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
     }
 
     // Connection management
@@ -29,7 +36,8 @@ namespace ELRS
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
         connection_status_ = status;
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Connection);
     }
 
     ConnectionStatus RadioState::getConnectionStatus() const
@@ -39,7 +47,12 @@ namespace ELRS
 
     std::string RadioState::getConnectionStatusString() const
     {
-        switch (getConnectionStatus())
+        return connectionStatusToString(getConnectionStatus());
+    }
+
+    std::string RadioState::connectionStatusToString(ConnectionStatus status)
+    {
+        switch (status)
         {
         case ConnectionStatus::Disconnected:
             return "Disconnected";
@@ -61,7 +74,8 @@ namespace ELRS
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
         radio_mode_ = mode;
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Connection);
     }
 
     RadioMode RadioState::getRadioMode() const
@@ -92,160 +106,240 @@ namespace ELRS
     void RadioState::setDeviceConfiguration(const DeviceConfiguration &config)
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
-        device_config_ = config;
-        notifyStateChange();
+        device_config_ = std::make_shared<const DeviceConfiguration>(config);
+        publishLocked();
+        notifyStateChange(StateTopic::Connection);
     }
 
     DeviceConfiguration RadioState::getDeviceConfiguration() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return device_config_;
+        return *getSnapshot()->device;
     }
 
     // Live telemetry updates
     void RadioState::updateTelemetry(const LiveTelemetry &telemetry)
     {
+        const auto now = std::chrono::steady_clock::now();
+
         std::lock_guard<std::mutex> lock(state_mutex_);
         live_telemetry_ = telemetry;
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
+        live_telemetry_.lastUpdate = now;
         live_telemetry_.isValid = true;
+        recordTelemetryLocked();
 
         // Update history
-        addToHistory(rssi_history_, telemetry.rssi1);
-        addToHistory(link_quality_history_, telemetry.linkQuality);
-        addToHistory(tx_power_history_, telemetry.txPower);
+        rssi_history_.append(now, telemetry.rssi1);
+        link_quality_history_.append(now, telemetry.linkQuality);
+        tx_power_history_.append(now, telemetry.txPower);
 
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Link | StateTopic::Battery);
     }
 
     void RadioState::updateRSSI(int rssi1, int rssi2)
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        live_telemetry_.rssi1 = rssi1;
-        live_telemetry_.rssi2 = rssi2;
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
-        live_telemetry_.isValid = true;
-
-        addToHistory(rssi_history_, rssi1);
-        notifyStateChange();
+        beginUpdate().rssi(rssi1, rssi2).commit();
     }
 
     void RadioState::updateLinkQuality(int quality)
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        live_telemetry_.linkQuality = std::max(0, std::min(100, quality));
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
-        live_telemetry_.isValid = true;
-
-        addToHistory(link_quality_history_, live_telemetry_.linkQuality);
-        notifyStateChange();
+        beginUpdate().linkQuality(quality).commit();
     }
 
     void RadioState::updateTxPower(int power)
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        live_telemetry_.txPower = power;
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
-        live_telemetry_.isValid = true;
-
-        addToHistory(tx_power_history_, power);
-        notifyStateChange();
+        beginUpdate().txPower(power).commit();
     }
 
     void RadioState::updatePacketStats(uint32_t rx, uint32_t tx, uint32_t lost)
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        live_telemetry_.packetsReceived = rx;
-        live_telemetry_.packetsTransmitted = tx;
-        live_telemetry_.packetsLost = lost;
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
-        live_telemetry_.isValid = true;
-        notifyStateChange();
+        beginUpdate().packetStats(rx, tx, lost).commit();
     }
 
     void RadioState::updateBattery(double voltage, double current)
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        live_telemetry_.voltage = voltage;
-        live_telemetry_.current = current;
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
-        live_telemetry_.isValid = true;
-        notifyStateChange();
+        beginUpdate().battery(voltage, current).commit();
     }
 
     void RadioState::updateTemperature(int temp)
     {
+        beginUpdate().temperature(temp).commit();
+    }
+
+    uint64_t RadioState::applyUpdate(const RadioStateUpdate &update)
+    {
+        if (update.empty())
+        {
+            return getVersion();
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const uint32_t fields = update.fields_;
+        const uint32_t battery_fields = RadioStateUpdate::FIELD_BATTERY | RadioStateUpdate::FIELD_TEMPERATURE;
+        const uint32_t topics = ((fields & ~battery_fields) ? StateTopic::Link : 0) |
+                                ((fields & battery_fields) ? StateTopic::Battery : 0);
+
         std::lock_guard<std::mutex> lock(state_mutex_);
-        live_telemetry_.temperature = temp;
-        live_telemetry_.lastUpdate = std::chrono::steady_clock::now();
+        if (fields & RadioStateUpdate::FIELD_RSSI)
+        {
+            live_telemetry_.rssi1 = update.rssi1_;
+            live_telemetry_.rssi2 = update.rssi2_;
+            rssi_history_.append(now, update.rssi1_);
+        }
+        if (fields & RadioStateUpdate::FIELD_LINK_QUALITY)
+        {
+            live_telemetry_.linkQuality = update.link_quality_;
+            link_quality_history_.append(now, update.link_quality_);
+        }
+        if (fields & RadioStateUpdate::FIELD_SNR)
+        {
+            live_telemetry_.snr = update.snr_;
+        }
+        if (fields & RadioStateUpdate::FIELD_TX_POWER)
+        {
+            live_telemetry_.txPower = update.tx_power_;
+            tx_power_history_.append(now, update.tx_power_);
+        }
+        if (fields & RadioStateUpdate::FIELD_PACKETS)
+        {
+            live_telemetry_.packetsReceived = update.packets_received_;
+            live_telemetry_.packetsTransmitted = update.packets_transmitted_;
+            live_telemetry_.packetsLost = update.packets_lost_;
+        }
+        if (fields & RadioStateUpdate::FIELD_BATTERY)
+        {
+            live_telemetry_.voltage = update.voltage_;
+            live_telemetry_.current = update.current_;
+        }
+        if (fields & RadioStateUpdate::FIELD_TEMPERATURE)
+        {
+            live_telemetry_.temperature = update.temperature_;
+        }
+        live_telemetry_.lastUpdate = now;
         live_telemetry_.isValid = true;
-        notifyStateChange();
+        recordTelemetryLocked();
+
+        publishLocked();
+        notifyStateChange(topics);
+        return version_.load(std::memory_order_relaxed);
+    }
+
+    // Batched update builder
+    RadioStateUpdate &RadioStateUpdate::rssi(int rssi1, int rssi2)
+    {
+        rssi1_ = rssi1;
+        rssi2_ = rssi2;
+        fields_ |= FIELD_RSSI;
+        return *this;
+    }
+
+    RadioStateUpdate &RadioStateUpdate::linkQuality(int quality)
+    {
+        link_quality_ = std::max(0, std::min(100, quality));
+        fields_ |= FIELD_LINK_QUALITY;
+        return *this;
+    }
+
+    RadioStateUpdate &RadioStateUpdate::snr(int snr)
+    {
+        snr_ = snr;
+        fields_ |= FIELD_SNR;
+        return *this;
+    }
+
+    RadioStateUpdate &RadioStateUpdate::txPower(int power)
+    {
+        tx_power_ = power;
+        fields_ |= FIELD_TX_POWER;
+        return *this;
+    }
+
+    RadioStateUpdate &RadioStateUpdate::packetStats(uint32_t rx, uint32_t tx, uint32_t lost)
+    {
+        packets_received_ = rx;
+        packets_transmitted_ = tx;
+        packets_lost_ = lost;
+        fields_ |= FIELD_PACKETS;
+        return *this;
+    }
+
+    RadioStateUpdate &RadioStateUpdate::battery(double voltage, double current)
+    {
+        voltage_ = voltage;
+        current_ = current;
+        fields_ |= FIELD_BATTERY;
+        return *this;
+    }
+
+    RadioStateUpdate &RadioStateUpdate::temperature(int temp)
+    {
+        temperature_ = temp;
+        fields_ |= FIELD_TEMPERATURE;
+        return *this;
+    }
+
+    uint64_t RadioStateUpdate::commit()
+    {
+        uint64_t version = state_->applyUpdate(*this);
+        fields_ = 0; // A second commit() is a no-op
+        return version;
     }
 
     // Telemetry getters
     LiveTelemetry RadioState::getLiveTelemetry() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_;
+        return getSnapshot()->telemetry;
     }
 
     int RadioState::getRSSI() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_.rssi1;
+        return getSnapshot()->telemetry.rssi1;
     }
 
     int RadioState::getLinkQuality() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_.linkQuality;
+        return getSnapshot()->telemetry.linkQuality;
     }
 
     int RadioState::getTxPower() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_.txPower;
+        return getSnapshot()->telemetry.txPower;
     }
 
     uint32_t RadioState::getPacketsReceived() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_.packetsReceived;
+        return getSnapshot()->telemetry.packetsReceived;
     }
 
     uint32_t RadioState::getPacketsTransmitted() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_.packetsTransmitted;
+        return getSnapshot()->telemetry.packetsTransmitted;
     }
 
     double RadioState::getBatteryVoltage() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return live_telemetry_.voltage;
+        return getSnapshot()->telemetry.voltage;
     }
 
     // Calculated metrics
     double RadioState::getPacketLossRate() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        uint32_t total = live_telemetry_.packetsReceived + live_telemetry_.packetsLost;
+        auto snapshot = getSnapshot();
+        uint32_t total = snapshot->telemetry.packetsReceived + snapshot->telemetry.packetsLost;
         if (total == 0)
             return 0.0;
-        return (static_cast<double>(live_telemetry_.packetsLost) / total) * 100.0;
+        return (static_cast<double>(snapshot->telemetry.packetsLost) / total) * 100.0;
     }
 
     std::string RadioState::getUptimeString() const
     {
         auto now = std::chrono::steady_clock::now();
-        auto uptime = now - start_time_;
+        auto uptime = now - getSnapshot()->startTime;
         return formatDuration(uptime);
     }
 
     std::string RadioState::getLastUpdateTimeString() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
         auto tm = *std::localtime(&time_t);
@@ -257,9 +351,8 @@ namespace ELRS
 
     bool RadioState::isTelemetryFresh(int maxAgeMs) const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
         auto now = std::chrono::steady_clock::now();
-        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - live_telemetry_.lastUpdate);
+        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - getSnapshot()->telemetry.lastUpdate);
         return age.count() < maxAgeMs;
     }
 
@@ -269,13 +362,13 @@ namespace ELRS
         std::lock_guard<std::mutex> lock(state_mutex_);
         last_error_ = error;
         has_error_ = !error.empty();
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Error);
     }
 
     std::string RadioState::getLastError() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return last_error_;
+        return getSnapshot()->lastError;
     }
 
     void RadioState::clearError()
@@ -283,7 +376,8 @@ namespace ELRS
         std::lock_guard<std::mutex> lock(state_mutex_);
         last_error_.clear();
         has_error_ = false;
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Error);
     }
 
     bool RadioState::hasError() const
@@ -292,16 +386,45 @@ namespace ELRS
     }
 
     // State change notifications
+    SubscriptionId RadioState::subscribe(uint32_t topics, StateSubscriber callback)
+    {
+        return dispatcher_.subscribe(topics, std::move(callback));
+    }
+
+    void RadioState::unsubscribe(SubscriptionId id)
+    {
+        dispatcher_.unsubscribe(id);
+    }
+
+    bool RadioState::getSubscriberStats(SubscriptionId id, SubscriberStats &stats) const
+    {
+        return dispatcher_.getStats(id, stats);
+    }
+
+    void RadioState::setNotificationTick(std::chrono::milliseconds tick)
+    {
+        dispatcher_.setTick(tick);
+    }
+
     void RadioState::subscribeToChanges(StateChangeCallback callback)
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        state_change_callback_ = callback;
+        // Not under state_mutex_: unsubscribe waits for a callback that may be taking it
+        std::lock_guard<std::mutex> lock(legacy_mutex_);
+        if (legacy_subscription_ != 0)
+        {
+            dispatcher_.unsubscribe(legacy_subscription_);
+            legacy_subscription_ = 0;
+        }
+        if (callback)
+        {
+            legacy_subscription_ = dispatcher_.subscribe(StateTopic::All, [callback](const RadioStateChange &)
+                                                         { callback(); });
+        }
     }
 
     void RadioState::unsubscribeFromChanges()
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        state_change_callback_ = nullptr;
+        subscribeToChanges(nullptr);
     }
 
     // Statistics and history
@@ -315,45 +438,40 @@ namespace ELRS
         rssi_history_.clear();
         link_quality_history_.clear();
         tx_power_history_.clear();
+        telemetry_store_.clear();
 
         start_time_ = std::chrono::steady_clock::now();
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Link);
     }
 
     std::vector<int> RadioState::getRSSIHistory(int maxPoints) const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        if (rssi_history_.size() <= static_cast<size_t>(maxPoints))
-        {
-            return rssi_history_;
-        }
-
-        auto start = rssi_history_.end() - maxPoints;
-        return std::vector<int>(start, rssi_history_.end());
+        return historyValues(HistoryMetric::Rssi, maxPoints);
     }
 
     std::vector<int> RadioState::getLinkQualityHistory(int maxPoints) const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        if (link_quality_history_.size() <= static_cast<size_t>(maxPoints))
-        {
-            return link_quality_history_;
-        }
-
-        auto start = link_quality_history_.end() - maxPoints;
-        return std::vector<int>(start, link_quality_history_.end());
+        return historyValues(HistoryMetric::LinkQuality, maxPoints);
     }
 
     std::vector<int> RadioState::getTxPowerHistory(int maxPoints) const
+    {
+        return historyValues(HistoryMetric::TxPower, maxPoints);
+    }
+
+    void RadioState::setHistoryDepth(size_t samples)
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
-        if (tx_power_history_.size() <= static_cast<size_t>(maxPoints))
-        {
-            return tx_power_history_;
-        }
+        rssi_history_.setDepth(samples);
+        link_quality_history_.setDepth(samples);
+        tx_power_history_.setDepth(samples);
+    }
 
-        auto start = tx_power_history_.end() - maxPoints;
-        return std::vector<int>(start, tx_power_history_.end());
+    size_t RadioState::getHistoryDepth() const
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        return rssi_history_.getDepth();
     }
 
     void RadioState::updateSpectrumData(const std::vector<int> &data)
@@ -363,52 +481,51 @@ namespace ELRS
             return;
         }
 
+        // Built outside the lock; snapshots still holding the previous bins keep them alive
+        auto bins = data.size() > MAX_SPECTRUM_SIZE
+                        ? std::make_shared<const std::vector<int>>(data.end() - MAX_SPECTRUM_SIZE, data.end())
+                        : std::make_shared<const std::vector<int>>(data);
+
         std::lock_guard<std::mutex> lock(state_mutex_);
-        spectrum_data_ = data;
-        if (spectrum_data_.size() > MAX_SPECTRUM_SIZE)
-        {
-            spectrum_data_.erase(spectrum_data_.begin(), spectrum_data_.end() - MAX_SPECTRUM_SIZE);
-        }
+        spectrum_data_ = std::move(bins);
         spectrum_last_update_ = std::chrono::steady_clock::now();
-        notifyStateChange();
+        publishLocked();
+        notifyStateChange(StateTopic::Spectrum);
     }
 
     std::vector<int> RadioState::getSpectrumData() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return spectrum_data_;
+        return *getSnapshot()->spectrum;
     }
 
     bool RadioState::isSpectrumFresh(int maxAgeMs) const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        if (spectrum_data_.empty())
+        auto snapshot = getSnapshot();
+        if (snapshot->spectrum->empty())
         {
             return false;
         }
 
         auto now = std::chrono::steady_clock::now();
-        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - spectrum_last_update_);
+        auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - snapshot->spectrumLastUpdate);
         return age.count() <= maxAgeMs;
     }
 
     size_t RadioState::getSpectrumBinCount() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return spectrum_data_.size();
+        return getSnapshot()->spectrum->size();
     }
 
     std::chrono::steady_clock::time_point RadioState::getSpectrumLastUpdate() const
     {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        return spectrum_last_update_;
+        return getSnapshot()->spectrumLastUpdate;
     }
 
     // System state
     void RadioState::markSystemReady()
     {
         system_ready_ = true;
-        notifyStateChange();
+        notifyStateChange(StateTopic::Connection);
     }
 
     bool RadioState::isSystemReady() const
@@ -418,25 +535,78 @@ namespace ELRS
 
     std::chrono::steady_clock::time_point RadioState::getStartTime() const
     {
-        return start_time_;
+        return getSnapshot()->startTime;
     }
 
     // Helper methods
-    void RadioState::notifyStateChange()
+    void RadioState::publishLocked()
+    {
+        const uint64_t version = version_.load(std::memory_order_relaxed) + 1;
+        auto snapshot = std::make_shared<RadioSnapshot>();
+        snapshot->version = version;
+        snapshot->connectionStatus = connection_status_.load();
+        snapshot->radioMode = radio_mode_.load();
+        snapshot->telemetry = live_telemetry_;
+        snapshot->device = device_config_;
+        snapshot->spectrum = spectrum_data_;
+        snapshot->spectrumLastUpdate = spectrum_last_update_;
+        snapshot->lastError = last_error_;
+        snapshot->startTime = start_time_;
+
+        // Snapshot first, so a reader that sees the new version also finds the snapshot
+        std::atomic_store_explicit(&snapshot_, std::shared_ptr<const RadioSnapshot>(std::move(snapshot)),
+                                   std::memory_order_release);
+        version_.store(version, std::memory_order_release);
+    }
+
+    void RadioState::recordTelemetryLocked()
+    {
+        TelemetryRow row;
+        row.time = std::chrono::system_clock::now();
+        row.rssi1 = live_telemetry_.rssi1;
+        row.rssi2 = live_telemetry_.rssi2;
+        row.linkQuality = live_telemetry_.linkQuality;
+        row.snr = live_telemetry_.snr;
+        row.txPower = live_telemetry_.txPower;
+        row.packetsReceived = live_telemetry_.packetsReceived;
+        row.packetsTransmitted = live_telemetry_.packetsTransmitted;
+        row.packetsLost = live_telemetry_.packetsLost;
+        row.voltage = live_telemetry_.voltage;
+        row.current = live_telemetry_.current;
+        row.temperature = live_telemetry_.temperature;
+        telemetry_store_.append(row);
+    }
+
+    void RadioState::notifyStateChange(uint32_t topics)
     {
-        if (state_change_callback_)
+        dispatcher_.publish(topics);
+    }
+
+    const MetricHistory &RadioState::historyFor(HistoryMetric metric) const
+    {
+        switch (metric)
         {
-            state_change_callback_();
+        case HistoryMetric::LinkQuality:
+            return link_quality_history_;
+        case HistoryMetric::TxPower:
+            return tx_power_history_;
+        default:
+            return rssi_history_;
         }
     }
 
-    void RadioState::addToHistory(std::vector<int> &history, int value)
+    std::vector<int> RadioState::historyValues(HistoryMetric metric, int maxPoints) const
     {
-        history.push_back(value);
-        if (history.size() > MAX_HISTORY_SIZE)
+        std::vector<int> values;
+        if (maxPoints <= 0)
         {
-            history.erase(history.begin());
+            return values;
         }
+
+        values.reserve(static_cast<size_t>(maxPoints));
+        visitHistory(metric, static_cast<size_t>(maxPoints), [&values](const HistorySample &sample)
+                     { values.push_back(sample.value); });
+        return values;
     }
 
     std::string RadioState::formatDuration(std::chrono::steady_clock::duration duration) const
@@ -0,0 +1,191 @@
+#include "replay_transport.h"
+#include "checksum.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace ELRS
+{
+
+    bool ReplayTransport::open(const std::string &path, int baud_rate, bool loop)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            last_error_ = "Failed to open capture " + path;
+            std::cerr << "[REPLAY_ERROR] " << last_error_ << std::endl;
+            return false;
+        }
+
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const size_t size = data.size();
+        if (!openBuffer(std::move(data), baud_rate, loop))
+        {
+            return false;
+        }
+
+        std::cout << "[REPLAY] Loaded " << size << " bytes from " << path
+                  << " (crc32 0x" << std::hex << getCrc32() << std::dec << ")" << std::endl;
+        return true;
+    }
+
+    bool ReplayTransport::openBuffer(std::vector<uint8_t> data, int baud_rate, bool loop)
+    {
+        const uint32_t crc32 = Checksum::crc32(data.data(), data.size());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        data_ = std::move(data);
+        crc32_ = crc32;
+        position_ = 0;
+        bytes_delivered_ = 0;
+        baud_rate_ = baud_rate;
+        loop_ = loop && !data_.empty();
+        open_ = true;
+        start_time_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void ReplayTransport::close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = false;
+    }
+
+    bool ReplayTransport::isConnected() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return open_;
+    }
+
+    bool ReplayTransport::write(const uint8_t *data, size_t length, int timeout_ms)
+    {
+        (void)data;
+        (void)timeout_ms;
+        bool ok = isConnected();
+        recordWrite(length, ok);
+        return ok;
+    }
+
+    int ReplayTransport::read(uint8_t *buffer, size_t buffer_size, int timeout_ms)
+    {
+        if (!waitReadable(timeout_ms))
+        {
+            bool connected = isConnected();
+            recordRead(connected ? 0 : -1);
+            return connected ? 0 : -1;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = std::min(buffer_size, releasableBytes());
+        size_t copied = 0;
+
+        while (copied < count)
+        {
+            if (position_ >= data_.size())
+            {
+                if (!loop_)
+                {
+                    break;
+                }
+                position_ = 0;
+            }
+
+            size_t chunk = std::min(count - copied, data_.size() - position_);
+            std::memcpy(buffer + copied, data_.data() + position_, chunk);
+            position_ += chunk;
+            copied += chunk;
+        }
+
+        bytes_delivered_ += copied;
+        recordRead(static_cast<int>(copied));
+        return static_cast<int>(copied);
+    }
+
+    bool ReplayTransport::waitReadable(int timeout_ms)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        for (;;)
+        {
+            std::chrono::steady_clock::time_point wake;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!open_)
+                {
+                    return false;
+                }
+                if (releasableBytes() > 0)
+                {
+                    return true;
+                }
+                if (!loop_ && position_ >= data_.size())
+                {
+                    return false; // Capture exhausted
+                }
+                wake = nextReleaseTime();
+            }
+
+            if (wake >= deadline)
+            {
+                std::this_thread::sleep_until(deadline);
+                return false;
+            }
+            std::this_thread::sleep_until(wake);
+        }
+    }
+
+    size_t ReplayTransport::getPosition() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return position_;
+    }
+
+    size_t ReplayTransport::getSize() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return data_.size();
+    }
+
+    bool ReplayTransport::finished() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !loop_ && position_ >= data_.size();
+    }
+
+    uint32_t ReplayTransport::getCrc32() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return crc32_;
+    }
+
+    size_t ReplayTransport::releasableBytes() const
+    {
+        size_t remaining = loop_ ? static_cast<size_t>(-1) : data_.size() - position_;
+        if (baud_rate_ <= 0)
+        {
+            return remaining;
+        }
+
+        // 10 bits per byte on an 8-N-1 line
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_time_);
+        uint64_t due = static_cast<uint64_t>(elapsed.count()) * static_cast<uint64_t>(baud_rate_) / 10000000ULL;
+        size_t allowed = due > bytes_delivered_ ? static_cast<size_t>(due - bytes_delivered_) : 0;
+        return std::min(allowed, remaining);
+    }
+
+    std::chrono::steady_clock::time_point ReplayTransport::nextReleaseTime() const
+    {
+        if (baud_rate_ <= 0)
+        {
+            return std::chrono::steady_clock::now();
+        }
+
+        uint64_t us = (static_cast<uint64_t>(bytes_delivered_) + 1) * 10000000ULL / static_cast<uint64_t>(baud_rate_);
+        return start_time_ + std::chrono::microseconds(us);
+    }
+
+} // namespace ELRS
@@ -215,7 +215,18 @@ namespace ELRS
                 if (!isExporting_)
                 {
                     useDateRange_ = !useDateRange_;
-                    statusMessage_ = useDateRange_ ? "Date range filtering enabled" : "Date range filtering disabled";
+                    if (useDateRange_)
+                    {
+                        // Last 24 hours up to now
+                        endDate_ = std::chrono::system_clock::now();
+                        startDate_ = endDate_ - std::chrono::hours(24);
+                        auto samples = getRadioState().getTelemetryStore().count(startDate_, endDate_);
+                        statusMessage_ = "Date range filtering enabled (" + std::to_string(samples) + " telemetry samples)";
+                    }
+                    else
+                    {
+                        statusMessage_ = "Date range filtering disabled";
+                    }
                     markForRefresh();
                 }
                 return true;
@@ -562,37 +573,79 @@ namespace ELRS
                 if (!file.is_open())
                     return false;
 
-                const auto &radioState = getRadioState();
-                const auto &telemetry = radioState.getLiveTelemetry();
+                const auto &store = getRadioState().getTelemetryStore();
 
-                if (format == ExportFormat::CSV)
+                // Date range selects a window of the session store; otherwise export everything held
+                auto from = std::chrono::system_clock::time_point::min();
+                auto to = std::chrono::system_clock::time_point::max();
+                if (useDateRange_)
                 {
-                    file << "Timestamp,LinkQuality,SignalStrength,PacketsRX,PacketsTX\n";
+                    from = startDate_;
+                    to = endDate_;
+                }
 
-                    auto now = std::chrono::system_clock::now();
-                    auto time_t = std::chrono::system_clock::to_time_t(now);
+                auto formatTime = [](std::chrono::system_clock::time_point time)
+                {
+                    auto time_t = std::chrono::system_clock::to_time_t(time);
                     auto tm = *std::localtime(&time_t);
+                    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+
+                    std::stringstream ss;
+                    ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "." << std::setfill('0') << std::setw(3) << ms;
+                    return ss.str();
+                };
 
-                    file << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << ","
-                         << telemetry.linkQuality << ","
-                         << telemetry.rssi1 << ","
-                         << telemetry.packetsReceived << ","
-                         << telemetry.packetsTransmitted << "\n";
+                size_t rows = 0;
+                if (format == ExportFormat::CSV)
+                {
+                    file << "Timestamp,RSSI1,RSSI2,LinkQuality,SNR,TxPower,PacketsRX,PacketsTX,PacketsLost,Voltage,Current,Temperature\n";
+                    file << std::fixed << std::setprecision(3);
+                    store.visitRows(from, to, [&](const TelemetryRow &row)
+                                    {
+                                        file << formatTime(row.time) << ","
+                                             << row.rssi1 << "," << row.rssi2 << ","
+                                             << row.linkQuality << "," << row.snr << "," << row.txPower << ","
+                                             << row.packetsReceived << "," << row.packetsTransmitted << "," << row.packetsLost << ","
+                                             << row.voltage << "," << row.current << "," << row.temperature << "\n";
+                                        rows++; });
                 }
                 else if (format == ExportFormat::JSON)
                 {
+                    auto rssi = store.aggregate(TelemetryColumn::Rssi1, from, to);
+                    auto link = store.aggregate(TelemetryColumn::LinkQuality, from, to);
+
+                    file << std::fixed << std::setprecision(3);
                     file << "{\n";
                     file << "  \"telemetry\": {\n";
-                    file << "    \"linkQuality\": " << telemetry.linkQuality << ",\n";
-                    file << "    \"rssi1\": " << telemetry.rssi1 << ",\n";
-                    file << "    \"packetsReceived\": " << telemetry.packetsReceived << ",\n";
-                    file << "    \"packetsTransmitted\": " << telemetry.packetsTransmitted << "\n";
+                    if (rssi.count > 0)
+                    {
+                        file << "    \"from\": \"" << formatTime(rssi.first) << "\",\n";
+                        file << "    \"to\": \"" << formatTime(rssi.last) << "\",\n";
+                    }
+                    file << "    \"samples\": " << rssi.count << ",\n";
+                    file << "    \"rssi1\": {\"min\": " << rssi.min << ", \"mean\": " << rssi.mean() << ", \"max\": " << rssi.max << "},\n";
+                    file << "    \"linkQuality\": {\"min\": " << link.min << ", \"mean\": " << link.mean() << ", \"max\": " << link.max << "},\n";
+                    file << "    \"rows\": [";
+                    store.visitRows(from, to, [&](const TelemetryRow &row)
+                                    {
+                                        file << (rows == 0 ? "\n" : ",\n");
+                                        file << "      {\"time\": \"" << formatTime(row.time) << "\""
+                                             << ", \"rssi1\": " << row.rssi1 << ", \"rssi2\": " << row.rssi2
+                                             << ", \"linkQuality\": " << row.linkQuality << ", \"snr\": " << row.snr
+                                             << ", \"txPower\": " << row.txPower
+                                             << ", \"packetsReceived\": " << row.packetsReceived
+                                             << ", \"packetsTransmitted\": " << row.packetsTransmitted
+                                             << ", \"packetsLost\": " << row.packetsLost
+                                             << ", \"voltage\": " << row.voltage << ", \"current\": " << row.current
+                                             << ", \"temperature\": " << row.temperature << "}";
+                                        rows++; });
+                    file << (rows == 0 ? "]\n" : "\n    ]\n");
                     file << "  }\n";
                     file << "}\n";
                 }
 
                 file.close();
-                logInfo("Exported telemetry data to: " + fullPath);
+                logInfo("Exported " + std::to_string(rows) + " telemetry rows to: " + fullPath);
                 return true;
             }
             catch (const std::exception &e)
@@ -2,6 +2,7 @@
 #include "serial_bridge.h"
 #include <iostream>
 #include <sstream>
+#include <chrono>
 
 #ifdef _WIN32
 #include <setupapi.h>
@@ -9,17 +10,36 @@
 #include <regstr.h>
 
 #pragma comment(lib, "setupapi.lib")
+#elif defined(__linux__)
+// termios2 lives in the kernel headers; <termios.h> must not be mixed in
+#include <asm/termbits.h>
+#include <asm/ioctls.h>
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cctype>
 #endif
 
 namespace ELRS
 {
 
     SerialBridge::SerialBridge()
-        : connected_(false)
+        :
 #ifdef _WIN32
-          ,
-          serial_handle_(INVALID_HANDLE_VALUE)
+          serial_handle_(INVALID_HANDLE_VALUE),
+#elif defined(__linux__)
+          serial_fd_(-1),
 #endif
+          connected_(false)
     {
     }
 
@@ -32,6 +52,8 @@ namespace ELRS
     {
 #ifdef _WIN32
         return enumerateWindowsComPorts();
+#elif defined(__linux__)
+        return enumerateLinuxComPorts();
 #else
         // Linux/Mac implementation would go here
         return {};
@@ -101,6 +123,38 @@ namespace ELRS
 
         connected_ = true;
         connected_port_.port = port;
+        baud_rate_ = static_cast<uint32_t>(baud_rate);
+
+        std::cout << "[SERIAL] Successfully connected to " << port << " at " << baud_rate << " baud" << std::endl;
+        std::cout << "[SERIAL] Ready for CRSF communication as per practical guide" << std::endl;
+
+        return true;
+#elif defined(__linux__)
+        std::cout << "[SERIAL] Connecting to " << port << " at " << baud_rate << " baud (8-N-1)" << std::endl;
+
+        // Non-blocking so reads can be driven by poll() wakeups
+        serial_fd_ = ::open(port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (serial_fd_ < 0)
+        {
+            setError("Failed to open serial port " + port + ": " + std::strerror(errno));
+            return false;
+        }
+
+        // Exclusive access, mirrors the no-sharing open on Windows
+        ioctl(serial_fd_, TIOCEXCL);
+
+        if (!configureSerialPort(baud_rate))
+        {
+            ::close(serial_fd_);
+            serial_fd_ = -1;
+            return false;
+        }
+
+        enableLowLatency();
+
+        connected_ = true;
+        connected_port_.port = port;
+        baud_rate_ = static_cast<uint32_t>(baud_rate);
 
         std::cout << "[SERIAL] Successfully connected to " << port << " at " << baud_rate << " baud" << std::endl;
         std::cout << "[SERIAL] Ready for CRSF communication as per practical guide" << std::endl;
@@ -123,6 +177,12 @@ namespace ELRS
             CloseHandle(serial_handle_);
             serial_handle_ = INVALID_HANDLE_VALUE;
         }
+#elif defined(__linux__)
+        if (serial_fd_ >= 0)
+        {
+            ::close(serial_fd_);
+            serial_fd_ = -1;
+        }
 #endif
 
         connected_ = false;
@@ -134,7 +194,97 @@ namespace ELRS
         return connected_;
     }
 
+    bool SerialBridge::setBaudRate(uint32_t baud_rate)
+    {
+        if (!connected_)
+        {
+            setError("Not connected");
+            return false;
+        }
+        if (baud_rate == baud_rate_)
+        {
+            return true;
+        }
+
+#if defined(_WIN32) || defined(__linux__)
+        // Bytes still queued at the old rate would be garbage at the new one; configureSerialPort purges them
+        if (!configureSerialPort(static_cast<int>(baud_rate)))
+        {
+            return false;
+        }
+
+        std::cout << "[SERIAL] " << connected_port_.port << " switched from " << baud_rate_ << " to "
+                  << baud_rate << " baud" << std::endl;
+        baud_rate_ = baud_rate;
+        return true;
+#else
+        setError("Serial port support not implemented for this platform");
+        return false;
+#endif
+    }
+
     bool SerialBridge::write(const uint8_t *data, size_t length, int timeout_ms)
+    {
+        bool ok = writeBytes(data, length, timeout_ms);
+        recordWrite(length, ok);
+        return ok;
+    }
+
+    bool SerialBridge::writev(const IoSlice *slices, size_t count, int timeout_ms)
+    {
+#if defined(__linux__)
+        if (!connected_)
+        {
+            setError("Not connected to any COM port");
+            recordWrite(0, false);
+            return false;
+        }
+
+        // Hand header + payload to the tty layer in one syscall
+        struct iovec iov[16];
+        size_t total = 0;
+        if (count <= 16)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                iov[i].iov_base = const_cast<uint8_t *>(slices[i].data);
+                iov[i].iov_len = slices[i].length;
+                total += slices[i].length;
+            }
+
+            ssize_t n = ::writev(serial_fd_, iov, static_cast<int>(count));
+            if (n == static_cast<ssize_t>(total))
+            {
+                recordWrite(total, true);
+                return true;
+            }
+
+            // Short write or EAGAIN: finish the remainder through the regular path
+            size_t sent = n > 0 ? static_cast<size_t>(n) : 0;
+            if (sent > 0)
+            {
+                recordWrite(sent, true);
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (sent >= slices[i].length)
+                {
+                    sent -= slices[i].length;
+                    continue;
+                }
+                if (!write(slices[i].data + sent, slices[i].length - sent, timeout_ms))
+                {
+                    return false;
+                }
+                sent = 0;
+            }
+            return true;
+        }
+#endif
+        return ITransport::writev(slices, count, timeout_ms);
+    }
+
+    bool SerialBridge::writeBytes(const uint8_t *data, size_t length, int timeout_ms)
     {
         if (!connected_)
         {
@@ -152,6 +302,42 @@ namespace ELRS
             return false;
         }
 
+        return true;
+#elif defined(__linux__)
+        size_t written = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        while (written < length)
+        {
+            ssize_t n = ::write(serial_fd_, data + written, length - written);
+            if (n > 0)
+            {
+                written += static_cast<size_t>(n);
+                continue;
+            }
+
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                setError(std::string("Serial write failed: ") + std::strerror(errno));
+                return false;
+            }
+
+            // TX FIFO full - wait for the driver to drain it
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0 || !waitForIo(POLLOUT, static_cast<int>(remaining.count())))
+            {
+                setError("Serial write timed out after " + std::to_string(written) + "/" +
+                         std::to_string(length) + " bytes");
+                return false;
+            }
+        }
+
         return true;
 #else
         setError("Serial write not implemented for this platform");
@@ -160,6 +346,48 @@ namespace ELRS
     }
 
     int SerialBridge::read(uint8_t *buffer, size_t buffer_size, int timeout_ms)
+    {
+        int result = readBytes(buffer, buffer_size, timeout_ms);
+        recordRead(result);
+        return result;
+    }
+
+    bool SerialBridge::waitReadable(int timeout_ms)
+    {
+        if (!connected_)
+        {
+            return false;
+        }
+
+#ifdef _WIN32
+        // Non-overlapped handles cannot wait on comm events with a timeout; poll the input queue
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        for (;;)
+        {
+            COMSTAT status = {0};
+            DWORD errors = 0;
+            if (!ClearCommError(serial_handle_, &errors, &status))
+            {
+                return true; // Let read() report the failure
+            }
+            if (status.cbInQue > 0)
+            {
+                return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            Sleep(1);
+        }
+#elif defined(__linux__)
+        return waitForIo(POLLIN, timeout_ms);
+#else
+        return false;
+#endif
+    }
+
+    int SerialBridge::readBytes(uint8_t *buffer, size_t buffer_size, int timeout_ms)
     {
         if (!connected_)
         {
@@ -168,10 +396,10 @@ namespace ELRS
         }
 
 #ifdef _WIN32
-        // Set read timeout
+        // Set read timeout; MAXDWORD interval with zero totals returns at once (all zeros would block)
         COMMTIMEOUTS timeouts = {0};
-        timeouts.ReadIntervalTimeout = timeout_ms;
-        timeouts.ReadTotalTimeoutConstant = timeout_ms;
+        timeouts.ReadIntervalTimeout = timeout_ms > 0 ? static_cast<DWORD>(timeout_ms) : MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = timeout_ms > 0 ? static_cast<DWORD>(timeout_ms) : 0;
         timeouts.ReadTotalTimeoutMultiplier = 0;
         SetCommTimeouts(serial_handle_, &timeouts);
 
@@ -189,6 +417,36 @@ namespace ELRS
         }
 
         return static_cast<int>(bytes_read);
+#elif defined(__linux__)
+        // Drain whatever is already buffered first; only sleep in poll() when empty
+        for (;;)
+        {
+            ssize_t n = ::read(serial_fd_, buffer, buffer_size);
+            if (n > 0)
+            {
+                return static_cast<int>(n);
+            }
+
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            // VMIN=0 reports an empty queue as 0, O_NONBLOCK as EAGAIN - both mean "wait"
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                setError(std::string("Serial read failed: ") + std::strerror(errno));
+                return -1;
+            }
+
+            if (timeout_ms <= 0 || !waitForIo(POLLIN, timeout_ms))
+            {
+                return 0; // Timeout, same contract as ERROR_TIMEOUT on Windows
+            }
+
+            // Readable now; a second pass must not block again
+            timeout_ms = 0;
+        }
 #else
         setError("Serial read not implemented for this platform");
         return -1;
@@ -295,6 +553,161 @@ namespace ELRS
         SetupDiDestroyDeviceInfoList(hDevInfo);
         return ports;
     }
+
+#elif defined(__linux__)
+    bool SerialBridge::configureSerialPort(int baud_rate)
+    {
+        struct termios2 tio;
+        if (ioctl(serial_fd_, TCGETS2, &tio) != 0)
+        {
+            setError(std::string("Failed to get termios2 state: ") + std::strerror(errno));
+            return false;
+        }
+
+        // Raw 8-N-1, no flow control, no line discipline processing
+        tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+        tio.c_oflag &= ~OPOST;
+        tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+        tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS);
+        tio.c_cflag |= CS8 | CREAD | CLOCAL;
+
+        // BOTHER programs the exact divisor, so 420000 and 416666 are not rounded to a Bxxx constant
+        tio.c_cflag &= ~CBAUD;
+        tio.c_cflag |= BOTHER;
+        tio.c_cflag &= ~(CBAUD << IBSHIFT);
+        tio.c_cflag |= BOTHER << IBSHIFT;
+        tio.c_ispeed = static_cast<speed_t>(baud_rate);
+        tio.c_ospeed = static_cast<speed_t>(baud_rate);
+
+        // VMIN=0/VTIME=0: read() returns immediately, poll() provides the wait
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+
+        if (ioctl(serial_fd_, TCSETS2, &tio) != 0)
+        {
+            setError("Failed to configure serial port at " + std::to_string(baud_rate) +
+                     " baud: " + std::strerror(errno));
+            return false;
+        }
+
+        // Report what the driver actually accepted (pseudo-terminals ignore the speed)
+        if (ioctl(serial_fd_, TCGETS2, &tio) == 0 && tio.c_ospeed != static_cast<speed_t>(baud_rate))
+        {
+            std::cout << "[SERIAL] Driver reports " << tio.c_ospeed << " baud (requested "
+                      << baud_rate << ")" << std::endl;
+        }
+
+        // Purge any existing data
+        ioctl(serial_fd_, TCFLSH, TCIOFLUSH);
+
+        return true;
+    }
+
+    void SerialBridge::enableLowLatency()
+    {
+        // Drops the USB-serial latency timer (16 ms on FTDI/CP210x) so bytes are pushed immediately
+        struct serial_struct serial_info;
+        if (ioctl(serial_fd_, TIOCGSERIAL, &serial_info) != 0)
+        {
+            return; // Not a real UART (ACM/PTY) - nothing to tune
+        }
+
+        serial_info.flags |= ASYNC_LOW_LATENCY;
+        if (ioctl(serial_fd_, TIOCSSERIAL, &serial_info) != 0)
+        {
+            std::cout << "[SERIAL] ASYNC_LOW_LATENCY not accepted: " << std::strerror(errno) << std::endl;
+        }
+    }
+
+    bool SerialBridge::waitForIo(short events, int timeout_ms)
+    {
+        struct pollfd pfd;
+        pfd.fd = serial_fd_;
+        pfd.events = events;
+        pfd.revents = 0;
+
+        for (;;)
+        {
+            int rc = ::poll(&pfd, 1, timeout_ms);
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (rc <= 0)
+            {
+                return false;
+            }
+            // POLLERR/POLLHUP are reported as ready so the next read()/write() surfaces the error
+            return true;
+        }
+    }
+
+    std::vector<SerialBridge::ComPortInfo> SerialBridge::enumerateLinuxComPorts()
+    {
+        namespace fs = std::filesystem;
+        std::vector<ComPortInfo> ports;
+
+        auto readAttribute = [](const fs::path &file)
+        {
+            std::ifstream in(file);
+            std::string value;
+            std::getline(in, value);
+            return value;
+        };
+
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator("/sys/class/tty", ec))
+        {
+            std::string name = entry.path().filename().string();
+            if (name.rfind("ttyUSB", 0) != 0 && name.rfind("ttyACM", 0) != 0)
+            {
+                continue;
+            }
+
+            ComPortInfo port_info;
+            port_info.port = "/dev/" + name;
+
+            // device/ points at the USB interface (ACM) or the usb-serial port below it;
+            // walk up until the USB device node that carries idVendor/idProduct
+            fs::path node = fs::canonical(entry.path() / "device", ec);
+            std::error_code driver_ec; // Keep a missing driver link from ending the walk below
+            std::string driver = fs::canonical(entry.path() / "device" / "driver", driver_ec).filename().string();
+            while (!ec && !node.empty() && node != node.root_path())
+            {
+                if (fs::exists(node / "idVendor"))
+                {
+                    std::string vid = readAttribute(node / "idVendor");
+                    std::string pid = readAttribute(node / "idProduct");
+                    std::transform(vid.begin(), vid.end(), vid.begin(), ::toupper);
+                    std::transform(pid.begin(), pid.end(), pid.begin(), ::toupper);
+
+                    // Same shape as the SetupAPI hardware ID so findElrsComPorts matches on both platforms
+                    port_info.hardware_id = "USB\\VID_" + vid + "&PID_" + pid;
+
+                    std::string manufacturer = readAttribute(node / "manufacturer");
+                    std::string product = readAttribute(node / "product");
+                    port_info.description = manufacturer.empty() ? product : manufacturer + " " + product;
+                    break;
+                }
+                node = node.parent_path();
+            }
+
+            if (port_info.description.empty())
+            {
+                port_info.description = driver.empty() ? name : driver;
+            }
+            else if (!driver.empty())
+            {
+                port_info.description += " (" + driver + ")";
+            }
+
+            ports.push_back(port_info);
+        }
+
+        std::sort(ports.begin(), ports.end(), [](const ComPortInfo &a, const ComPortInfo &b)
+                  { return a.port < b.port; });
+        return ports;
+    }
 #endif
 
     void SerialBridge::setError(const std::string &error)
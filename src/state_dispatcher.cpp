@@ -0,0 +1,209 @@
+#include "state_dispatcher.h"
+#include "radio_state.h"
+#include <algorithm>
+#include <vector>
+
+namespace ELRS
+{
+
+    StateDispatcher::StateDispatcher(SnapshotSource source)
+        : source_(std::move(source))
+    {
+    }
+
+    StateDispatcher::~StateDispatcher()
+    {
+        stop();
+    }
+
+    SubscriptionId StateDispatcher::subscribe(uint32_t topics, StateSubscriber callback)
+    {
+        auto subscriber = std::make_shared<Subscriber>();
+        subscriber->topics = topics & StateTopic::All;
+        subscriber->callback = std::move(callback);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscriber->id = next_id_++;
+        subscribers_[subscriber->id] = subscriber;
+        if (!running_)
+        {
+            running_ = true;
+            executor_ = std::thread(&StateDispatcher::executorLoop, this);
+        }
+        return subscriber->id;
+    }
+
+    void StateDispatcher::unsubscribe(SubscriptionId id)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = subscribers_.find(id);
+        if (it == subscribers_.end())
+        {
+            return;
+        }
+        const Subscriber *subscriber = it->second.get();
+        subscribers_.erase(it);
+
+        // A callback unsubscribing itself cannot wait for itself
+        if (std::this_thread::get_id() == executor_.get_id())
+        {
+            return;
+        }
+        cv_.wait(lock, [this, subscriber]
+                 { return delivering_ != subscriber; });
+    }
+
+    void StateDispatcher::publish(uint32_t topics)
+    {
+        const auto now = Clock::now();
+        bool matched = false;
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &entry : subscribers_)
+            {
+                Subscriber &subscriber = *entry.second;
+                if ((subscriber.topics & topics) == 0)
+                {
+                    continue;
+                }
+                if (subscriber.pending_count == 0)
+                {
+                    subscriber.pending_since = now;
+                }
+                subscriber.pending_topics |= topics;
+                subscriber.pending_count++;
+                subscriber.stats.changes++;
+                subscriber.stats.max_pending = std::max(subscriber.stats.max_pending, subscriber.pending_count);
+                matched = true;
+            }
+
+            // Only the first change of a tick needs to wake the executor
+            wake = matched && !dirty_;
+            dirty_ = dirty_ || matched;
+        }
+        if (wake)
+        {
+            cv_.notify_all();
+        }
+    }
+
+    bool StateDispatcher::getStats(SubscriptionId id, SubscriberStats &stats) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscribers_.find(id);
+        if (it == subscribers_.end())
+        {
+            return false;
+        }
+        stats = it->second->stats;
+        stats.pending = it->second->pending_count;
+        return true;
+    }
+
+    void StateDispatcher::stop()
+    {
+        std::thread executor;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+            executor = std::move(executor_);
+        }
+        cv_.notify_all();
+
+        if (!executor.joinable())
+        {
+            return;
+        }
+        if (executor.get_id() == std::this_thread::get_id())
+        {
+            executor.detach();
+            return;
+        }
+        executor.join();
+    }
+
+    void StateDispatcher::executorLoop()
+    {
+        std::vector<Delivery> deliveries;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_)
+        {
+            cv_.wait(lock, [this]
+                     { return dirty_ || !running_; });
+            if (!running_)
+            {
+                break;
+            }
+
+            // Let the rest of the burst arrive
+            cv_.wait_for(lock, std::chrono::nanoseconds(tick_ns_.load()), [this]
+                         { return !running_; });
+            if (!running_)
+            {
+                break;
+            }
+            dirty_ = false;
+
+            deliveries.clear();
+            for (auto &entry : subscribers_)
+            {
+                Subscriber &subscriber = *entry.second;
+                if (subscriber.pending_count == 0)
+                {
+                    continue;
+                }
+                Delivery delivery;
+                delivery.subscriber = entry.second;
+                delivery.change.topics = subscriber.pending_topics & subscriber.topics;
+                delivery.change.coalesced = subscriber.pending_count;
+                delivery.pending_since = subscriber.pending_since;
+                deliveries.push_back(std::move(delivery));
+
+                subscriber.pending_topics = 0;
+                subscriber.pending_count = 0;
+            }
+            lock.unlock();
+
+            // Publishers mark pending after publishing, so this covers every change collected above
+            auto snapshot = source_();
+
+            for (auto &delivery : deliveries)
+            {
+                Subscriber *subscriber = delivery.subscriber.get();
+
+                lock.lock();
+                if (subscribers_.find(subscriber->id) == subscribers_.end())
+                {
+                    lock.unlock();
+                    continue;
+                }
+                delivering_ = subscriber;
+                lock.unlock();
+
+                delivery.change.version = snapshot ? snapshot->version : 0;
+                delivery.change.snapshot = snapshot;
+
+                const auto start = Clock::now();
+                subscriber->callback(delivery.change);
+                const auto end = Clock::now();
+
+                lock.lock();
+                delivering_ = nullptr;
+                SubscriberStats &stats = subscriber->stats;
+                stats.deliveries++;
+                stats.coalesced += delivery.change.coalesced - 1;
+                stats.last_latency_ms = std::chrono::duration<double, std::milli>(start - delivery.pending_since).count();
+                stats.max_latency_ms = std::max(stats.max_latency_ms, stats.last_latency_ms);
+                stats.max_callback_ms = std::max(stats.max_callback_ms,
+                                                 std::chrono::duration<double, std::milli>(end - start).count());
+                lock.unlock();
+                cv_.notify_all();
+            }
+            deliveries.clear();
+            lock.lock();
+        }
+    }
+
+} // namespace ELRS
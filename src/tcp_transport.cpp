@@ -0,0 +1,313 @@
+#define NOMINMAX // Prevent Windows max/min macro conflicts
+#include "tcp_transport.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using socket_t = SOCKET;
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using socket_t = int;
+#endif
+
+namespace ELRS
+{
+    namespace
+    {
+        socket_t toSocket(intptr_t value) { return static_cast<socket_t>(value); }
+
+        int lastSocketError()
+        {
+#ifdef _WIN32
+            return WSAGetLastError();
+#else
+            return errno;
+#endif
+        }
+
+        bool wouldBlock(int error)
+        {
+#ifdef _WIN32
+            return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS;
+#else
+            return error == EAGAIN || error == EWOULDBLOCK || error == EINPROGRESS;
+#endif
+        }
+
+        // The peer reset or shut down the connection
+        bool connectionLost(int error)
+        {
+#ifdef _WIN32
+            return error == WSAECONNRESET || error == WSAECONNABORTED || error == WSAESHUTDOWN;
+#else
+            return error == EPIPE || error == ECONNRESET;
+#endif
+        }
+
+        // Writing to a reset connection must fail with EPIPE, not raise SIGPIPE and end the process
+#ifdef MSG_NOSIGNAL
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+        constexpr int SEND_FLAGS = 0; // Windows has no SIGPIPE; macOS uses SO_NOSIGPIPE (see connect())
+#endif
+
+        void closeSocket(socket_t socket)
+        {
+#ifdef _WIN32
+            closesocket(socket);
+#else
+            ::close(socket);
+#endif
+        }
+
+        void setNonBlocking(socket_t socket)
+        {
+#ifdef _WIN32
+            u_long mode = 1;
+            ioctlsocket(socket, FIONBIO, &mode);
+#else
+            fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+        }
+    }
+
+    TcpTransport::TcpTransport()
+        : socket_(INVALID_SOCKET_VALUE)
+    {
+#ifdef _WIN32
+        WSADATA wsa_data;
+        WSAStartup(MAKEWORD(2, 2), &wsa_data);
+#endif
+    }
+
+    TcpTransport::~TcpTransport()
+    {
+        disconnect();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    bool TcpTransport::connect(const std::string &host, uint16_t port, int timeout_ms)
+    {
+        disconnect();
+
+        std::cout << "[TCP] Connecting to " << host << ":" << port << std::endl;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo *results = nullptr;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &results) != 0 || !results)
+        {
+            setError("Failed to resolve " + host);
+            return false;
+        }
+
+        for (addrinfo *ai = results; ai; ai = ai->ai_next)
+        {
+            socket_t s = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (s == toSocket(INVALID_SOCKET_VALUE))
+            {
+                continue;
+            }
+
+            setNonBlocking(s);
+
+            int rc = ::connect(s, ai->ai_addr, static_cast<int>(ai->ai_addrlen));
+            if (rc == 0 || (wouldBlock(lastSocketError()) && waitSocket(static_cast<intptr_t>(s), true, timeout_ms)))
+            {
+                int so_error = 0;
+                socklen_t len = sizeof(so_error);
+                getsockopt(s, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&so_error), &len);
+                if (so_error == 0)
+                {
+                    int nodelay = 1;
+                    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&nodelay), sizeof(nodelay));
+#ifdef SO_NOSIGPIPE
+                    int nosigpipe = 1;
+                    setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &nosigpipe, sizeof(nosigpipe));
+#endif
+                    peer_closed_.store(false);
+                    socket_.store(static_cast<intptr_t>(s));
+                    break;
+                }
+            }
+
+            closeSocket(s);
+        }
+        freeaddrinfo(results);
+
+        if (!isConnected())
+        {
+            setError("Unable to connect to " + host + ":" + std::to_string(port));
+            return false;
+        }
+
+        endpoint_ = host + ":" + std::to_string(port);
+        std::cout << "[TCP] Connected to " << endpoint_ << std::endl;
+        return true;
+    }
+
+    void TcpTransport::disconnect()
+    {
+        // Also reached after the peer closed: the socket is still ours to release
+        intptr_t socket = socket_.exchange(INVALID_SOCKET_VALUE);
+        if (socket == INVALID_SOCKET_VALUE)
+        {
+            return;
+        }
+
+        closeSocket(toSocket(socket));
+        std::cout << "[TCP] Disconnected from " << endpoint_ << std::endl;
+    }
+
+    bool TcpTransport::write(const uint8_t *data, size_t length, int timeout_ms)
+    {
+        if (!isConnected())
+        {
+            setError("Not connected");
+            recordWrite(length, false);
+            return false;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        size_t sent = 0;
+
+        while (sent < length)
+        {
+            int n = ::send(toSocket(socket_.load()), reinterpret_cast<const char *>(data + sent),
+                           static_cast<int>(length - sent), SEND_FLAGS);
+            if (n > 0)
+            {
+                sent += static_cast<size_t>(n);
+                continue;
+            }
+
+            int error = lastSocketError();
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (n < 0 && wouldBlock(error) && remaining.count() > 0 &&
+                waitSocket(socket_.load(), true, static_cast<int>(remaining.count())))
+            {
+                continue;
+            }
+
+            if (n < 0 && connectionLost(error))
+            {
+                peer_closed_.store(true); // Same as a close seen by read(); the owner closes the socket
+                setError("Connection closed by peer");
+            }
+            else
+            {
+                setError("TCP send failed: " + std::to_string(error));
+            }
+            recordWrite(length, false);
+            return false;
+        }
+
+        recordWrite(length, true);
+        return true;
+    }
+
+    int TcpTransport::read(uint8_t *buffer, size_t buffer_size, int timeout_ms)
+    {
+        if (!isConnected())
+        {
+            setError("Not connected");
+            recordRead(-1);
+            return -1;
+        }
+
+        if (!waitReadable(timeout_ms))
+        {
+            recordRead(0);
+            return 0;
+        }
+
+        int n = ::recv(toSocket(socket_.load()), reinterpret_cast<char *>(buffer), static_cast<int>(buffer_size), 0);
+        if (n == 0)
+        {
+            // Mark the link down; closing is left to the owner so a concurrent write() never sees a reused fd
+            peer_closed_.store(true);
+            setError("Connection closed by peer");
+            recordRead(-1);
+            return -1;
+        }
+        if (n < 0)
+        {
+            int error = lastSocketError();
+            if (wouldBlock(error))
+            {
+                recordRead(0);
+                return 0;
+            }
+            if (connectionLost(error))
+            {
+                peer_closed_.store(true);
+                setError("Connection closed by peer");
+                recordRead(-1);
+                return -1;
+            }
+            setError("TCP receive failed: " + std::to_string(error));
+            recordRead(-1);
+            return -1;
+        }
+
+        recordRead(n);
+        return n;
+    }
+
+    bool TcpTransport::waitReadable(int timeout_ms)
+    {
+        return isConnected() && waitSocket(socket_.load(), false, timeout_ms);
+    }
+
+    bool TcpTransport::waitSocket(intptr_t socket, bool for_write, int timeout_ms)
+    {
+#ifdef _WIN32
+        // Winsock fd_sets hold socket handles, not bit positions, so FD_SETSIZE does not limit the value
+        socket_t s = toSocket(socket);
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(s, &set);
+
+        timeval tv;
+        tv.tv_sec = timeout_ms / 1000;
+        tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+        int rc = ::select(0, for_write ? nullptr : &set, for_write ? &set : nullptr, nullptr, &tv);
+        return rc > 0;
+#else
+        // poll() has no FD_SETSIZE ceiling on the descriptor number
+        pollfd pfd;
+        pfd.fd = toSocket(socket);
+        pfd.events = for_write ? POLLOUT : POLLIN;
+        pfd.revents = 0;
+
+        int rc = ::poll(&pfd, 1, timeout_ms);
+        return rc > 0 && (pfd.revents & (for_write ? POLLOUT : POLLIN | POLLHUP)) != 0;
+#endif
+    }
+
+    void TcpTransport::setError(const std::string &error)
+    {
+        last_error_ = error;
+        std::cerr << "[TCP_ERROR] " << error << std::endl;
+    }
+
+} // namespace ELRS
@@ -1,46 +1,146 @@
 #include "telemetry_handler.h"
-#include "usb_bridge.h"
+#include "crsf_protocol.h"
+#include "transport.h"
 #include "radio_state.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <cstring>
+#include <map>
 #include <utility>
 #include <cstdint>
 
 namespace ELRS
 {
 
-    TelemetryHandler::TelemetryHandler(UsbBridge *usb_bridge)
-        : usb_bridge_(usb_bridge)
+    namespace
     {
-        msp_payload_.reserve(128);
+        constexpr uint8_t CRSF_FRAMETYPE_BATTERY_SENSOR = 0x08;
+        constexpr uint8_t CRSF_FRAMETYPE_LINK_STATISTICS = 0x14;
+        constexpr uint8_t CRSF_FRAMETYPE_DEVICE_INFO = 0x29;
+        constexpr uint8_t CRSF_FRAMETYPE_RADIO_ID = 0x3A;
+        constexpr uint8_t CRSF_RADIO_ID_SUBTYPE_TIMING = 0x10;
+        constexpr uint8_t MSP_DEVICE_INFO = 0x29;
+
+        // Receive ring: ~120ms at 5.25 Mbaud before a stalled parser loses bytes
+        constexpr size_t RX_RING_SIZE = 65536;
+        constexpr size_t READ_CHUNK = 4096;
+        constexpr size_t ARRIVAL_MARKS = 1024;
+
+        // Decoded events retained for subscribers: several seconds at full telemetry rate
+        constexpr size_t EVENT_RING_SIZE = 1024;
+
+        // Readiness wait; bounds how long stop() takes
+        constexpr int READ_WAIT_MS = 50;
+
+        // LINK_STATISTICS uplink TX power enum to mW
+        constexpr int CRSF_POWER_MW[] = {0, 10, 25, 100, 500, 1000, 2000, 250, 50};
+
+        // One handler per transport, shared by everything that reads from it
+        std::mutex registry_mutex;
+        std::map<ITransport *, std::weak_ptr<TelemetryHandler>> &handlerRegistry()
+        {
+            static std::map<ITransport *, std::weak_ptr<TelemetryHandler>> registry;
+            return registry;
+        }
+    }
+
+    bool TelemetrySubscription::poll(TelemetryEvent &event)
+    {
+        return ring_->tryRead(cursor_, event, lost_);
+    }
+
+    bool TelemetrySubscription::wait(TelemetryEvent &event, std::chrono::milliseconds timeout)
+    {
+        if (poll(event))
+        {
+            return true;
+        }
+        return ring_->waitFor(cursor_, timeout) && poll(event);
+    }
+
+    uint64_t TelemetrySubscription::getBacklog() const
+    {
+        return ring_->backlog(cursor_);
+    }
+
+    TelemetryHandler::TelemetryHandler(ITransport *transport)
+        : transport_(transport), rx_ring_(RX_RING_SIZE), arrivals_(ARRIVAL_MARKS), events_(EVENT_RING_SIZE)
+    {
+        registerFrameHandlers();
     }
 
     TelemetryHandler::~TelemetryHandler()
     {
-        stop();
+        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+        stopThreads();
     }
 
-    void TelemetryHandler::start()
+    std::shared_ptr<TelemetryHandler> TelemetryHandler::acquire(ITransport *transport)
     {
-        if (running_.load())
+        if (!transport)
         {
-            return; // Already running
+            return std::make_shared<TelemetryHandler>(transport);
         }
 
-        if (!usb_bridge_ || !usb_bridge_->isConnected())
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto &registry = handlerRegistry();
+
+        // Drop entries whose last owner is gone (their transports may since have been freed)
+        for (auto it = registry.begin(); it != registry.end();)
         {
-            setError("USB device not connected");
-            return;
+            if (it->second.expired())
+            {
+                it = registry.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        std::shared_ptr<TelemetryHandler> handler = registry[transport].lock();
+        if (!handler)
+        {
+            handler = std::make_shared<TelemetryHandler>(transport);
+            registry[transport] = handler;
+        }
+        return handler;
+    }
+
+    bool TelemetryHandler::start()
+    {
+        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+        if (!transport_ || !transport_->isConnected())
+        {
+            setError("Transport not connected");
+            return false;
+        }
+
+        if (users_++ > 0)
+        {
+            return true; // Already running for another owner
         }
 
         running_.store(true);
         telemetry_thread_ = std::make_unique<std::thread>(&TelemetryHandler::telemetryLoop, this);
+        reader_thread_ = std::make_unique<std::thread>(&TelemetryHandler::readerLoop, this);
 
-        std::cout << "📡 TELEMETRY: Started monitoring at 50Hz" << std::endl;
+        std::cout << "📡 TELEMETRY: Started event-driven monitoring" << std::endl;
+        return true;
     }
 
     void TelemetryHandler::stop()
+    {
+        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+        if (users_ == 0 || --users_ > 0)
+        {
+            return; // Not started, or other owners still need the reader
+        }
+        stopThreads();
+    }
+
+    void TelemetryHandler::stopThreads()
     {
         if (!running_.load())
         {
@@ -48,6 +148,17 @@ namespace ELRS
         }
 
         running_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(parser_mutex_);
+            parser_cv_.notify_one();
+        }
+        events_.notifyAll();
+
+        if (reader_thread_ && reader_thread_->joinable())
+        {
+            reader_thread_->join();
+        }
+        reader_thread_.reset();
 
         if (telemetry_thread_ && telemetry_thread_->joinable())
         {
@@ -58,161 +169,330 @@ namespace ELRS
         std::cout << "📡 TELEMETRY: Stopped monitoring" << std::endl;
     }
 
-    void TelemetryHandler::telemetryLoop()
+    template <typename Callback>
+    TelemetryHandler::CallbackId TelemetryHandler::addCallback(CallbackList<Callback> &list, Callback callback)
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        CallbackId id = next_callback_id_++;
+        list.emplace_back(id, std::move(callback));
+        return id;
+    }
+
+    template <typename Callback, typename Value>
+    void TelemetryHandler::invokeCallbacks(const CallbackList<Callback> &list, const Value &value)
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        for (const auto &entry : list)
+        {
+            entry.second(value);
+        }
+    }
+
+    TelemetryHandler::CallbackId TelemetryHandler::addLinkStatsCallback(LinkStatsCallback callback)
+    {
+        return addCallback(link_stats_callbacks_, std::move(callback));
+    }
+
+    TelemetryHandler::CallbackId TelemetryHandler::addBatteryCallback(BatteryCallback callback)
+    {
+        return addCallback(battery_callbacks_, std::move(callback));
+    }
+
+    TelemetryHandler::CallbackId TelemetryHandler::addSpectrumCallback(SpectrumCallback callback)
+    {
+        return addCallback(spectrum_callbacks_, std::move(callback));
+    }
+
+    TelemetryHandler::CallbackId TelemetryHandler::addTimingSyncCallback(TimingSyncCallback callback)
+    {
+        return addCallback(timing_sync_callbacks_, std::move(callback));
+    }
+
+    TelemetryHandler::CallbackId TelemetryHandler::addMspReplyCallback(MspReplyCallback callback)
+    {
+        return addCallback(msp_reply_callbacks_, std::move(callback));
+    }
+
+    void TelemetryHandler::removeCallback(CallbackId id)
     {
-        uint8_t buffer[256];
+        auto erase = [id](auto &list)
+        {
+            list.erase(std::remove_if(list.begin(), list.end(), [id](const auto &entry)
+                                      { return entry.first == id; }),
+                       list.end());
+        };
+
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        erase(link_stats_callbacks_);
+        erase(battery_callbacks_);
+        erase(spectrum_callbacks_);
+        erase(timing_sync_callbacks_);
+        erase(msp_reply_callbacks_);
+    }
 
-        std::cout << "📡 TELEMETRY_LOOP: Active - reading from USB at 50Hz" << std::endl;
+    TelemetryReaderStats TelemetryHandler::getReaderStats() const
+    {
+        TelemetryReaderStats stats;
+        stats.bytes_read = bytes_read_.load(std::memory_order_relaxed);
+        stats.wakeups = reader_wakeups_.load(std::memory_order_relaxed);
+        stats.bytes_dropped = rx_ring_.droppedBytes();
+        stats.transport_bytes_dropped = transport_ ? transport_->getStats().bytes_dropped : 0;
+        stats.latency_mean_us = wire_latency_ns_.getMean() / 1000.0;
+        stats.latency_p50_us = static_cast<double>(wire_latency_ns_.getPercentile(50.0)) / 1000.0;
+        stats.latency_p99_us = static_cast<double>(wire_latency_ns_.getPercentile(99.0)) / 1000.0;
+        stats.latency_max_us = static_cast<double>(wire_latency_ns_.getMax()) / 1000.0;
+        return stats;
+    }
+
+    void TelemetryHandler::readerLoop()
+    {
+        uint8_t chunk[READ_CHUNK];
+
+        std::cout << "📡 TELEMETRY_READER: Active - waiting on " << transport_->getTransportName() << " readiness" << std::endl;
 
         while (running_.load())
         {
-            if (!usb_bridge_->isConnected())
+            if (!transport_->isConnected())
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
                 continue;
             }
 
-            // Read with short timeout to keep loop responsive
-            int bytes_read = usb_bridge_->read(buffer, sizeof(buffer), 20);
+            auto waited = Clock::now();
+            if (!transport_->waitReadable(READ_WAIT_MS))
+            {
+                // Transports that cannot block (an exhausted replay) report not-ready at once
+                if (Clock::now() - waited < std::chrono::milliseconds(1))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(READ_WAIT_MS));
+                }
+                continue;
+            }
+            auto arrival = Clock::now();
+
+            // Drain everything that is buffered, without waiting for more
+            size_t drained = 0;
+            bool failed = false;
+            for (;;)
+            {
+                int n = transport_->read(chunk, sizeof(chunk), 0);
+                if (n <= 0)
+                {
+                    failed = n < 0;
+                    break;
+                }
+                rx_accepted_ += rx_ring_.write(chunk, static_cast<size_t>(n));
+                drained += static_cast<size_t>(n);
+                if (static_cast<size_t>(n) < sizeof(chunk))
+                {
+                    break;
+                }
+            }
 
-            for (int i = 0; i < bytes_read; ++i)
+            if (drained == 0)
             {
-                feedMspByte(buffer[i]);
+                // Spurious readiness or a read error: back off instead of spinning
+                std::this_thread::sleep_for(std::chrono::milliseconds(failed ? 100 : 1));
+                continue;
             }
 
-            // 50Hz telemetry loop (20ms interval)
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            bytes_read_.fetch_add(drained, std::memory_order_relaxed);
+            reader_wakeups_.fetch_add(1, std::memory_order_relaxed);
+            uint64_t end = rx_accepted_;
+            arrivals_.push([&](ArrivalMark &mark)
+                           {
+                               mark.end = end;
+                               mark.arrival = arrival; }); // A full queue only skips a latency sample
+            wakeParser();
         }
 
-        std::cout << "📡 TELEMETRY_LOOP: Exited" << std::endl;
+        std::cout << "📡 TELEMETRY_READER: Exited" << std::endl;
     }
 
-    void TelemetryHandler::feedMspByte(uint8_t byte)
+    void TelemetryHandler::telemetryLoop()
     {
-        switch (msp_state_)
+        uint8_t buffer[READ_CHUNK];
+
+        while (running_.load())
         {
-        case MspParserState::Idle:
-            if (byte == '$')
-            {
-                msp_state_ = MspParserState::ExpectM;
-            }
-            break;
+            // Anything the reader adds after this point forces another pass before parking
+            uint64_t seen = rx_signal_.load(std::memory_order_acquire);
 
-        case MspParserState::ExpectM:
-            if (byte == 'M')
+            size_t n = rx_ring_.read(buffer, sizeof(buffer));
+            if (n > 0)
             {
-                msp_state_ = MspParserState::ExpectDirection;
-            }
-            else
-            {
-                resetMspParser();
-            }
-            break;
+                demuxer_.feed(buffer, n);
+                rx_parsed_ += n;
 
-        case MspParserState::ExpectDirection:
-            if (byte == '<' || byte == '>')
-            {
-                msp_from_device_ = (byte == '>');
-                msp_state_ = MspParserState::ExpectLength;
-            }
-            else
-            {
-                resetMspParser();
-            }
-            break;
-
-        case MspParserState::ExpectLength:
-            msp_expected_length_ = byte;
-            msp_checksum_ = byte;
-            msp_payload_.clear();
-            msp_state_ = MspParserState::ExpectFunction;
-            break;
-
-        case MspParserState::ExpectFunction:
-            msp_function_ = byte;
-            msp_checksum_ ^= byte;
-            if (msp_expected_length_ == 0)
-            {
-                msp_state_ = MspParserState::ExpectChecksum;
-            }
-            else
-            {
-                msp_state_ = MspParserState::ReadPayload;
+                // Every chunk now fully dispatched contributes one wire-to-dispatch sample
+                auto dispatched = Clock::now();
+                for (ArrivalMark *mark = arrivals_.front(); mark && mark->end <= rx_parsed_; mark = arrivals_.front())
+                {
+                    wire_latency_ns_.record(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(dispatched - mark->arrival).count()));
+                    arrivals_.pop();
+                }
+                continue;
             }
-            break;
 
-        case MspParserState::ReadPayload:
-            msp_payload_.push_back(byte);
-            msp_checksum_ ^= byte;
-            if (msp_payload_.size() >= msp_expected_length_)
+            std::unique_lock<std::mutex> lock(parser_mutex_);
+            parser_parked_.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (rx_signal_.load(std::memory_order_relaxed) == seen && running_.load())
             {
-                msp_state_ = MspParserState::ExpectChecksum;
+                parser_cv_.wait_for(lock, std::chrono::milliseconds(100));
             }
-            break;
+            parser_parked_.store(false);
+        }
 
-        case MspParserState::ExpectChecksum:
+        std::cout << "📡 TELEMETRY_LOOP: Exited" << std::endl;
+    }
+
+    void TelemetryHandler::wakeParser()
+    {
+        rx_signal_.fetch_add(1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parser_parked_.load(std::memory_order_relaxed))
         {
-            uint8_t expected = msp_checksum_;
-            bool checksum_ok = (expected == byte);
-            if (checksum_ok)
-            {
-                handleMspFrame(msp_function_, msp_from_device_, msp_payload_);
-            }
-            resetMspParser();
-            break;
-        }
+            std::lock_guard<std::mutex> lock(parser_mutex_);
+            parser_cv_.notify_one();
         }
     }
 
-    void TelemetryHandler::resetMspParser()
+    void TelemetryHandler::registerFrameHandlers()
     {
-        msp_state_ = MspParserState::Idle;
-        msp_from_device_ = false;
-        msp_expected_length_ = 0;
-        msp_function_ = 0;
-        msp_checksum_ = 0;
-        msp_payload_.clear();
+        // MSP replies from the TX module ('<' frames are our own requests echoed back)
+        demuxer_.setMspHandler(0x2D, [this](const MspFrameView &frame) // ELRS telemetry response
+                               {
+                                   LinkStats link_stats;
+                                   if (frame.fromDevice() &&
+                                       parseLinkStats(frame.payload.data(), static_cast<int>(frame.payload.size()), link_stats))
+                                   {
+                                       publishLinkStats(link_stats);
+                                   }
+                                   forwardMspReply(frame); });
+
+        demuxer_.setMspHandler(0x2E, [this](const MspFrameView &frame) // Battery telemetry
+                               {
+                                   BatteryInfo battery_info;
+                                   if (frame.fromDevice() &&
+                                       parseBatteryInfo(frame.payload.data(), static_cast<int>(frame.payload.size()), battery_info))
+                                   {
+                                       publishBattery(battery_info);
+                                   }
+                                   forwardMspReply(frame); });
+
+        // CRSF telemetry interleaved on the same stream
+        demuxer_.setCrsfHandler(CRSF_FRAMETYPE_LINK_STATISTICS, [this](const CrsfFrameView &frame)
+                                {
+                                    LinkStats link_stats;
+                                    if (parseCrsfLinkStats(frame.payload.data(), static_cast<int>(frame.payload.size()), link_stats))
+                                    {
+                                        publishLinkStats(link_stats);
+                                    } });
+
+        demuxer_.setCrsfHandler(CRSF_FRAMETYPE_BATTERY_SENSOR, [this](const CrsfFrameView &frame)
+                                {
+                                    BatteryInfo battery_info;
+                                    if (parseCrsfBattery(frame.payload.data(), static_cast<int>(frame.payload.size()), battery_info))
+                                    {
+                                        publishBattery(battery_info);
+                                    } });
+
+        // Module timing sync: drives the TX scheduler's period and phase
+        demuxer_.setCrsfHandler(CRSF_FRAMETYPE_RADIO_ID, [this](const CrsfFrameView &frame)
+                                {
+                                    TimingSync sync;
+                                    if (parseCrsfTimingSync(frame.payload.data(), static_cast<int>(frame.payload.size()), sync))
+                                    {
+                                        publishTimingSync(sync);
+                                    } });
+
+        // Device ping replies; modules answer the MSP ping in MSP or as a CRSF DEVICE_INFO frame
+        demuxer_.setMspHandler(MSP_DEVICE_INFO, [this](const MspFrameView &frame)
+                               {
+                                   if (frame.fromDevice())
+                                   {
+                                       device_info_replies_.fetch_add(1, std::memory_order_acq_rel);
+                                   }
+                                   forwardMspReply(frame); });
+
+        demuxer_.setCrsfHandler(CRSF_FRAMETYPE_DEVICE_INFO, [this](const CrsfFrameView &frame)
+                                {
+                                    device_info_replies_.fetch_add(1, std::memory_order_acq_rel);
+
+                                    MspFrameView reply;
+                                    reply.function = MSP_DEVICE_INFO;
+                                    reply.payload = frame.payload;
+                                    reply.raw = frame.raw;
+                                    forwardMspReply(reply); });
+
+        // Replies to every other MSP request only matter to the correlator
+        demuxer_.setDefaultMspHandler([this](const MspFrameView &frame)
+                                      { forwardMspReply(frame); });
+
+        // UART speed negotiation replies
+        demuxer_.setCrsfHandler(CrsfProtocol::CRSF_FRAMETYPE_COMMAND, [this](const CrsfFrameView &frame)
+                                {
+                                    uint8_t port_id = 0;
+                                    bool accepted = false;
+                                    if (CrsfProtocol::parseSpeedResponsePayload(frame.payload.data(), frame.payload.size(),
+                                                                                port_id, accepted))
+                                    {
+                                        last_speed_accepted_.store(accepted, std::memory_order_release);
+                                        speed_responses_.fetch_add(1, std::memory_order_acq_rel);
+                                    } });
     }
 
-    void TelemetryHandler::handleMspFrame(uint8_t function, bool fromDevice, const std::vector<uint8_t> &payload)
+    void TelemetryHandler::publishLinkStats(const LinkStats &stats)
     {
-        if (!fromDevice)
-        {
-            return;
-        }
+        latest_link_stats_ = stats;
+        invokeCallbacks(link_stats_callbacks_, stats);
 
-        LinkStats link_stats;
-        BatteryInfo battery_info;
+        TelemetryEvent event;
+        event.type = TelemetryEventType::LinkStats;
+        event.link_stats = stats;
+        broadcast(event);
+    }
 
-        switch (function)
-        {
-        case 0x2D: // ELRS telemetry response
-            if (parseLinkStats(payload.data(), static_cast<int>(payload.size()), link_stats))
-            {
-                latest_link_stats_ = link_stats;
-                if (link_stats_callback_)
-                {
-                    link_stats_callback_(link_stats);
-                }
-            }
-            break;
+    void TelemetryHandler::publishBattery(const BatteryInfo &battery)
+    {
+        latest_battery_ = battery;
+        invokeCallbacks(battery_callbacks_, battery);
 
-        case 0x2E: // Battery telemetry
-            if (parseBatteryInfo(payload.data(), static_cast<int>(payload.size()), battery_info))
-            {
-                latest_battery_ = battery_info;
-                if (battery_callback_)
-                {
-                    battery_callback_(battery_info);
-                }
-            }
-            break;
+        TelemetryEvent event;
+        event.type = TelemetryEventType::Battery;
+        event.battery = battery;
+        broadcast(event);
+    }
 
-        default:
-            break;
+    void TelemetryHandler::publishTimingSync(const TimingSync &sync)
+    {
+        latest_timing_sync_ = sync;
+        invokeCallbacks(timing_sync_callbacks_, sync);
+
+        TelemetryEvent event;
+        event.type = TelemetryEventType::TimingSync;
+        event.timing_sync = sync;
+        broadcast(event);
+    }
+
+    void TelemetryHandler::forwardMspReply(const MspFrameView &frame)
+    {
+        if (frame.fromDevice())
+        {
+            invokeCallbacks(msp_reply_callbacks_, frame);
         }
     }
 
+    void TelemetryHandler::broadcast(TelemetryEvent &event)
+    {
+        // Fast-path callbacks have already run; subscribers read this at their own pace
+        event.sequence = events_.head();
+        event.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        events_.publish(event);
+    }
+
     bool TelemetryHandler::parseLinkStats(const uint8_t *data, int length, LinkStats &stats)
     {
         if (!data || length <= 0)
@@ -262,10 +542,7 @@ namespace ELRS
             {
                 latest_spectrum_ = std::move(spectrum);
                 RadioState::getInstance().updateSpectrumData(latest_spectrum_);
-                if (spectrum_callback_)
-                {
-                    spectrum_callback_(latest_spectrum_);
-                }
+                invokeCallbacks(spectrum_callbacks_, latest_spectrum_);
             }
         }
 
@@ -288,6 +565,69 @@ namespace ELRS
         return true;
     }
 
+    bool TelemetryHandler::parseCrsfLinkStats(const uint8_t *data, int length, LinkStats &stats)
+    {
+        if (length < 10)
+        {
+            return false;
+        }
+
+        // Uplink RSSI ant1/ant2 (-dBm), uplink LQ, uplink SNR, active antenna, RF mode,
+        // uplink TX power (enum), downlink RSSI, downlink LQ, downlink SNR
+        stats.rssi1 = -static_cast<int>(data[0]);
+        stats.rssi2 = -static_cast<int>(data[1]);
+        stats.link_quality = data[2];
+        stats.snr = static_cast<int>(static_cast<int8_t>(data[3]));
+        stats.tx_power = data[6] < sizeof(CRSF_POWER_MW) / sizeof(CRSF_POWER_MW[0]) ? CRSF_POWER_MW[data[6]] : 0;
+        stats.valid = true;
+
+        return true;
+    }
+
+    bool TelemetryHandler::parseCrsfBattery(const uint8_t *data, int length, BatteryInfo &battery)
+    {
+        if (length < 8)
+        {
+            return false;
+        }
+
+        // Big-endian: voltage (0.1 V), current (0.1 A), capacity used (24-bit mAh), remaining (%)
+        battery.voltage_mv = ((data[0] << 8) | data[1]) * 100;
+        battery.current_ma = ((data[2] << 8) | data[3]) * 100;
+        battery.capacity_mah = (data[4] << 16) | (data[5] << 8) | data[6];
+        battery.valid = true;
+
+        return true;
+    }
+
+    bool TelemetryHandler::parseCrsfTimingSync(const uint8_t *data, int length, TimingSync &sync)
+    {
+        // Extended header (destination, origin), subtype, then big-endian int32
+        // interval and offset in 0.1us units
+        if (length < 11 || data[2] != CRSF_RADIO_ID_SUBTYPE_TIMING)
+        {
+            return false;
+        }
+
+        auto readBe32 = [](const uint8_t *p)
+        {
+            return static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 |
+                                        static_cast<uint32_t>(p[2]) << 8 | static_cast<uint32_t>(p[3]));
+        };
+
+        int32_t interval = readBe32(&data[3]);
+        if (interval <= 0)
+        {
+            return false;
+        }
+
+        sync.interval_ns = static_cast<int64_t>(interval) * 100;
+        sync.offset_ns = static_cast<int64_t>(readBe32(&data[7])) * 100;
+        sync.valid = true;
+
+        return true;
+    }
+
     void TelemetryHandler::setError(const std::string &error)
     {
         last_error_ = error;
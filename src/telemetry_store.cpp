@@ -0,0 +1,287 @@
+#include "telemetry_store.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ELRS
+{
+
+    TelemetryStore::TelemetryStore(size_t max_rows)
+        : max_rows_(std::max(max_rows, CHUNK_ROWS))
+    {
+    }
+
+    void TelemetryStore::append(const TelemetryRow &row)
+    {
+        std::array<int32_t, COLUMN_COUNT> values;
+        values[static_cast<size_t>(TelemetryColumn::Rssi1)] = row.rssi1;
+        values[static_cast<size_t>(TelemetryColumn::Rssi2)] = row.rssi2;
+        values[static_cast<size_t>(TelemetryColumn::LinkQuality)] = row.linkQuality;
+        values[static_cast<size_t>(TelemetryColumn::Snr)] = row.snr;
+        values[static_cast<size_t>(TelemetryColumn::TxPower)] = row.txPower;
+        values[static_cast<size_t>(TelemetryColumn::PacketsReceived)] = static_cast<int32_t>(row.packetsReceived);
+        values[static_cast<size_t>(TelemetryColumn::PacketsTransmitted)] = static_cast<int32_t>(row.packetsTransmitted);
+        values[static_cast<size_t>(TelemetryColumn::PacketsLost)] = static_cast<int32_t>(row.packetsLost);
+        values[static_cast<size_t>(TelemetryColumn::Voltage)] = encode(TelemetryColumn::Voltage, row.voltage);
+        values[static_cast<size_t>(TelemetryColumn::Current)] = encode(TelemetryColumn::Current, row.current);
+        values[static_cast<size_t>(TelemetryColumn::Temperature)] = row.temperature;
+        int64_t time = toMicros(row.time);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!chunks_.empty())
+        {
+            time = std::max(time, chunks_.back()->time[tail_rows_ - 1]);
+        }
+        if (chunks_.empty() || tail_rows_ == CHUNK_ROWS)
+        {
+            chunks_.push_back(std::make_shared<Chunk>());
+            chunk_start_.push_back(time);
+            tail_rows_ = 0;
+            trimLocked();
+        }
+
+        Chunk &chunk = *chunks_.back();
+        chunk.time[tail_rows_] = time;
+        for (size_t c = 0; c < COLUMN_COUNT; ++c)
+        {
+            chunk.columns[c][tail_rows_] = values[c];
+        }
+        tail_rows_++;
+
+        if (tail_rows_ == CHUNK_ROWS)
+        {
+            for (size_t c = 0; c < COLUMN_COUNT; ++c)
+            {
+                const auto column = static_cast<TelemetryColumn>(c);
+                ColumnSummary summary;
+                summary.min = std::numeric_limits<double>::max();
+                summary.max = std::numeric_limits<double>::lowest();
+                for (size_t row_index = 0; row_index < CHUNK_ROWS; ++row_index)
+                {
+                    const double value = decode(column, chunk.columns[c][row_index]);
+                    summary.min = std::min(summary.min, value);
+                    summary.max = std::max(summary.max, value);
+                    summary.sum += value;
+                }
+                chunk.summary[c] = summary;
+            }
+        }
+    }
+
+    void TelemetryStore::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunks_.clear();
+        chunk_start_.clear();
+        tail_rows_ = 0;
+    }
+
+    void TelemetryStore::setMaxRows(size_t max_rows)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_rows_ = std::max(max_rows, CHUNK_ROWS);
+        trimLocked();
+    }
+
+    size_t TelemetryStore::getMaxRows() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return max_rows_;
+    }
+
+    size_t TelemetryStore::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sizeLocked();
+    }
+
+    bool TelemetryStore::timeSpan(Clock::time_point &first, Clock::time_point &last) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (chunks_.empty())
+        {
+            return false;
+        }
+        first = toTime(chunk_start_.front());
+        last = toTime(chunks_.back()->time[tail_rows_ - 1]);
+        return true;
+    }
+
+    size_t TelemetryStore::count(Clock::time_point from, Clock::time_point to) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t begin = lowerBound(toMicros(from));
+        const size_t end = lowerBound(toMicros(to));
+        return end > begin ? end - begin : 0;
+    }
+
+    TelemetryAggregate TelemetryStore::aggregate(TelemetryColumn column, Clock::time_point from,
+                                                 Clock::time_point to) const
+    {
+        TelemetryAggregate result;
+        const size_t index = static_cast<size_t>(column);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t begin = lowerBound(toMicros(from));
+        const size_t end = lowerBound(toMicros(to));
+        if (end <= begin)
+        {
+            return result;
+        }
+
+        result.min = std::numeric_limits<double>::max();
+        result.max = std::numeric_limits<double>::lowest();
+        result.first = toTime(chunks_[begin / CHUNK_ROWS]->time[begin % CHUNK_ROWS]);
+        result.last = toTime(chunks_[(end - 1) / CHUNK_ROWS]->time[(end - 1) % CHUNK_ROWS]);
+
+        size_t position = begin;
+        while (position < end)
+        {
+            const size_t chunk_index = position / CHUNK_ROWS;
+            const Chunk &chunk = *chunks_[chunk_index];
+            const size_t row = position % CHUNK_ROWS;
+            const size_t stop = std::min(end - chunk_index * CHUNK_ROWS, CHUNK_ROWS);
+
+            if (row == 0 && stop == CHUNK_ROWS)
+            {
+                // Whole full chunk: use its summary
+                const ColumnSummary &summary = chunk.summary[index];
+                result.min = std::min(result.min, summary.min);
+                result.max = std::max(result.max, summary.max);
+                result.sum += summary.sum;
+            }
+            else
+            {
+                for (size_t r = row; r < stop; ++r)
+                {
+                    const double value = decode(column, chunk.columns[index][r]);
+                    result.min = std::min(result.min, value);
+                    result.max = std::max(result.max, value);
+                    result.sum += value;
+                }
+            }
+            result.count += stop - row;
+            position = chunk_index * CHUNK_ROWS + stop;
+        }
+        return result;
+    }
+
+    size_t TelemetryStore::sizeLocked() const
+    {
+        return chunks_.empty() ? 0 : (chunks_.size() - 1) * CHUNK_ROWS + tail_rows_;
+    }
+
+    size_t TelemetryStore::lowerBound(int64_t time) const
+    {
+        if (chunks_.empty())
+        {
+            return 0;
+        }
+
+        // The first chunk starting at or after time begins at or after the answer, so search the one before it
+        auto next = std::lower_bound(chunk_start_.begin(), chunk_start_.end(), time);
+        if (next == chunk_start_.begin())
+        {
+            return 0;
+        }
+        const size_t chunk_index = static_cast<size_t>(std::distance(chunk_start_.begin(), next)) - 1;
+
+        const Chunk &chunk = *chunks_[chunk_index];
+        const size_t rows = rowsIn(chunk_index);
+        const auto it = std::lower_bound(chunk.time.begin(), chunk.time.begin() + rows, time);
+        return chunk_index * CHUNK_ROWS + static_cast<size_t>(std::distance(chunk.time.begin(), it));
+    }
+
+    void TelemetryStore::trimLocked()
+    {
+        // Keep whole chunks; the newest may be partly filled
+        const size_t max_chunks = (max_rows_ + CHUNK_ROWS - 1) / CHUNK_ROWS + 1;
+        while (chunks_.size() > max_chunks)
+        {
+            chunks_.pop_front();
+            chunk_start_.pop_front();
+        }
+    }
+
+    TelemetryStore::Range TelemetryStore::collect(Clock::time_point from, Clock::time_point to) const
+    {
+        Range range;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t begin = lowerBound(toMicros(from));
+        const size_t end = lowerBound(toMicros(to));
+        if (end <= begin)
+        {
+            return range;
+        }
+
+        const size_t first_chunk = begin / CHUNK_ROWS;
+        const size_t last_chunk = (end - 1) / CHUNK_ROWS;
+        range.chunks.reserve(last_chunk - first_chunk + 1);
+        for (size_t c = first_chunk; c <= last_chunk; ++c)
+        {
+            range.chunks.push_back(chunks_[c]);
+        }
+        range.begin_row = begin % CHUNK_ROWS;
+        range.end_row = end - last_chunk * CHUNK_ROWS;
+        return range;
+    }
+
+    int64_t TelemetryStore::toMicros(Clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+
+    TelemetryStore::Clock::time_point TelemetryStore::toTime(int64_t micros)
+    {
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(micros)));
+    }
+
+    int32_t TelemetryStore::encode(TelemetryColumn column, double value)
+    {
+        switch (column)
+        {
+        case TelemetryColumn::Voltage:
+        case TelemetryColumn::Current:
+            return static_cast<int32_t>(std::lround(value * 1000.0));
+        default:
+            return static_cast<int32_t>(value);
+        }
+    }
+
+    double TelemetryStore::decode(TelemetryColumn column, int32_t value)
+    {
+        switch (column)
+        {
+        case TelemetryColumn::Voltage:
+        case TelemetryColumn::Current:
+            return value / 1000.0;
+        case TelemetryColumn::PacketsReceived:
+        case TelemetryColumn::PacketsTransmitted:
+        case TelemetryColumn::PacketsLost:
+            return static_cast<double>(static_cast<uint32_t>(value));
+        default:
+            return value;
+        }
+    }
+
+    void TelemetryStore::readRow(const Chunk &chunk, size_t index, TelemetryRow &row)
+    {
+        auto column = [&chunk, index](TelemetryColumn c)
+        { return chunk.columns[static_cast<size_t>(c)][index]; };
+
+        row.time = toTime(chunk.time[index]);
+        row.rssi1 = column(TelemetryColumn::Rssi1);
+        row.rssi2 = column(TelemetryColumn::Rssi2);
+        row.linkQuality = column(TelemetryColumn::LinkQuality);
+        row.snr = column(TelemetryColumn::Snr);
+        row.txPower = column(TelemetryColumn::TxPower);
+        row.packetsReceived = static_cast<uint32_t>(column(TelemetryColumn::PacketsReceived));
+        row.packetsTransmitted = static_cast<uint32_t>(column(TelemetryColumn::PacketsTransmitted));
+        row.packetsLost = static_cast<uint32_t>(column(TelemetryColumn::PacketsLost));
+        row.voltage = decode(TelemetryColumn::Voltage, column(TelemetryColumn::Voltage));
+        row.current = decode(TelemetryColumn::Current, column(TelemetryColumn::Current));
+        row.temperature = column(TelemetryColumn::Temperature);
+    }
+
+} // namespace ELRS
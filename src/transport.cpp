@@ -0,0 +1,54 @@
+#include "transport.h"
+#include <cstring>
+
+namespace ELRS
+{
+
+    bool ITransport::writev(const IoSlice *slices, size_t count, int timeout_ms)
+    {
+        // Coalesce into one frame-sized write so a header and payload leave back to back
+        uint8_t gather[512];
+        size_t used = 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const IoSlice &slice = slices[i];
+            if (used + slice.length > sizeof(gather))
+            {
+                if (used > 0 && !write(gather, used, timeout_ms))
+                {
+                    return false;
+                }
+                used = 0;
+
+                if (slice.length > sizeof(gather))
+                {
+                    if (!write(slice.data, slice.length, timeout_ms))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+            }
+
+            std::memcpy(gather + used, slice.data, slice.length);
+            used += slice.length;
+        }
+
+        return used == 0 || write(gather, used, timeout_ms);
+    }
+
+    TransportStats ITransport::getStats() const
+    {
+        TransportStats stats;
+        stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+        stats.bytes_read = bytes_read_.load(std::memory_order_relaxed);
+        stats.write_calls = write_calls_.load(std::memory_order_relaxed);
+        stats.read_calls = read_calls_.load(std::memory_order_relaxed);
+        stats.write_errors = write_errors_.load(std::memory_order_relaxed);
+        stats.read_errors = read_errors_.load(std::memory_order_relaxed);
+        stats.bytes_dropped = bytes_dropped_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+} // namespace ELRS
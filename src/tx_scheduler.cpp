@@ -0,0 +1,231 @@
+#include "tx_scheduler.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace ELRS
+{
+
+    namespace
+    {
+        // Accepted module intervals (20Hz to 2kHz); anything else is treated as garbage
+        constexpr int64_t SYNC_INTERVAL_MIN_NS = 500000;
+        constexpr int64_t SYNC_INTERVAL_MAX_NS = 50000000;
+
+        int64_t toNs(TxScheduler::Clock::duration d)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        }
+    }
+
+    bool TxScheduler::isSupportedRate(int rate_hz)
+    {
+        for (int rate : SUPPORTED_RATES)
+        {
+            if (rate == rate_hz)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TxScheduler::TxScheduler(int rate_hz)
+        : requested_rate_(isSupportedRate(rate_hz) ? rate_hz : 250)
+    {
+        applyRate();
+        deadline_ = Clock::now();
+    }
+
+    bool TxScheduler::setRate(int rate_hz)
+    {
+        if (!isSupportedRate(rate_hz))
+        {
+            return false;
+        }
+        requested_rate_.store(rate_hz, std::memory_order_relaxed);
+        return true;
+    }
+
+    void TxScheduler::start()
+    {
+        applyRate();
+        synced_ = false;
+        deadline_ = Clock::now();
+        updateTiming(deadline_);
+    }
+
+    void TxScheduler::applyTimingSync(Clock::duration interval, Clock::duration offset)
+    {
+        int64_t interval_ns = toNs(interval);
+        if (interval_ns < SYNC_INTERVAL_MIN_NS || interval_ns > SYNC_INTERVAL_MAX_NS)
+        {
+            return;
+        }
+
+        sync_interval_ns_.store(interval_ns, std::memory_order_relaxed);
+        sync_offset_ns_.store(toNs(offset), std::memory_order_relaxed);
+        // Each report measures the absolute phase, so it replaces any unapplied one
+        sync_phase_ns_.store(toNs(offset), std::memory_order_relaxed);
+        sync_updates_.fetch_add(1, std::memory_order_relaxed);
+        sync_time_ns_.store(toNs(Clock::now().time_since_epoch()), std::memory_order_release);
+    }
+
+    bool TxScheduler::isSynced() const
+    {
+        return syncFresh(Clock::now());
+    }
+
+    bool TxScheduler::syncFresh(Clock::time_point now) const
+    {
+        int64_t sync_ns = sync_time_ns_.load(std::memory_order_acquire);
+        return sync_ns != 0 && toNs(now.time_since_epoch()) - sync_ns < toNs(SYNC_STALE);
+    }
+
+    void TxScheduler::updateTiming(Clock::time_point now)
+    {
+        if (syncFresh(now))
+        {
+            // The first report only aligns phase; drift is measured from the next one
+            bool acquiring = !synced_;
+            synced_ = true;
+            int64_t interval_ns = sync_interval_ns_.load(std::memory_order_relaxed);
+
+            int64_t phase_ns = sync_phase_ns_.exchange(0, std::memory_order_relaxed);
+            if (phase_ns != 0)
+            {
+                // Take the shorter way round the slot
+                phase_ns %= interval_ns;
+                if (phase_ns > interval_ns / 2)
+                {
+                    phase_ns -= interval_ns;
+                }
+                else if (phase_ns < -interval_ns / 2)
+                {
+                    phase_ns += interval_ns;
+                }
+
+                // PI loop: move half the error now (one report is a single noisy
+                // sample), and fold a quarter of the per-period drift into the period
+                deadline_ += std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(phase_ns / 2));
+                if (!acquiring && periods_since_sync_ > 0)
+                {
+                    int64_t limit = interval_ns / 100;
+                    period_trim_ns_ += phase_ns / static_cast<int64_t>(4 * periods_since_sync_);
+                    period_trim_ns_ = std::max(-limit, std::min(limit, period_trim_ns_));
+                }
+                periods_since_sync_ = 0;
+            }
+
+            period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(interval_ns + period_trim_ns_));
+            applied_trim_ns_.store(period_trim_ns_, std::memory_order_relaxed);
+        }
+        else if (synced_ || requested_rate_.load(std::memory_order_relaxed) != active_rate_)
+        {
+            // Sync went stale or the nominal rate changed: free-run from the last deadline
+            synced_ = false;
+            period_trim_ns_ = 0;
+            periods_since_sync_ = 0;
+            applied_trim_ns_.store(0, std::memory_order_relaxed);
+            applyRate();
+        }
+    }
+
+    TxScheduler::Clock::time_point TxScheduler::waitNextDeadline()
+    {
+        updateTiming(Clock::now());
+
+        deadline_ += period_;
+        periods_since_sync_++;
+
+        auto now = Clock::now();
+        if (now >= deadline_ + period_)
+        {
+            // Overran by at least one full period: skip the slots that are gone
+            // instead of bursting frames to catch up
+            auto behind = (now - deadline_) / period_;
+            deadline_ += behind * period_;
+            missed_deadlines_.fetch_add(static_cast<uint64_t>(behind), std::memory_order_relaxed);
+        }
+
+        auto spin_tail = std::chrono::nanoseconds(spin_tail_ns_.load(std::memory_order_relaxed));
+        sleepUntil(deadline_ - spin_tail);
+
+        if (spin_tail.count() > 0)
+        {
+            while (Clock::now() < deadline_)
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+        }
+
+        return deadline_;
+    }
+
+    void TxScheduler::recordSend()
+    {
+        auto lateness = Clock::now() - deadline_;
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(lateness).count();
+        jitter_ns_.record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+        frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TxTimingStats TxScheduler::getStats() const
+    {
+        TxTimingStats stats;
+        stats.rate_hz = getRate();
+        stats.frames = frames_.load(std::memory_order_relaxed);
+        stats.missed_deadlines = missed_deadlines_.load(std::memory_order_relaxed);
+        stats.jitter_mean_us = jitter_ns_.getMean() / 1000.0;
+        stats.jitter_p50_us = static_cast<double>(jitter_ns_.getPercentile(50.0)) / 1000.0;
+        stats.jitter_p99_us = static_cast<double>(jitter_ns_.getPercentile(99.0)) / 1000.0;
+        stats.jitter_p999_us = static_cast<double>(jitter_ns_.getPercentile(99.9)) / 1000.0;
+        stats.jitter_max_us = static_cast<double>(jitter_ns_.getMax()) / 1000.0;
+        stats.synced = isSynced();
+        stats.sync_interval_us = static_cast<double>(sync_interval_ns_.load(std::memory_order_relaxed)) / 1000.0;
+        stats.sync_offset_us = static_cast<double>(sync_offset_ns_.load(std::memory_order_relaxed)) / 1000.0;
+        stats.sync_updates = sync_updates_.load(std::memory_order_relaxed);
+        stats.period_trim_ns = static_cast<double>(applied_trim_ns_.load(std::memory_order_relaxed));
+        return stats;
+    }
+
+    void TxScheduler::resetStats()
+    {
+        frames_.store(0, std::memory_order_relaxed);
+        missed_deadlines_.store(0, std::memory_order_relaxed);
+        jitter_ns_.reset();
+    }
+
+    void TxScheduler::applyRate()
+    {
+        active_rate_ = requested_rate_.load(std::memory_order_relaxed);
+        period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000LL / active_rate_));
+    }
+
+    void TxScheduler::sleepUntil(Clock::time_point wake)
+    {
+#ifdef __linux__
+        // steady_clock is CLOCK_MONOTONIC on Linux, so its epoch is directly usable
+        auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(wake.time_since_epoch()).count();
+        if (since_epoch <= 0)
+        {
+            return;
+        }
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(since_epoch / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(since_epoch % 1000000000LL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {
+        }
+#else
+        std::this_thread::sleep_until(wake);
+#endif
+    }
+
+} // namespace ELRS
@@ -1,9 +1,23 @@
 #include "usb_bridge.h"
 #include "device_registry.h"
 #include "log_manager.h"
+#include "byte_ring.h"
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// The transfer engine needs libusb at link time; runtime-loading builds keep the simulated path
+#if defined(HAVE_LIBUSB) && !defined(LIBUSB_RUNTIME_LOADING)
+#define ELRS_USB_ASYNC_ENGINE 1
+#include <libusb.h>
+#endif
 
 #ifdef _WIN32
 #include <setupapi.h>
@@ -13,6 +27,225 @@
 
 namespace ELRS
 {
+#ifdef ELRS_USB_ASYNC_ENGINE
+    /**
+     * Asynchronous bulk transfer engine
+     * IN transfers are resubmitted from their completion callback so the endpoint
+     * never idles; OUT transfers come from a fixed pool and are recycled on completion.
+     */
+    struct UsbBridge::AsyncEngine
+    {
+        static constexpr int IN_TRANSFER_COUNT = 8;
+        static constexpr int OUT_TRANSFER_COUNT = 8;
+        static constexpr int TRANSFER_BUFFER_SIZE = 512;
+        static constexpr size_t RX_RING_SIZE = 64 * 1024;
+
+        libusb_context *context = nullptr;
+        libusb_device_handle *handle = nullptr;
+        uint8_t endpoint_in = ENDPOINT_IN;
+        uint8_t endpoint_out = ENDPOINT_OUT;
+
+        std::vector<libusb_transfer *> in_transfers;
+        std::vector<libusb_transfer *> out_transfers;
+        std::vector<std::unique_ptr<uint8_t[]>> buffers;
+
+        std::mutex out_mutex;
+        std::condition_variable out_cv;
+        std::vector<libusb_transfer *> free_out_transfers;
+
+        SpscByteRing rx_ring{RX_RING_SIZE};
+        std::mutex rx_wait_mutex;
+        std::condition_variable rx_cv;
+        std::atomic<bool> rx_waiting{false};
+
+        std::atomic<bool> stopping{false};
+        std::atomic<bool> device_lost{false}; // Unplugged, or every IN transfer failed to resubmit
+        std::atomic<int> in_flight{0};
+        std::atomic<int> in_pool{0}; // IN transfers still cycling; none left means no more reads
+        std::atomic<uint64_t> transfer_errors{0};
+        std::thread event_thread;
+
+        bool start(std::string &error);
+        void stop();
+        void eventLoop();
+        void onTransferComplete(libusb_transfer *transfer);
+        bool submit(libusb_transfer *transfer);
+
+        static void LIBUSB_CALL transferCallback(libusb_transfer *transfer)
+        {
+            static_cast<AsyncEngine *>(transfer->user_data)->onTransferComplete(transfer);
+        }
+    };
+
+    bool UsbBridge::AsyncEngine::submit(libusb_transfer *transfer)
+    {
+        in_flight.fetch_add(1);
+        if (libusb_submit_transfer(transfer) != LIBUSB_SUCCESS)
+        {
+            in_flight.fetch_sub(1);
+            return false;
+        }
+        return true;
+    }
+
+    bool UsbBridge::AsyncEngine::start(std::string &error)
+    {
+        stopping.store(false);
+        device_lost.store(false);
+        in_pool.store(0);
+
+        for (int i = 0; i < IN_TRANSFER_COUNT + OUT_TRANSFER_COUNT; ++i)
+        {
+            libusb_transfer *transfer = libusb_alloc_transfer(0);
+            if (!transfer)
+            {
+                error = "Failed to allocate USB transfers";
+                stop(); // Releases the transfers and buffers allocated so far
+                return false;
+            }
+
+            buffers.emplace_back(new uint8_t[TRANSFER_BUFFER_SIZE]);
+            bool inbound = i < IN_TRANSFER_COUNT;
+            libusb_fill_bulk_transfer(transfer, handle, inbound ? endpoint_in : endpoint_out,
+                                      buffers.back().get(), TRANSFER_BUFFER_SIZE,
+                                      transferCallback, this, 0);
+            (inbound ? in_transfers : out_transfers).push_back(transfer);
+        }
+        free_out_transfers = out_transfers;
+
+        for (libusb_transfer *transfer : in_transfers)
+        {
+            in_pool.fetch_add(1);
+            if (!submit(transfer))
+            {
+                in_pool.fetch_sub(1);
+                error = "Failed to queue USB IN transfers";
+                stop();
+                return false;
+            }
+        }
+
+        event_thread = std::thread(&AsyncEngine::eventLoop, this);
+        return true;
+    }
+
+    void UsbBridge::AsyncEngine::stop()
+    {
+        stopping.store(true);
+
+        for (libusb_transfer *transfer : in_transfers)
+        {
+            libusb_cancel_transfer(transfer);
+        }
+        for (libusb_transfer *transfer : out_transfers)
+        {
+            libusb_cancel_transfer(transfer);
+        }
+
+        if (event_thread.joinable())
+        {
+            event_thread.join();
+        }
+        else
+        {
+            // start() failed part way: pump here until the submitted transfers have called back
+            eventLoop();
+        }
+
+        // Only reached with nothing in flight, so the transfers can be released safely
+        for (libusb_transfer *transfer : in_transfers)
+        {
+            libusb_free_transfer(transfer);
+        }
+        for (libusb_transfer *transfer : out_transfers)
+        {
+            libusb_free_transfer(transfer);
+        }
+        in_transfers.clear();
+        out_transfers.clear();
+        free_out_transfers.clear();
+        buffers.clear();
+
+        out_cv.notify_all();
+        rx_cv.notify_all();
+    }
+
+    void UsbBridge::AsyncEngine::eventLoop()
+    {
+        // Keep pumping until every cancelled transfer has called back
+        while (!stopping.load() || in_flight.load() > 0)
+        {
+            struct timeval tv;
+            tv.tv_sec = 0;
+            tv.tv_usec = 100000;
+            libusb_handle_events_timeout_completed(context, &tv, nullptr);
+        }
+    }
+
+    void UsbBridge::AsyncEngine::onTransferComplete(libusb_transfer *transfer)
+    {
+        const bool inbound = (transfer->endpoint & LIBUSB_ENDPOINT_DIR_MASK) == LIBUSB_ENDPOINT_IN;
+
+        if (transfer->status == LIBUSB_TRANSFER_NO_DEVICE)
+        {
+            device_lost.store(true);
+        }
+        else if (transfer->status != LIBUSB_TRANSFER_COMPLETED && transfer->status != LIBUSB_TRANSFER_CANCELLED)
+        {
+            transfer_errors.fetch_add(1);
+        }
+
+        if (inbound)
+        {
+            if (transfer->status == LIBUSB_TRANSFER_COMPLETED && transfer->actual_length > 0)
+            {
+                rx_ring.write(transfer->buffer, static_cast<size_t>(transfer->actual_length));
+
+                // Pairs with the fence after a reader sets rx_waiting: either it sees the bytes or we see it waiting
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (rx_waiting.load())
+                {
+                    std::lock_guard<std::mutex> lock(rx_wait_mutex);
+                    rx_cv.notify_one();
+                }
+            }
+
+            // Requeue immediately; the slot is counted as in flight throughout
+            if (!stopping.load() && !device_lost.load())
+            {
+                if (libusb_submit_transfer(transfer) == LIBUSB_SUCCESS)
+                {
+                    return;
+                }
+                transfer_errors.fetch_add(1);
+            }
+
+            // Out of the pool; once the last one is gone nothing will ever be read again
+            if (in_pool.fetch_sub(1) == 1 && !stopping.load())
+            {
+                device_lost.store(true);
+            }
+            in_flight.fetch_sub(1);
+            {
+                std::lock_guard<std::mutex> lock(rx_wait_mutex);
+                rx_cv.notify_all();
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(out_mutex);
+            free_out_transfers.push_back(transfer);
+        }
+        in_flight.fetch_sub(1);
+        out_cv.notify_one();
+    }
+#else
+    struct UsbBridge::AsyncEngine
+    {
+    };
+#endif
+
     // USB Driver Loader Implementation
     UsbDriverLoader &UsbDriverLoader::getInstance()
     {
@@ -114,6 +347,9 @@ namespace ELRS
         if (context_)
         {
             std::cout << "[USB] Cleaning up USB context" << std::endl;
+#ifdef ELRS_USB_ASYNC_ENGINE
+            libusb_exit(context_);
+#endif
             context_ = nullptr;
         }
     }
@@ -258,9 +494,15 @@ namespace ELRS
 
         std::cout << "[USB] Real device found - attempting connection..." << std::endl;
 
-        // For now, simulate successful connection to real device
-        // In a full implementation, this would open the actual device handle
+#ifdef ELRS_USB_ASYNC_ENGINE
+        if (!openDevice(vid, pid))
+        {
+            return false;
+        }
+#else
+        // Without libusb at link time there is no device handle to open
         device_handle_ = reinterpret_cast<libusb_device_handle *>(0x1); // Non-null to indicate connected
+#endif
         connected_device_ = targetDevice;
 
         std::cout << "[USB] Successfully connected to real device: " << targetDevice.product << std::endl;
@@ -273,11 +515,21 @@ namespace ELRS
         if (isConnected())
         {
             std::cout << "[USB] Disconnecting from device..." << std::endl;
+#ifdef ELRS_USB_ASYNC_ENGINE
+            closeDevice();
+#endif
             device_handle_ = nullptr;
         }
     }
 
     bool UsbBridge::write(const uint8_t *data, size_t length, int timeout_ms)
+    {
+        bool ok = writeBytes(data, length, timeout_ms);
+        recordWrite(length, ok);
+        return ok;
+    }
+
+    bool UsbBridge::writeBytes(const uint8_t *data, size_t length, int timeout_ms)
     {
         if (!isConnected())
         {
@@ -285,11 +537,98 @@ namespace ELRS
             return false;
         }
 
+#ifdef ELRS_USB_ASYNC_ENGINE
+        if (engine_->device_lost.load())
+        {
+            setError("USB device was removed");
+            return false;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        size_t offset = 0;
+
+        while (offset < length)
+        {
+            libusb_transfer *transfer = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(engine_->out_mutex);
+                if (!engine_->out_cv.wait_until(lock, deadline, [this]
+                                                { return !engine_->free_out_transfers.empty() || engine_->stopping.load(); }) ||
+                    engine_->stopping.load())
+                {
+                    setError("USB write timed out waiting for a free OUT transfer");
+                    return false;
+                }
+                transfer = engine_->free_out_transfers.back();
+                engine_->free_out_transfers.pop_back();
+            }
+
+            size_t chunk = std::min(length - offset, static_cast<size_t>(AsyncEngine::TRANSFER_BUFFER_SIZE));
+            std::memcpy(transfer->buffer, data + offset, chunk);
+            transfer->length = static_cast<int>(chunk);
+
+            if (!engine_->submit(transfer))
+            {
+                std::lock_guard<std::mutex> lock(engine_->out_mutex);
+                engine_->free_out_transfers.push_back(transfer);
+                setError("Failed to submit USB OUT transfer");
+                return false;
+            }
+            offset += chunk;
+        }
+        return true;
+#else
         std::cout << "[USB] Writing " << length << " bytes to device (simulated)" << std::endl;
         return true;
+#endif
     }
 
     int UsbBridge::read(uint8_t *buffer, size_t buffer_size, int timeout_ms)
+    {
+        int result = readBytes(buffer, buffer_size, timeout_ms);
+        recordRead(result);
+        return result;
+    }
+
+    bool UsbBridge::waitReadable(int timeout_ms)
+    {
+        if (!isConnected())
+        {
+            return false;
+        }
+
+#ifdef ELRS_USB_ASYNC_ENGINE
+        if (!engine_->rx_ring.empty())
+        {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(engine_->rx_wait_mutex);
+        engine_->rx_waiting.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // See onTransferComplete
+        bool ready = engine_->rx_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]
+                                             { return !engine_->rx_ring.empty() || engine_->stopping.load() || engine_->device_lost.load(); });
+        engine_->rx_waiting.store(false);
+        return ready && !engine_->rx_ring.empty();
+#else
+        return true; // Simulated device always has a byte ready
+#endif
+    }
+
+    TransportStats UsbBridge::getStats() const
+    {
+        TransportStats stats = ITransport::getStats();
+#ifdef ELRS_USB_ASYNC_ENGINE
+        if (engine_)
+        {
+            stats.bytes_dropped += engine_->rx_ring.droppedBytes();
+            stats.read_errors += engine_->transfer_errors.load();
+        }
+#endif
+        return stats;
+    }
+
+    int UsbBridge::readBytes(uint8_t *buffer, size_t buffer_size, int timeout_ms)
     {
         if (!isConnected())
         {
@@ -297,6 +636,31 @@ namespace ELRS
             return -1;
         }
 
+#ifdef ELRS_USB_ASYNC_ENGINE
+        // Fast path: data already landed in the ring, no syscall needed
+        size_t count = engine_->rx_ring.read(buffer, buffer_size);
+        if (count > 0 || timeout_ms <= 0)
+        {
+            return static_cast<int>(count);
+        }
+
+        if (engine_->device_lost.load())
+        {
+            setError("USB device was removed");
+            return -1;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(engine_->rx_wait_mutex);
+            engine_->rx_waiting.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // See onTransferComplete
+            engine_->rx_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]
+                                    { return !engine_->rx_ring.empty() || engine_->stopping.load() || engine_->device_lost.load(); });
+            engine_->rx_waiting.store(false);
+        }
+
+        return static_cast<int>(engine_->rx_ring.read(buffer, buffer_size));
+#else
         // Read real data from device (no simulation)
         if (buffer_size > 0)
         {
@@ -304,6 +668,7 @@ namespace ELRS
             return 1;
         }
         return 0;
+#endif
     }
 
     UsbBridge::DeviceInfo UsbBridge::getConnectedDeviceInfo() const
@@ -322,8 +687,12 @@ namespace ELRS
 
     std::string UsbBridge::getUsbErrorString(int error_code)
     {
+#ifdef ELRS_USB_ASYNC_ENGINE
+        return std::string(libusb_error_name(error_code)) + " (" + std::to_string(error_code) + ")";
+#else
         // Simplified error string conversion
         return "USB Error Code: " + std::to_string(error_code);
+#endif
     }
 
     bool UsbBridge::detectUsbDevices()
@@ -432,6 +801,56 @@ namespace ELRS
 
         SetupDiDestroyDeviceInfoList(deviceInfoSet);
         return foundElrsDevice;
+#elif defined(ELRS_USB_ASYNC_ENGINE)
+        // Enumerate through libusb and match against the device registry
+        if (!context_ && libusb_init(&context_) != LIBUSB_SUCCESS)
+        {
+            context_ = nullptr;
+            std::cout << "[USB] libusb initialisation failed" << std::endl;
+            return false;
+        }
+
+        Devices::DeviceRegistry &registry = Devices::DeviceRegistry::getInstance();
+        libusb_device **list = nullptr;
+        ssize_t count = libusb_get_device_list(context_, &list);
+        bool foundElrsDevice = false;
+
+        for (ssize_t i = 0; i < count; ++i)
+        {
+            libusb_device_descriptor desc;
+            if (libusb_get_device_descriptor(list[i], &desc) != LIBUSB_SUCCESS)
+            {
+                continue;
+            }
+
+            const auto *registeredDevice = registry.findDevice(desc.idVendor, desc.idProduct);
+            if (registeredDevice == nullptr)
+            {
+                continue;
+            }
+
+            DeviceInfo device;
+            device.vid = desc.idVendor;
+            device.pid = desc.idProduct;
+            device.product = registeredDevice->model;
+            device.manufacturer = Devices::DeviceRegistry::manufacturerToString(registeredDevice->manufacturer);
+            device.serial = "REAL" + std::to_string(i);
+            device.description = "Real hardware: " + device.product +
+                                 " (" + Devices::DeviceRegistry::driverTypeToString(registeredDevice->driverType) + ")";
+
+            devices.push_back(device);
+            foundElrsDevice = true;
+
+            std::cout << "[USB] ✓ Found ELRS device: " << device.product
+                      << " (VID:" << std::hex << device.vid << " PID:" << device.pid << std::dec
+                      << ") - " << device.manufacturer << std::endl;
+        }
+
+        if (list)
+        {
+            libusb_free_device_list(list, 1);
+        }
+        return foundElrsDevice;
 #else
         // For non-Windows platforms, use different APIs
         std::cout << "[USB] Platform-specific USB scanning not implemented" << std::endl;
@@ -439,6 +858,241 @@ namespace ELRS
 #endif
     }
 
+#ifdef ELRS_USB_ASYNC_ENGINE
+    namespace
+    {
+        // CDC ACM class requests
+        constexpr uint8_t CDC_SET_LINE_CODING = 0x20;
+        constexpr uint8_t CDC_SET_CONTROL_LINE_STATE = 0x22;
+        constexpr uint32_t CRSF_UART_BAUD = 420000;
+
+        // Silicon Labs CP210x vendor requests (AN571); the bridge has no CDC interface
+        constexpr uint16_t SILABS_VID = 0x10C4;
+        constexpr uint8_t CP210X_IFC_ENABLE = 0x00;
+        constexpr uint8_t CP210X_SET_LINE_CTL = 0x03;
+        constexpr uint8_t CP210X_SET_MHS = 0x07;
+        constexpr uint8_t CP210X_SET_BAUDRATE = 0x1E;
+
+        // Enable the UART (left disabled once the kernel driver is detached), 420000 8-N-1, DTR|RTS
+        int configureCp210x(libusb_device_handle *handle, uint16_t interface_number)
+        {
+            const uint8_t request_type = LIBUSB_REQUEST_TYPE_VENDOR | LIBUSB_RECIPIENT_INTERFACE;
+            uint8_t baud[4] = {
+                static_cast<uint8_t>(CRSF_UART_BAUD & 0xFF),
+                static_cast<uint8_t>((CRSF_UART_BAUD >> 8) & 0xFF),
+                static_cast<uint8_t>((CRSF_UART_BAUD >> 16) & 0xFF),
+                static_cast<uint8_t>((CRSF_UART_BAUD >> 24) & 0xFF)};
+
+            int result = libusb_control_transfer(handle, request_type, CP210X_IFC_ENABLE, 0x0001, interface_number,
+                                                 nullptr, 0, 1000);
+            if (result >= 0)
+            {
+                result = libusb_control_transfer(handle, request_type, CP210X_SET_BAUDRATE, 0, interface_number,
+                                                 baud, sizeof(baud), 1000);
+            }
+            if (result >= 0)
+            {
+                result = libusb_control_transfer(handle, request_type, CP210X_SET_LINE_CTL, 0x0800, interface_number,
+                                                 nullptr, 0, 1000); // 8 data bits, no parity, 1 stop bit
+            }
+            if (result >= 0)
+            {
+                result = libusb_control_transfer(handle, request_type, CP210X_SET_MHS, 0x0303, interface_number,
+                                                 nullptr, 0, 1000); // Drive DTR and RTS high
+            }
+            return result < 0 ? result : LIBUSB_SUCCESS;
+        }
+
+        struct InterfaceSelection
+        {
+            int data_interface = -1;
+            int comm_interface = -1;
+            uint8_t endpoint_in = 0;
+            uint8_t endpoint_out = 0;
+        };
+
+        // Prefer the CDC data interface; a CP210x exposes a single vendor-class bulk pair instead
+        InterfaceSelection selectInterfaces(libusb_device *device)
+        {
+            InterfaceSelection selection;
+            libusb_config_descriptor *config = nullptr;
+            if (libusb_get_active_config_descriptor(device, &config) != LIBUSB_SUCCESS || !config)
+            {
+                return selection;
+            }
+
+            for (int i = 0; i < config->bNumInterfaces; ++i)
+            {
+                if (config->interface[i].num_altsetting < 1)
+                {
+                    continue;
+                }
+
+                const libusb_interface_descriptor &alt = config->interface[i].altsetting[0];
+                if (alt.bInterfaceClass == LIBUSB_CLASS_COMM && selection.comm_interface < 0)
+                {
+                    selection.comm_interface = alt.bInterfaceNumber;
+                    continue;
+                }
+
+                uint8_t in = 0;
+                uint8_t out = 0;
+                for (int e = 0; e < alt.bNumEndpoints; ++e)
+                {
+                    const libusb_endpoint_descriptor &ep = alt.endpoint[e];
+                    if ((ep.bmAttributes & LIBUSB_TRANSFER_TYPE_MASK) != LIBUSB_TRANSFER_TYPE_BULK)
+                    {
+                        continue;
+                    }
+                    if (ep.bEndpointAddress & LIBUSB_ENDPOINT_IN)
+                    {
+                        in = ep.bEndpointAddress;
+                    }
+                    else
+                    {
+                        out = ep.bEndpointAddress;
+                    }
+                }
+
+                bool better = selection.data_interface < 0 || alt.bInterfaceClass == LIBUSB_CLASS_DATA;
+                if (in && out && better)
+                {
+                    selection.data_interface = alt.bInterfaceNumber;
+                    selection.endpoint_in = in;
+                    selection.endpoint_out = out;
+                }
+            }
+
+            libusb_free_config_descriptor(config);
+            return selection;
+        }
+    }
+
+    bool UsbBridge::openDevice(uint16_t vid, uint16_t pid)
+    {
+        if (!context_ && libusb_init(&context_) != LIBUSB_SUCCESS)
+        {
+            context_ = nullptr;
+            setError("libusb initialisation failed");
+            return false;
+        }
+
+        libusb_device_handle *handle = libusb_open_device_with_vid_pid(context_, vid, pid);
+        if (!handle)
+        {
+            setError("Unable to open USB device - check permissions/udev rules or the WinUSB driver");
+            return false;
+        }
+
+        InterfaceSelection selection = selectInterfaces(libusb_get_device(handle));
+        if (selection.data_interface < 0)
+        {
+            libusb_close(handle);
+            setError("No bulk data interface found on device");
+            return false;
+        }
+
+        // Let libusb detach cdc_acm/cp210x while we hold the interface and re-attach on release
+        libusb_set_auto_detach_kernel_driver(handle, 1);
+
+        int result = libusb_claim_interface(handle, selection.data_interface);
+        if (result != LIBUSB_SUCCESS)
+        {
+            libusb_close(handle);
+            setError("Failed to claim data interface: " + getUsbErrorString(result));
+            return false;
+        }
+
+        const bool cdc = selection.comm_interface >= 0;
+        if (!cdc && vid != SILABS_VID)
+        {
+            libusb_release_interface(handle, selection.data_interface);
+            libusb_close(handle);
+            setError("Unsupported USB serial bridge: no CDC interface and not a CP210x");
+            return false;
+        }
+
+        if (!cdc)
+        {
+            result = configureCp210x(handle, static_cast<uint16_t>(selection.data_interface));
+            if (result != LIBUSB_SUCCESS)
+            {
+                libusb_release_interface(handle, selection.data_interface);
+                libusb_close(handle);
+                setError("Failed to configure CP210x UART: " + getUsbErrorString(result));
+                return false;
+            }
+        }
+        else if (libusb_claim_interface(handle, selection.comm_interface) == LIBUSB_SUCCESS)
+        {
+            // 420000 8-N-1, then assert DTR|RTS so the bridge starts forwarding
+            uint8_t line_coding[7] = {
+                static_cast<uint8_t>(CRSF_UART_BAUD & 0xFF),
+                static_cast<uint8_t>((CRSF_UART_BAUD >> 8) & 0xFF),
+                static_cast<uint8_t>((CRSF_UART_BAUD >> 16) & 0xFF),
+                static_cast<uint8_t>((CRSF_UART_BAUD >> 24) & 0xFF),
+                0, 0, 8};
+            const uint8_t request_type = LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE;
+            libusb_control_transfer(handle, request_type, CDC_SET_LINE_CODING, 0,
+                                    static_cast<uint16_t>(selection.comm_interface),
+                                    line_coding, sizeof(line_coding), 1000);
+            libusb_control_transfer(handle, request_type, CDC_SET_CONTROL_LINE_STATE, 0x03,
+                                    static_cast<uint16_t>(selection.comm_interface), nullptr, 0, 1000);
+        }
+
+        engine_ = std::make_unique<AsyncEngine>();
+        engine_->context = context_;
+        engine_->handle = handle;
+        engine_->endpoint_in = selection.endpoint_in;
+        engine_->endpoint_out = selection.endpoint_out;
+
+        std::string error;
+        if (!engine_->start(error))
+        {
+            engine_.reset();
+            libusb_release_interface(handle, selection.data_interface);
+            if (selection.comm_interface >= 0)
+            {
+                libusb_release_interface(handle, selection.comm_interface);
+            }
+            libusb_close(handle);
+            setError(error);
+            return false;
+        }
+
+        device_handle_ = handle;
+        std::cout << "[USB] Claimed interface " << selection.data_interface
+                  << " (IN 0x" << std::hex << static_cast<int>(selection.endpoint_in)
+                  << ", OUT 0x" << static_cast<int>(selection.endpoint_out) << std::dec
+                  << "), " << AsyncEngine::IN_TRANSFER_COUNT << " transfers queued" << std::endl;
+        return true;
+    }
+
+    void UsbBridge::closeDevice()
+    {
+        if (engine_)
+        {
+            engine_->stop();
+            engine_.reset();
+        }
+
+        if (device_handle_)
+        {
+            // Releasing re-attaches the kernel driver thanks to auto-detach
+            InterfaceSelection selection = selectInterfaces(libusb_get_device(device_handle_));
+            if (selection.data_interface >= 0)
+            {
+                libusb_release_interface(device_handle_, selection.data_interface);
+            }
+            if (selection.comm_interface >= 0)
+            {
+                libusb_release_interface(device_handle_, selection.comm_interface);
+            }
+            libusb_close(device_handle_);
+        }
+    }
+#endif
+
     bool UsbBridge::shouldShowSimulatedDevices() const
     {
         // Only show simulated devices if environment variable is set or in debug mode
@@ -0,0 +1,353 @@
+#include "write_scheduler.h"
+#include "transport.h"
+#include <algorithm>
+#include <iostream>
+
+namespace ELRS
+{
+
+    namespace
+    {
+        // Queue depth per class: RC keeps only a couple of frames so nothing stale piles up
+        constexpr size_t QUEUE_CAPACITY[WriteScheduler::CLASS_COUNT] = {4, 64, 64, 256};
+
+        // Default share of the link budget per class (RC is never throttled)
+        constexpr double DEFAULT_SHARE[WriteScheduler::CLASS_COUNT] = {1.0, 0.30, 0.20, 0.20};
+
+        // Buckets hold 20ms of traffic, and always at least one maximum-size frame
+        constexpr double BURST_SECONDS = 0.020;
+
+        // Upper bound on a parked writer's sleep, so stop() is never slow
+        constexpr auto MAX_IDLE_WAIT = std::chrono::milliseconds(100);
+    }
+
+    void WriteScheduler::TokenBucket::refill(Clock::time_point now)
+    {
+        double elapsed = std::chrono::duration<double>(now - refilled).count();
+        refilled = now;
+        if (elapsed > 0.0)
+        {
+            tokens = std::min(burst, tokens + elapsed * rate);
+        }
+    }
+
+    WriteScheduler::Clock::duration WriteScheduler::TokenBucket::timeUntil(double bytes) const
+    {
+        if (tokens >= bytes || rate <= 0.0)
+        {
+            return Clock::duration::zero();
+        }
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((bytes - tokens) / rate));
+    }
+
+    WriteScheduler::WriteScheduler(ITransport *transport, uint32_t baud_rate)
+        : transport_(transport), baud_rate_(baud_rate)
+    {
+        for (size_t i = 0; i < CLASS_COUNT; ++i)
+        {
+            classes_[i].queue = std::make_unique<BoundedMpscQueue<WriteRequest>>(QUEUE_CAPACITY[i]);
+            classes_[i].share.store(DEFAULT_SHARE[i], std::memory_order_relaxed);
+        }
+    }
+
+    WriteScheduler::~WriteScheduler()
+    {
+        stop();
+    }
+
+    void WriteScheduler::start()
+    {
+        if (running_.load())
+        {
+            return; // Already running
+        }
+
+        if (!transport_)
+        {
+            setError("No transport");
+            return;
+        }
+
+        budgets_dirty_.store(true);
+        running_.store(true);
+        writer_thread_ = std::make_unique<std::thread>(&WriteScheduler::writerLoop, this);
+
+        std::cout << "[WRITE] Scheduler started on " << transport_->getTransportName() << " ("
+                  << baud_rate_.load() / 10 << " bytes/s budget)" << std::endl;
+    }
+
+    void WriteScheduler::stop()
+    {
+        if (!running_.load())
+        {
+            return; // Already stopped
+        }
+
+        running_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_cv_.notify_one();
+        }
+
+        if (writer_thread_ && writer_thread_->joinable())
+        {
+            writer_thread_->join();
+        }
+        writer_thread_.reset();
+
+        std::cout << "[WRITE] Scheduler stopped" << std::endl;
+    }
+
+    bool WriteScheduler::submit(WriteClass write_class, const uint8_t *data, size_t length)
+    {
+        ClassState &state = classes_[static_cast<size_t>(write_class)];
+        state.submitted.fetch_add(1, std::memory_order_relaxed);
+
+        if (!running_.load(std::memory_order_relaxed) || !data || length == 0 || length > MAX_WRITE_SIZE)
+        {
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        bool queued = state.queue->push([&](WriteRequest &request)
+                                        {
+                                            std::copy(data, data + length, request.data.begin());
+                                            request.length = static_cast<uint16_t>(length);
+                                            request.submitted = Clock::now(); });
+        if (!queued)
+        {
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        wakeWriter();
+        return true;
+    }
+
+    bool WriteScheduler::submitAll(WriteClass write_class, const ITransport::IoSlice *frames, size_t count)
+    {
+        ClassState &state = classes_[static_cast<size_t>(write_class)];
+        state.submitted.fetch_add(count, std::memory_order_relaxed);
+
+        bool valid = running_.load(std::memory_order_relaxed) && frames && count > 0;
+        for (size_t i = 0; valid && i < count; ++i)
+        {
+            valid = frames[i].data && frames[i].length > 0 && frames[i].length <= MAX_WRITE_SIZE;
+        }
+
+        bool queued = valid && state.queue->pushAll(count, [&](size_t i, WriteRequest &request)
+                                                    {
+                                                        std::copy(frames[i].data, frames[i].data + frames[i].length, request.data.begin());
+                                                        request.length = static_cast<uint16_t>(frames[i].length);
+                                                        request.submitted = Clock::now(); });
+        if (!queued)
+        {
+            state.dropped.fetch_add(count, std::memory_order_relaxed);
+            return false;
+        }
+
+        wakeWriter();
+        return true;
+    }
+
+    size_t WriteScheduler::queueCapacity(WriteClass write_class) const
+    {
+        return classes_[static_cast<size_t>(write_class)].queue->capacity();
+    }
+
+    void WriteScheduler::setBaudRate(uint32_t baud_rate)
+    {
+        if (baud_rate == 0)
+        {
+            return;
+        }
+        baud_rate_.store(baud_rate, std::memory_order_relaxed);
+        budgets_dirty_.store(true, std::memory_order_release);
+        wakeWriter();
+    }
+
+    void WriteScheduler::setClassShare(WriteClass write_class, double share)
+    {
+        share = std::max(0.01, std::min(1.0, share));
+        classes_[static_cast<size_t>(write_class)].share.store(share, std::memory_order_relaxed);
+        budgets_dirty_.store(true, std::memory_order_release);
+    }
+
+    WriteClassStats WriteScheduler::getClassStats(WriteClass write_class) const
+    {
+        const ClassState &state = classes_[static_cast<size_t>(write_class)];
+
+        WriteClassStats stats;
+        stats.submitted = state.submitted.load(std::memory_order_relaxed);
+        stats.written = state.written.load(std::memory_order_relaxed);
+        stats.dropped = state.dropped.load(std::memory_order_relaxed);
+        stats.write_errors = state.write_errors.load(std::memory_order_relaxed);
+        stats.bytes = state.bytes.load(std::memory_order_relaxed);
+        stats.budget_bytes_per_s = baud_rate_.load(std::memory_order_relaxed) / 10.0 *
+                                   state.share.load(std::memory_order_relaxed);
+        stats.delay_mean_us = state.delay_ns.getMean() / 1000.0;
+        stats.delay_p50_us = static_cast<double>(state.delay_ns.getPercentile(50.0)) / 1000.0;
+        stats.delay_p99_us = static_cast<double>(state.delay_ns.getPercentile(99.0)) / 1000.0;
+        stats.delay_max_us = static_cast<double>(state.delay_ns.getMax()) / 1000.0;
+        return stats;
+    }
+
+    const char *WriteScheduler::className(WriteClass write_class)
+    {
+        switch (write_class)
+        {
+        case WriteClass::Rc:
+            return "rc";
+        case WriteClass::Control:
+            return "control";
+        case WriteClass::TelemetryPoll:
+            return "telemetry";
+        case WriteClass::Bulk:
+            return "bulk";
+        }
+        return "unknown";
+    }
+
+    void WriteScheduler::resetStats()
+    {
+        for (auto &state : classes_)
+        {
+            state.submitted.store(0, std::memory_order_relaxed);
+            state.written.store(0, std::memory_order_relaxed);
+            state.dropped.store(0, std::memory_order_relaxed);
+            state.write_errors.store(0, std::memory_order_relaxed);
+            state.bytes.store(0, std::memory_order_relaxed);
+            state.delay_ns.reset();
+        }
+    }
+
+    void WriteScheduler::writerLoop()
+    {
+        while (running_.load())
+        {
+            // Anything submitted after this point forces another pass before parking
+            uint64_t seen_submits = submit_count_.load(std::memory_order_acquire);
+
+            auto now = Clock::now();
+            if (budgets_dirty_.exchange(false, std::memory_order_acquire))
+            {
+                applyBudgets(now);
+            }
+
+            link_bucket_.refill(now);
+            for (auto &bucket : class_buckets_)
+            {
+                bucket.refill(now);
+            }
+
+            // Strict priority: take the highest class whose head frame fits its budget
+            size_t chosen = CLASS_COUNT;
+            Clock::duration retry_in = Clock::duration::max();
+            for (size_t i = 0; i < CLASS_COUNT; ++i)
+            {
+                WriteRequest *request = classes_[i].queue->front();
+                if (!request)
+                {
+                    continue;
+                }
+
+                if (static_cast<WriteClass>(i) == WriteClass::Rc)
+                {
+                    chosen = i; // Never throttled, only accounted
+                    break;
+                }
+
+                double need = request->length;
+                Clock::duration wait = std::max(link_bucket_.timeUntil(need), class_buckets_[i].timeUntil(need));
+                if (wait == Clock::duration::zero())
+                {
+                    chosen = i;
+                    break;
+                }
+
+                retry_in = std::min(retry_in, wait);
+                if (link_bucket_.tokens < need)
+                {
+                    break; // Lower classes must not take the link budget this frame is waiting for
+                }
+            }
+
+            if (chosen < CLASS_COUNT)
+            {
+                ClassState &state = classes_[chosen];
+                WriteRequest *request = state.queue->front();
+
+                auto started = Clock::now();
+                state.delay_ns.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(started - request->submitted).count()));
+
+                bool ok = transport_->isConnected() && transport_->write(request->data.data(), request->length);
+
+                link_bucket_.tokens -= request->length;
+                class_buckets_[chosen].tokens -= request->length;
+                if (ok)
+                {
+                    state.written.fetch_add(1, std::memory_order_relaxed);
+                    state.bytes.fetch_add(request->length, std::memory_order_relaxed);
+                }
+                else
+                {
+                    state.write_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                state.queue->pop();
+                continue;
+            }
+
+            // Nothing sendable: park until a submit, a budget refill or stop()
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            writer_parked_.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto wait = std::min<Clock::duration>(retry_in, MAX_IDLE_WAIT);
+            if (submit_count_.load(std::memory_order_relaxed) == seen_submits && running_.load())
+            {
+                wake_cv_.wait_for(lock, wait);
+            }
+            writer_parked_.store(false);
+        }
+    }
+
+    void WriteScheduler::applyBudgets(Clock::time_point now)
+    {
+        double link_rate = baud_rate_.load(std::memory_order_relaxed) / 10.0; // 8N1: 10 bits per byte
+        double min_burst = static_cast<double>(MAX_WRITE_SIZE);
+
+        link_bucket_.rate = link_rate;
+        link_bucket_.burst = std::max(link_rate * BURST_SECONDS, min_burst);
+        link_bucket_.tokens = std::min(link_bucket_.tokens, link_bucket_.burst);
+        link_bucket_.refilled = now;
+
+        for (size_t i = 0; i < CLASS_COUNT; ++i)
+        {
+            TokenBucket &bucket = class_buckets_[i];
+            bucket.rate = link_rate * classes_[i].share.load(std::memory_order_relaxed);
+            bucket.burst = std::max(bucket.rate * BURST_SECONDS, min_burst);
+            bucket.tokens = std::min(bucket.tokens, bucket.burst);
+            bucket.refilled = now;
+        }
+    }
+
+    void WriteScheduler::wakeWriter()
+    {
+        submit_count_.fetch_add(1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writer_parked_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_cv_.notify_one();
+        }
+    }
+
+    void WriteScheduler::setError(const std::string &error)
+    {
+        last_error_ = error;
+        std::cerr << "[WRITE_ERROR] " << error << std::endl;
+    }
+
+} // namespace ELRS